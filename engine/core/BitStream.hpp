@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bit-level packing for compact binary streams
+namespace engine::core::io {
+
+    /**
+     * @brief Appends values of 1 to 32 bits, least significant bit first
+     * Bits gather in a 64-bit scratch word and go out four bytes at a time;
+     * finish() flushes the tail to a whole byte.
+     */
+    class BitWriter {
+    public:
+        explicit BitWriter(std::vector<uint8_t>& buffer) : buffer(buffer) {}
+
+        void write(uint32_t value, int bits) {
+            scratch |= static_cast<uint64_t>(value & mask(bits)) << scratchBits;
+            scratchBits += bits;
+            if (scratchBits >= 32) {
+                const size_t end = buffer.size();
+                buffer.resize(end + 4);
+                uint8_t* out = buffer.data() + end;
+                out[0] = static_cast<uint8_t>(scratch);
+                out[1] = static_cast<uint8_t>(scratch >> 8);
+                out[2] = static_cast<uint8_t>(scratch >> 16);
+                out[3] = static_cast<uint8_t>(scratch >> 24);
+                scratch >>= 32;
+                scratchBits -= 32;
+            }
+        }
+
+        void writeBool(bool value) { write(value ? 1u : 0u, 1); }
+
+        void finish() {
+            while (scratchBits > 0) {
+                buffer.push_back(static_cast<uint8_t>(scratch));
+                scratch >>= 8;
+                scratchBits = scratchBits > 8 ? scratchBits - 8 : 0;
+            }
+        }
+
+        size_t getBitsWritten() const { return buffer.size() * 8 + scratchBits; }
+
+        static uint32_t mask(int bits) { return bits >= 32 ? 0xFFFFFFFFu : (1u << bits) - 1u; }
+
+    private:
+        std::vector<uint8_t>& buffer;
+        uint64_t scratch = 0;
+        int scratchBits = 0;
+    };
+
+    /**
+     * @brief Reads what a BitWriter wrote
+     * Reading past the end yields zeros and clears ok(), so callers can
+     * decode a whole record and check once.
+     */
+    class BitReader {
+    public:
+        BitReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+        uint32_t read(int bits) {
+            while (scratchBits < bits) {
+                if (position >= size) {
+                    valid = false;
+                    return 0;
+                }
+                scratch |= static_cast<uint64_t>(data[position++]) << scratchBits;
+                scratchBits += 8;
+            }
+            const uint32_t value = static_cast<uint32_t>(scratch) & BitWriter::mask(bits);
+            scratch >>= bits;
+            scratchBits -= bits;
+            return value;
+        }
+
+        bool readBool() { return read(1) != 0; }
+
+        bool ok() const { return valid; }
+
+    private:
+        const uint8_t* data;
+        size_t size;
+        size_t position = 0;
+        uint64_t scratch = 0;
+        int scratchBits = 0;
+        bool valid = true;
+    };
+
+} // namespace engine::core::io
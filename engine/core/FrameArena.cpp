@@ -0,0 +1,110 @@
+#include "core/FrameArena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+namespace engine::core::memory {
+
+namespace {
+    thread_local FrameArena* currentArena = nullptr;
+
+    size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+FrameArena::FrameArena(size_t initialCapacity)
+    : block(static_cast<unsigned char*>(std::malloc(initialCapacity))),
+      capacity(block ? initialCapacity : 0) {
+}
+
+FrameArena::~FrameArena() {
+    for (void* overflow : overflowBlocks) {
+        ::operator delete(overflow);
+    }
+    std::free(block);
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    // Align the address rather than the offset; malloc only guarantees max_align_t
+    uintptr_t base = reinterpret_cast<uintptr_t>(block);
+    size_t offset = alignUp(base + used, alignment) - base;
+    if (block && offset + bytes <= capacity) {
+        used = offset + bytes;
+        peak = std::max(peak, getUsed());
+        return block + offset;
+    }
+
+    // Out of room: serve this frame from the heap and grow on the next reset
+    void* overflow = ::operator new(bytes + alignment);
+    overflowBlocks.push_back(overflow);
+    overflowBytes += bytes + alignment;
+    peak = std::max(peak, getUsed());
+
+    uintptr_t address = alignUp(reinterpret_cast<uintptr_t>(overflow), alignment);
+    return reinterpret_cast<void*>(address);
+}
+
+void FrameArena::reset() {
+    if (!overflowBlocks.empty()) {
+        size_t required = used + overflowBytes;
+        for (void* overflow : overflowBlocks) {
+            ::operator delete(overflow);
+        }
+        overflowBlocks.clear();
+        overflowBytes = 0;
+
+        size_t grown = std::max(capacity * 2, required + required / 2);
+        unsigned char* replacement = static_cast<unsigned char*>(std::malloc(grown));
+        if (replacement) {
+            std::free(block);
+            block = replacement;
+            capacity = grown;
+        }
+    }
+    used = 0;
+}
+
+FrameArena* FrameArena::current() {
+    return currentArena;
+}
+
+FrameArena::Scope::Scope(FrameArena& arena)
+    : previous(currentArena) {
+    currentArena = &arena;
+}
+
+FrameArena::Scope::~Scope() {
+    currentArena = previous;
+}
+
+FrameArenaSet::FrameArenaSet(size_t count, size_t capacityEach) {
+    arenas.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        arenas.push_back(std::make_unique<FrameArena>(capacityEach));
+    }
+}
+
+void FrameArenaSet::reset() {
+    for (auto& arena : arenas) {
+        arena->reset();
+    }
+}
+
+size_t FrameArenaSet::getUsed() const {
+    size_t total = 0;
+    for (const auto& arena : arenas) {
+        total += arena->getUsed();
+    }
+    return total;
+}
+
+size_t FrameArenaSet::getOverflowCount() const {
+    size_t total = 0;
+    for (const auto& arena : arenas) {
+        total += arena->getOverflowCount();
+    }
+    return total;
+}
+
+} // namespace engine::core::memory
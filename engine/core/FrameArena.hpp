@@ -0,0 +1,134 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Linear per-frame allocation for short-lived simulation data
+namespace engine::core::memory {
+
+    /**
+     * @brief Bump allocator that is reset once per frame
+     * Nothing is freed individually; reset() drops every allocation at once.
+     * When the block runs out the arena falls back to heap overflow blocks
+     * and the next reset grows the block to that frame's total, so a
+     * steady-state frame never reaches the system allocator.
+     */
+    class FrameArena {
+    public:
+        explicit FrameArena(size_t capacity = 256 * 1024);
+        ~FrameArena();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+        template <typename T>
+        T* allocateArray(size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>, "Arena memory is never destroyed");
+            return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+        }
+
+        // Releases everything allocated since the last reset
+        void reset();
+
+        size_t getCapacity() const { return capacity; }
+        size_t getUsed() const { return used + overflowBytes; }
+        size_t getPeak() const { return peak; }
+        size_t getOverflowCount() const { return overflowBlocks.size(); }   // Heap fallbacks this frame
+
+        // Arena picked up by ArenaAllocator on the calling thread; null means the heap
+        static FrameArena* current();
+
+        // Binds an arena to the calling thread for the lifetime of the scope
+        class Scope {
+        public:
+            explicit Scope(FrameArena& arena);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            FrameArena* previous;
+        };
+
+    private:
+        unsigned char* block = nullptr;
+        size_t capacity = 0;
+        size_t used = 0;
+        size_t peak = 0;
+
+        std::vector<void*> overflowBlocks;
+        size_t overflowBytes = 0;
+    };
+
+    /**
+     * @brief One arena per worker thread, all reset at the start of a step
+     * Index 0 belongs to the thread driving the step.
+     */
+    class FrameArenaSet {
+    public:
+        FrameArenaSet(size_t count, size_t capacityEach);
+
+        FrameArena& operator[](size_t index) { return *arenas[index]; }
+        const FrameArena& operator[](size_t index) const { return *arenas[index]; }
+        size_t size() const { return arenas.size(); }
+
+        void reset();
+        size_t getUsed() const;
+        size_t getOverflowCount() const;
+
+    private:
+        std::vector<std::unique_ptr<FrameArena>> arenas;
+    };
+
+    /**
+     * @brief Standard allocator over the thread's current frame arena
+     * Captures FrameArena::current() at construction and falls back to the
+     * heap when no arena is bound, so code using it also works outside a step.
+     * Containers must not outlive the arena's next reset.
+     */
+    template <typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        ArenaAllocator() noexcept : arena(FrameArena::current()) {}
+        explicit ArenaAllocator(FrameArena* arena) noexcept : arena(arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.getArena()) {}
+
+        T* allocate(size_t count) {
+            if (arena) {
+                return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+            }
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+
+        void deallocate(T* pointer, size_t) noexcept {
+            if (!arena) {
+                ::operator delete(pointer);
+            }
+        }
+
+        FrameArena* getArena() const noexcept { return arena; }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.getArena(); }
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.getArena(); }
+
+    private:
+        FrameArena* arena;
+    };
+
+    // Scratch vector for data that dies within the frame
+    template <typename T>
+    using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace engine::core::memory
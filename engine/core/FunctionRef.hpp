@@ -0,0 +1,39 @@
+#pragma once
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Non-owning callable reference for visitor-style APIs
+namespace engine::core {
+
+    template <typename Signature>
+    class FunctionRef;
+
+    /**
+     * @brief Borrowed reference to any callable, without allocation
+     * Unlike std::function it never copies the callable, so it is only valid
+     * while the referenced object lives; take it by value as a parameter and
+     * do not store it.
+     */
+    template <typename R, typename... Args>
+    class FunctionRef<R(Args...)> {
+    public:
+        template <typename F,
+                  typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, FunctionRef> &&
+                                              std::is_invocable_r_v<R, F&, Args...>>>
+        FunctionRef(F&& callable) noexcept
+            : object(const_cast<void*>(static_cast<const void*>(std::addressof(callable)))),
+              invoker([](void* target, Args... args) -> R {
+                  return (*static_cast<std::remove_reference_t<F>*>(target))(std::forward<Args>(args)...);
+              }) {}
+
+        R operator()(Args... args) const {
+            return invoker(object, std::forward<Args>(args)...);
+        }
+
+    private:
+        void* object;
+        R (*invoker)(void*, Args...);
+    };
+
+} // namespace engine::core
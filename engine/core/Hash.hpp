@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Incremental 64-bit hashing of raw values
+namespace engine::core {
+
+    /**
+     * @brief Streaming 64-bit hash over the exact bits of the values fed in
+     * Floats hash by bit pattern, so any difference in state (including the
+     * sign of zero) changes the result. Not for security; meant for fast
+     * divergence checks between runs or machines.
+     */
+    class StateHasher {
+    public:
+        explicit StateHasher(uint64_t seed = 0) : state(seed ^ Prime5) {}
+
+        void add(uint64_t value) {
+            // xxHash64 round, then fold into the running state
+            uint64_t lane = value * Prime2;
+            lane = rotateLeft(lane, 31) * Prime1;
+            state = rotateLeft(state ^ lane, 27) * Prime1 + Prime4;
+        }
+
+        void add(uint32_t value) { add(static_cast<uint64_t>(value)); }
+        void add(bool value) { add(static_cast<uint64_t>(value)); }
+
+        void add(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            add(static_cast<uint64_t>(bits));
+        }
+
+        void add(const float* values, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                add(values[i]);
+            }
+        }
+
+        // Final avalanche so nearby states give unrelated hashes
+        uint64_t get() const {
+            uint64_t h = state;
+            h ^= h >> 33;
+            h *= Prime2;
+            h ^= h >> 29;
+            h *= Prime3;
+            h ^= h >> 32;
+            return h;
+        }
+
+    private:
+        static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+        static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+        static constexpr uint64_t Prime3 = 0x165667B19E3779F9ull;
+        static constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+        static constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+        static uint64_t rotateLeft(uint64_t value, int bits) {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        uint64_t state;
+    };
+
+} // namespace engine::core
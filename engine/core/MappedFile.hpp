@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory-mapped files for binary assets
+namespace engine::core::io {
+
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // Maps the whole file read-only; returns false and logs on failure
+        bool open(const std::string& path);
+        void close();
+
+        bool isOpen() const { return mappedData != nullptr; }
+        const uint8_t* data() const { return static_cast<const uint8_t*>(mappedData); }
+        size_t size() const { return mappedSize; }
+
+    private:
+        void* mappedData = nullptr;
+        size_t mappedSize = 0;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+
+} // namespace engine::core::io
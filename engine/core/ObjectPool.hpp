@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Fixed-address object storage with O(1) create and destroy
+namespace engine::core::memory {
+
+    /**
+     * @brief Chunked free-list pool
+     * Objects never move once created, and freed slots are reused before new
+     * chunks are allocated. The owner must destroy every live object before
+     * the pool goes away; the pool only releases its chunks.
+     */
+    template <typename T, size_t ChunkSize = 256>
+    class ObjectPool {
+    public:
+        ObjectPool() = default;
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        template <typename... Args>
+        T* create(Args&&... args) {
+            if (!freeList) {
+                addChunk();
+            }
+            Slot* slot = freeList;
+            freeList = slot->next;
+            T* object = new (slot->storage) T(std::forward<Args>(args)...);
+            ++liveCount;
+            return object;
+        }
+
+        void destroy(T* object) {
+            if (!object) return;
+            object->~T();
+            Slot* slot = reinterpret_cast<Slot*>(object);
+            slot->next = freeList;
+            freeList = slot;
+            --liveCount;
+        }
+
+        size_t size() const { return liveCount; }
+        size_t capacity() const { return chunks.size() * ChunkSize; }
+
+    private:
+        union Slot {
+            Slot* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        std::vector<std::unique_ptr<Slot[]>> chunks;
+        Slot* freeList = nullptr;
+        size_t liveCount = 0;
+
+        void addChunk() {
+            chunks.push_back(std::make_unique<Slot[]>(ChunkSize));
+            Slot* chunk = chunks.back().get();
+            for (size_t i = 0; i < ChunkSize; ++i) {
+                chunk[i].next = (i + 1 < ChunkSize) ? &chunk[i + 1] : freeList;
+            }
+            freeList = chunk;
+        }
+    };
+
+} // namespace engine::core::memory
@@ -0,0 +1,193 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Vector with inline storage for small, hot, plain-data collections
+namespace engine::core::memory {
+
+    /**
+     * @brief Contiguous container holding up to N elements inline
+     * Copies and moves stay inside the object while size() <= N, so
+     * containers of these never reach the allocator for typical counts.
+     * Past N the elements spill to the heap and behave like std::vector.
+     * Limited to trivially destructible types so elements are never destroyed.
+     */
+    template <typename T, size_t N>
+    class SmallVector {
+        static_assert(std::is_trivially_destructible_v<T>, "SmallVector stores plain data only");
+        static_assert(N > 0, "SmallVector needs inline capacity");
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+
+        SmallVector() = default;
+
+        SmallVector(const SmallVector& other) {
+            assign(other.begin(), other.end());
+        }
+
+        SmallVector(SmallVector&& other) noexcept {
+            takeFrom(other);
+        }
+
+        ~SmallVector() {
+            releaseHeap();
+        }
+
+        SmallVector& operator=(const SmallVector& other) {
+            if (this != &other) {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        SmallVector& operator=(SmallVector&& other) noexcept {
+            if (this != &other) {
+                releaseHeap();
+                takeFrom(other);
+            }
+            return *this;
+        }
+
+        template <typename InputIt>
+        void assign(InputIt first, InputIt last) {
+            const size_t n = static_cast<size_t>(std::distance(first, last));
+            count = 0;
+            reserve(n);
+            std::uninitialized_copy(first, last, data());
+            count = n;
+        }
+
+        // Element access
+        T* data() { return heap ? heap : inlineData(); }
+        const T* data() const { return heap ? heap : inlineData(); }
+
+        T& operator[](size_t index) { return data()[index]; }
+        const T& operator[](size_t index) const { return data()[index]; }
+
+        T& front() { return data()[0]; }
+        const T& front() const { return data()[0]; }
+        T& back() { return data()[count - 1]; }
+        const T& back() const { return data()[count - 1]; }
+
+        iterator begin() { return data(); }
+        iterator end() { return data() + count; }
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + count; }
+
+        // Capacity
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        size_t capacity() const { return heap ? heapCapacity : N; }
+        bool isInline() const { return heap == nullptr; }
+
+        void reserve(size_t n) {
+            if (n > capacity()) {
+                grow(n);
+            }
+        }
+
+        // Moves back inline when the elements fit again
+        void shrink_to_fit() {
+            if (heap && count <= N) {
+                T* spilled = heap;
+                heap = nullptr;
+                std::uninitialized_copy_n(spilled, count, inlineData());
+                ::operator delete(spilled);
+                heapCapacity = 0;
+            }
+        }
+
+        // Modifiers
+        void clear() { count = 0; }
+
+        void push_back(const T& value) {
+            if (count == capacity()) {
+                T copy = value;     // value may live in the buffer being replaced
+                grow(count * 2);
+                new (data() + count++) T(copy);
+                return;
+            }
+            new (data() + count++) T(value);
+        }
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args) {
+            push_back(T(std::forward<Args>(args)...));
+            return back();
+        }
+
+        void pop_back() { --count; }
+
+        void resize(size_t n) {
+            reserve(n);
+            for (size_t i = count; i < n; ++i) {
+                new (data() + i) T();
+            }
+            count = n;
+        }
+
+        iterator erase(const_iterator position) {
+            return erase(position, position + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            T* base = data();
+            const size_t from = static_cast<size_t>(first - base);
+            const size_t to = static_cast<size_t>(last - base);
+            std::move(base + to, base + count, base + from);
+            count -= to - from;
+            return base + from;
+        }
+
+    private:
+        alignas(T) unsigned char storage[N * sizeof(T)];
+        T* heap = nullptr;
+        size_t heapCapacity = 0;
+        size_t count = 0;
+
+        T* inlineData() { return std::launder(reinterpret_cast<T*>(storage)); }
+        const T* inlineData() const { return std::launder(reinterpret_cast<const T*>(storage)); }
+
+        void grow(size_t n) {
+            n = std::max(n, N * 2);
+            T* replacement = static_cast<T*>(::operator new(n * sizeof(T)));
+            std::uninitialized_copy_n(data(), count, replacement);
+            releaseHeap();
+            heap = replacement;
+            heapCapacity = n;
+        }
+
+        void releaseHeap() {
+            if (heap) {
+                ::operator delete(heap);
+                heap = nullptr;
+                heapCapacity = 0;
+            }
+        }
+
+        void takeFrom(SmallVector& other) {
+            count = other.count;
+            if (other.heap) {
+                heap = other.heap;
+                heapCapacity = other.heapCapacity;
+                other.heap = nullptr;
+                other.heapCapacity = 0;
+            } else {
+                std::uninitialized_copy_n(other.inlineData(), count, inlineData());
+            }
+            other.count = 0;
+        }
+    };
+
+} // namespace engine::core::memory
@@ -0,0 +1,84 @@
+#include "core/ThreadPool.hpp"
+#include <algorithm>
+
+namespace engine::core::threading {
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, FunctionRef<void(size_t)> loopTask) {
+    if (count == 0) return;
+
+    // Not worth waking anyone for a single item
+    if (workers.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            loopTask(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &loopTask;
+        taskCount = count;
+        nextIndex.store(0, std::memory_order_relaxed);
+        activeWorkers = workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+
+    runIndices();
+
+    // loopTask lives on this stack frame, so every worker must be out of it
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return activeWorkers == 0; });
+    task = nullptr;
+}
+
+void ThreadPool::workerLoop() {
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        runIndices();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--activeWorkers == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runIndices() {
+    for (;;) {
+        const size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+        if (index >= taskCount) return;
+        (*task)(index);
+    }
+}
+
+} // namespace engine::core::threading
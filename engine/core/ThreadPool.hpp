@@ -0,0 +1,54 @@
+#pragma once
+#include "FunctionRef.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops
+namespace engine::core::threading {
+
+    /**
+     * @brief Persistent workers running one parallel loop at a time
+     * parallelFor hands out indices dynamically, so uneven work items
+     * balance themselves, and the calling thread works alongside the pool
+     * instead of idling. Loops must not be nested or issued concurrently.
+     */
+    class ThreadPool {
+    public:
+        // 0 picks one thread per hardware core, counting the caller
+        explicit ThreadPool(size_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Threads that execute a loop, including the caller
+        size_t getThreadCount() const { return workers.size() + 1; }
+
+        // Runs task(i) for every i in [0, count) and returns when all are done
+        void parallelFor(size_t count, FunctionRef<void(size_t)> task);
+
+    private:
+        std::vector<std::thread> workers;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        uint64_t generation = 0;      // Bumped for every loop; guarded by mutex
+        bool stopping = false;
+
+        // Current loop
+        FunctionRef<void(size_t)>* task = nullptr;
+        size_t taskCount = 0;
+        std::atomic<size_t> nextIndex{0};
+        size_t activeWorkers = 0;     // Guarded by mutex
+
+        void workerLoop();
+        void runIndices();
+    };
+
+} // namespace engine::core::threading
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free hand-off of the latest value from one thread to another
+namespace engine::core::threading {
+
+    /**
+     * @brief Single-producer, single-consumer triple buffer
+     * The writer fills writeBuffer() and publishes it; the reader always sees
+     * the most recent published buffer. Neither side ever waits: the writer
+     * owns one buffer, the reader another, and the third is swapped between
+     * them with a single atomic exchange. Buffers are reused, so containers
+     * inside T keep their capacity from one publish to the next.
+     */
+    template <typename T>
+    class TripleBuffer {
+    public:
+        TripleBuffer() = default;
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+        // Writer side
+        T& writeBuffer() { return buffers[backIndex]; }
+
+        void publish() {
+            const uint8_t previous = middle.exchange(static_cast<uint8_t>(backIndex | FreshBit),
+                                                     std::memory_order_acq_rel);
+            backIndex = previous & IndexMask;
+        }
+
+        // Reader side; returns the newest buffer, or the last one read if
+        // nothing was published since
+        const T& read() {
+            if (middle.load(std::memory_order_relaxed) & FreshBit) {
+                const uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+                frontIndex = previous & IndexMask;
+            }
+            return buffers[frontIndex];
+        }
+
+        bool hasNewData() const { return (middle.load(std::memory_order_relaxed) & FreshBit) != 0; }
+
+    private:
+        static constexpr uint8_t IndexMask = 0x3;
+        static constexpr uint8_t FreshBit = 0x4;
+
+        std::array<T, 3> buffers{};
+
+        // Each index is touched by one side only; keep them off the same cache line
+        alignas(64) uint8_t backIndex = 0;
+        alignas(64) std::atomic<uint8_t> middle{1};
+        alignas(64) uint8_t frontIndex = 2;
+    };
+
+} // namespace engine::core::threading
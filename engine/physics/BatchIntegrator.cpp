@@ -0,0 +1,205 @@
+#include "BatchIntegrator.hpp"
+#include "RigidBody.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_BATCH_INTEGRATOR_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace engine::physics {
+
+void BatchIntegrator::integrate(const std::vector<RigidBody*>& bodies, float dt) {
+    size_t count = bodies.size();
+    size_t batched = 0;
+
+#ifdef ENGINE_BATCH_INTEGRATOR_SSE
+    // Damping factors are per body but only change with dt or damping
+    for (RigidBody* body : bodies) {
+        body->updateDampingFactors(dt);
+    }
+
+    for (; batched + LaneWidth <= count; batched += LaneWidth) {
+        integrateLanes(&bodies[batched], dt);
+    }
+#endif
+
+    // Scalar tail (or everything without SSE)
+    for (size_t i = batched; i < count; ++i) {
+        bodies[i]->integrate(dt);
+    }
+
+    lastBatchCount = batched / LaneWidth;
+    lastScalarCount = count - batched;
+}
+
+#ifdef ENGINE_BATCH_INTEGRATOR_SSE
+
+namespace {
+
+template <typename Getter>
+inline __m128 gather(RigidBody* const* b, Getter get) {
+    return _mm_setr_ps(get(b[0]), get(b[1]), get(b[2]), get(b[3]));
+}
+
+template <typename Setter>
+inline void scatter(RigidBody* const* b, __m128 value, Setter set) {
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, value);
+    set(b[0], lanes[0]);
+    set(b[1], lanes[1]);
+    set(b[2], lanes[2]);
+    set(b[3], lanes[3]);
+}
+
+inline __m128 madd(__m128 a, __m128 b, __m128 c) {
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+
+inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+} // namespace
+
+void BatchIntegrator::integrateLanes(RigidBody* const* b, float dt) {
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+
+    // --- Linear: v += F * m^-1 * dt; v *= damping; p += v * dt ---
+    __m128 invMassDt = _mm_mul_ps(gather(b, [](RigidBody* r) { return r->inverseMass; }), vdt);
+    __m128 linDamp = gather(b, [](RigidBody* r) { return r->linearDampingFactor; });
+
+    for (int axis = 0; axis < 3; ++axis) {
+        __m128 f = gather(b, [axis](RigidBody* r) { return r->force[axis]; });
+        __m128 v = gather(b, [axis](RigidBody* r) { return r->linearVelocity[axis]; });
+        __m128 p = gather(b, [axis](RigidBody* r) { return r->position[axis]; });
+
+        v = _mm_mul_ps(madd(f, invMassDt, v), linDamp);
+        p = madd(v, vdt, p);
+
+        scatter(b, v, [axis](RigidBody* r, float x) { r->linearVelocity[axis] = x; });
+        scatter(b, p, [axis](RigidBody* r, float x) { r->position[axis] = x; });
+    }
+
+    // --- Angular: w += I_world^-1 * T * dt; w *= damping ---
+    __m128 t[3], w[3], iw[3][3];
+    for (int i = 0; i < 3; ++i) {
+        t[i] = gather(b, [i](RigidBody* r) { return r->torque[i]; });
+        w[i] = gather(b, [i](RigidBody* r) { return r->angularVelocity[i]; });
+        for (int j = 0; j < 3; ++j) {
+            // glm matrices are column-major: m[col][row]
+            iw[i][j] = gather(b, [i, j](RigidBody* r) { return r->worldInverseInertiaTensor[j][i]; });
+        }
+    }
+
+    __m128 angDamp = gather(b, [](RigidBody* r) { return r->angularDampingFactor; });
+    for (int i = 0; i < 3; ++i) {
+        __m128 acc = _mm_add_ps(_mm_add_ps(_mm_mul_ps(iw[i][0], t[0]), _mm_mul_ps(iw[i][1], t[1])),
+                                _mm_mul_ps(iw[i][2], t[2]));
+        w[i] = _mm_mul_ps(madd(acc, vdt, w[i]), angDamp);
+        scatter(b, w[i], [i](RigidBody* r, float x) { r->angularVelocity[i] = x; });
+    }
+
+    // --- Orientation: q += 0.5 * (0, w) * q * dt, then normalize ---
+    __m128 qx = gather(b, [](RigidBody* r) { return r->orientation.x; });
+    __m128 qy = gather(b, [](RigidBody* r) { return r->orientation.y; });
+    __m128 qz = gather(b, [](RigidBody* r) { return r->orientation.z; });
+    __m128 qw = gather(b, [](RigidBody* r) { return r->orientation.w; });
+
+    // Same threshold and operation order as RigidBody::integrate: |w| > 0.0001
+    __m128 spinSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w[0], w[0]), _mm_mul_ps(w[1], w[1])),
+                               _mm_mul_ps(w[2], w[2]));
+    __m128 spinning = _mm_cmpgt_ps(spinSq, _mm_set1_ps(0.0001f * 0.0001f));
+
+    __m128 h = _mm_mul_ps(half, vdt);
+    __m128 dqw = _mm_mul_ps(h, _mm_sub_ps(_mm_setzero_ps(),
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(w[0], qx), _mm_mul_ps(w[1], qy)), _mm_mul_ps(w[2], qz))));
+    __m128 dqx = _mm_mul_ps(h, _mm_add_ps(_mm_mul_ps(qw, w[0]),
+        _mm_sub_ps(_mm_mul_ps(w[1], qz), _mm_mul_ps(w[2], qy))));
+    __m128 dqy = _mm_mul_ps(h, _mm_add_ps(_mm_mul_ps(qw, w[1]),
+        _mm_sub_ps(_mm_mul_ps(w[2], qx), _mm_mul_ps(w[0], qz))));
+    __m128 dqz = _mm_mul_ps(h, _mm_add_ps(_mm_mul_ps(qw, w[2]),
+        _mm_sub_ps(_mm_mul_ps(w[0], qy), _mm_mul_ps(w[1], qx))));
+
+    __m128 nx = _mm_add_ps(qx, dqx);
+    __m128 ny = _mm_add_ps(qy, dqy);
+    __m128 nz = _mm_add_ps(qz, dqz);
+    __m128 nw = _mm_add_ps(qw, dqw);
+    __m128 lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)),
+                              _mm_add_ps(_mm_mul_ps(nz, nz), _mm_mul_ps(nw, nw)));
+    __m128 invLen = _mm_div_ps(one, _mm_sqrt_ps(lenSq));
+
+    qx = select(spinning, _mm_mul_ps(nx, invLen), qx);
+    qy = select(spinning, _mm_mul_ps(ny, invLen), qy);
+    qz = select(spinning, _mm_mul_ps(nz, invLen), qz);
+    qw = select(spinning, _mm_mul_ps(nw, invLen), qw);
+
+    scatter(b, qx, [](RigidBody* r, float x) { r->orientation.x = x; });
+    scatter(b, qy, [](RigidBody* r, float x) { r->orientation.y = x; });
+    scatter(b, qz, [](RigidBody* r, float x) { r->orientation.z = x; });
+    scatter(b, qw, [](RigidBody* r, float x) { r->orientation.w = x; });
+
+    // --- World inverse inertia: R * I_body^-1 * R^T ---
+    // Same products and sums, in the same order, as glm's mat3_cast and mat3
+    // multiply in RigidBody::updateInertiaTensor
+    __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+    __m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+    __m128 wx = _mm_mul_ps(qw, qx), wy = _mm_mul_ps(qw, qy), wz = _mm_mul_ps(qw, qz);
+
+    __m128 rot[3][3] = {
+        { _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))),
+          _mm_mul_ps(two, _mm_sub_ps(xy, wz)),
+          _mm_mul_ps(two, _mm_add_ps(xz, wy)) },
+        { _mm_mul_ps(two, _mm_add_ps(xy, wz)),
+          _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))),
+          _mm_mul_ps(two, _mm_sub_ps(yz, wx)) },
+        { _mm_mul_ps(two, _mm_sub_ps(xz, wy)),
+          _mm_mul_ps(two, _mm_add_ps(yz, wx)),
+          _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))) }
+    };
+
+    __m128 ib[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            ib[i][j] = gather(b, [i, j](RigidBody* r) { return r->inverseInertiaTensor[j][i]; });
+        }
+    }
+
+    // m = R * I_body^-1
+    __m128 m[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            m[i][j] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rot[i][0], ib[0][j]), _mm_mul_ps(rot[i][1], ib[1][j])),
+                                 _mm_mul_ps(rot[i][2], ib[2][j]));
+        }
+    }
+
+    // world = m * R^T
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            __m128 value = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[i][0], rot[j][0]), _mm_mul_ps(m[i][1], rot[j][1])),
+                                      _mm_mul_ps(m[i][2], rot[j][2]));
+            scatter(b, value, [i, j](RigidBody* r, float x) { r->worldInverseInertiaTensor[j][i] = x; });
+        }
+    }
+
+    // Sleep bookkeeping and force reset stay per body
+    for (size_t lane = 0; lane < LaneWidth; ++lane) {
+        b[lane]->updateSleepState(dt);
+        b[lane]->clearForces();
+    }
+}
+
+#else
+
+void BatchIntegrator::integrateLanes(RigidBody* const* bodies, float dt) {
+    for (size_t lane = 0; lane < LaneWidth; ++lane) {
+        bodies[lane]->integrate(dt);
+    }
+}
+
+#endif
+
+} // namespace engine::physics
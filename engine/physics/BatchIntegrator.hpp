@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace engine::physics {
+
+class RigidBody;
+
+/**
+ * @brief Integrates dynamic rigid bodies four at a time with SSE
+ * Performs the same semi-implicit Euler step as RigidBody::integrate
+ * (velocity update, cached damping, quaternion integration and world
+ * inverse inertia rotation) across SIMD lanes, with a scalar tail. Both
+ * paths do the same float operations in the same order, so results are
+ * bit-identical whichever path a body takes.
+ * Falls back to the scalar path when SSE is unavailable.
+ */
+class BatchIntegrator {
+public:
+    static constexpr size_t LaneWidth = 4;
+
+    // Bodies must be dynamic and awake; forces are cleared afterwards
+    void integrate(const std::vector<RigidBody*>& bodies, float dt);
+
+    size_t getLastBatchCount() const { return lastBatchCount; }
+    size_t getLastScalarCount() const { return lastScalarCount; }
+
+private:
+    size_t lastBatchCount = 0;
+    size_t lastScalarCount = 0;
+
+    void integrateLanes(RigidBody* const* bodies, float dt);
+};
+
+} // namespace engine::physics
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+namespace engine::physics {
+
+/**
+ * @brief Generational reference to a body owned by a PhysicsWorld
+ * The index selects a slot and the generation must match the slot's, so a
+ * handle to a removed body never resolves to whatever reuses the slot.
+ */
+struct BodyHandle {
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = InvalidIndex;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != InvalidIndex; }
+
+    bool operator==(const BodyHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const BodyHandle& other) const { return !(*this == other); }
+};
+
+} // namespace engine::physics
+
+namespace std {
+template<>
+struct hash<engine::physics::BodyHandle> {
+    size_t operator()(const engine::physics::BodyHandle& handle) const {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(handle.generation) << 32) | handle.index);
+    }
+};
+} // namespace std
@@ -161,19 +161,17 @@ std::vector<glm::vec3> BoxShape::getFaceNormals(const Transform& transform) cons
 }
 
 BoundingBox BoxShape::calculateRotatedAABB(const Transform& transform) const {
-   std::vector<glm::vec3> vertices = getVertices(transform);
-   
-   BoundingBox aabb;
-   for (const auto& vertex : vertices) {
-       aabb.expand(vertex);
+   // Each world axis extent is the box extents projected through |R|; this
+   // runs for every rotated box every step, so no corner list is built
+   const glm::mat3 rotation = glm::mat3_cast(transform.rotation);
+   const glm::vec3 scaledExtents = halfExtents * transform.scale;
+   glm::vec3 extent(0.0f);
+   for (int axis = 0; axis < 3; ++axis) {
+       extent += glm::abs(rotation[axis]) * scaledExtents[axis];
    }
+   extent += glm::vec3(margin);
    
-   // Add margin
-   glm::vec3 marginVec(margin);
-   aabb.min -= marginVec;
-   aabb.max += marginVec;
-   
-   return aabb;
+   return BoundingBox(transform.position - extent, transform.position + extent);
 }
 
 } // namespace engine::physics
\ No newline at end of file
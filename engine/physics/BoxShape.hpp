@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CollisionShape.hpp"
+#include <vector>
 
 namespace engine::physics {
 
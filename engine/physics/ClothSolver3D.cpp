@@ -46,6 +46,20 @@ void ClothSolver3D::createCloth(const glm::vec3& origin, const glm::vec3& rightD
     }
 }
 
+void ClothSolver3D::adoptCloth(std::vector<std::shared_ptr<Particle3D>> clothParticles,
+                               std::vector<std::shared_ptr<Spring3D>> clothSprings) {
+    particles = std::move(clothParticles);
+    springs = std::move(clothSprings);
+
+    system.reserve(particles.size(), springs.size());
+    for (const auto& particle : particles) {
+        system.addParticle(particle);
+    }
+    for (const auto& spring : springs) {
+        system.addSpring(spring);
+    }
+}
+
 std::shared_ptr<Particle3D> ClothSolver3D::getParticle(int x, int y) const {
     return particles[y * (width + 1) + x];
 }
@@ -15,9 +15,18 @@ public:
 
     void createCloth(const glm::vec3& origin, const glm::vec3& rightDir, const glm::vec3& downDir);
 
+    // Takes over particles and springs built elsewhere (e.g. by SceneFile)
+    // in place of createCloth, and adds them to the system
+    void adoptCloth(std::vector<std::shared_ptr<Particle3D>> clothParticles,
+                    std::vector<std::shared_ptr<Spring3D>> clothSprings);
+
     const std::vector<std::shared_ptr<Particle3D>>& getParticles() const;
     const std::vector<std::shared_ptr<Spring3D>>& getSprings() const;
 
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    float getParticleDistance() const { return particleDistance; }
+
 private:
     int width;
     int height;
@@ -0,0 +1,5 @@
+#pragma once
+
+// The shape base types live in CollisonShape.hpp; this is the name the rest of
+// the engine includes them by
+#include "CollisonShape.hpp"
@@ -201,7 +201,8 @@ public:
         Cone,
         ConvexMesh,
         ConcaveMesh,
-        Heightfield
+        Heightfield,
+        Compound
     };
 
     virtual ~CollisionShape() = default;
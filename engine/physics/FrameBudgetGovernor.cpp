@@ -0,0 +1,225 @@
+#include "FrameBudgetGovernor.hpp"
+#include "../core/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace engine::physics {
+
+using engine::core::log::Logger;
+using engine::core::log::LogLevel;
+
+namespace {
+
+constexpr size_t KnobCount = static_cast<size_t>(FrameBudgetGovernor::Knob::Count);
+
+size_t indexOf(FrameBudgetGovernor::Knob knob) {
+    return static_cast<size_t>(knob);
+}
+
+} // namespace
+
+FrameBudgetGovernor::FrameBudgetGovernor(PhysicsWorld& world, const Settings& settings, PhysicsWorld3D* clothWorld)
+    : world(world), clothWorld(clothWorld), settings(settings),
+      baseVelocityIterations(world.getVelocityIterations()),
+      baseLod(world.getLodSettings()),
+      baseClothLod(clothWorld ? clothWorld->getLodSettings() : PhysicsWorld3D::LodSettings{}) {
+    metrics.budgetMs = settings.budgetMs;
+    metrics.velocityIterations = baseVelocityIterations;
+    metrics.clothIterations = settings.clothIterations;
+}
+
+const char* FrameBudgetGovernor::getKnobName(Knob knob) {
+    switch (knob) {
+        case Knob::VelocityIterations: return "velocity iterations";
+        case Knob::ClothIterations: return "cloth iterations";
+        case Knob::LodDistance: return "LOD distance scale";
+        default: return "unknown";
+    }
+}
+
+void FrameBudgetGovernor::update(float clothMs) {
+    const PhysicsWorld::PerformanceStats& stats = world.getPerformanceStats();
+
+    ++metrics.frames;
+    metrics.budgetMs = settings.budgetMs;
+    metrics.broadPhaseMs = stats.broadPhaseTime;
+    metrics.narrowPhaseMs = stats.narrowPhaseTime;
+    metrics.solverMs = stats.solverTime;
+    metrics.clothMs = clothMs;
+    metrics.frameMs = stats.totalTime + clothMs;
+    metrics.averageMs = metrics.frames == 1 ? metrics.frameMs
+                                            : metrics.averageMs + 0.1f * (metrics.frameMs - metrics.averageMs);
+    metrics.stepsBehind = stats.stepsBehind;
+
+    // Falling behind means steps were left undone, so it is over budget
+    // whatever the clock says
+    const bool behind = stats.stepsBehind > 0;
+    const bool over = behind || metrics.frameMs > settings.budgetMs;
+    if (over) {
+        ++metrics.framesOverBudget;
+        if (behind) ++metrics.framesBehind;
+        ++overStreak;
+        underStreak = 0;
+    } else if (metrics.frameMs < settings.budgetMs * settings.restoreRatio) {
+        ++underStreak;
+        overStreak = 0;
+        metrics.saturated = false;
+    } else {
+        // Inside the band between the two thresholds: hold
+        overStreak = 0;
+        underStreak = 0;
+        metrics.saturated = false;
+    }
+
+    if (overStreak >= settings.overBudgetFrames) {
+        overStreak = 0;
+        const bool wasSaturated = metrics.saturated;
+        metrics.saturated = !degrade();
+        if (metrics.saturated && !wasSaturated) {
+            char message[160];
+            std::snprintf(message, sizeof(message),
+                          "Physics over budget (%.2f of %.2f ms, %d steps behind) with every knob at its floor",
+                          metrics.frameMs, settings.budgetMs, stats.stepsBehind);
+            Logger::log(message, LogLevel::Warning);
+        }
+    } else if (underStreak >= settings.restoreFrames) {
+        underStreak = 0;
+        restore();
+    }
+}
+
+void FrameBudgetGovernor::restoreAll() {
+    while (restore()) {
+    }
+    overStreak = 0;
+    underStreak = 0;
+    metrics.saturated = false;
+}
+
+float FrameBudgetGovernor::knobValue(Knob knob, int level) const {
+    switch (knob) {
+        case Knob::VelocityIterations:
+            return static_cast<float>(std::max(std::min(baseVelocityIterations, settings.minVelocityIterations),
+                                               baseVelocityIterations - level * settings.velocityIterationStep));
+        case Knob::ClothIterations:
+            return static_cast<float>(std::max(std::min(settings.clothIterations, settings.minClothIterations),
+                                               settings.clothIterations >> level));
+        case Knob::LodDistance:
+            return std::max(settings.minLodDistanceScale,
+                            std::pow(settings.lodDistanceStep, static_cast<float>(level)));
+        default:
+            return 0.0f;
+    }
+}
+
+int FrameBudgetGovernor::maxLevel(Knob knob) const {
+    // The last level that still changes the value
+    int level = 0;
+    while (level < 31 && knobValue(knob, level + 1) != knobValue(knob, level)) {
+        ++level;
+    }
+    return level;
+}
+
+bool FrameBudgetGovernor::applies(Knob knob) const {
+    switch (knob) {
+        case Knob::ClothIterations:
+            return metrics.clothMs > 0.0f;
+        case Knob::LodDistance:
+            return !world.getObservers().empty() || (clothWorld && !clothWorld->getObservers().empty());
+        default:
+            return true;
+    }
+}
+
+void FrameBudgetGovernor::apply(Knob knob, int level) {
+    const float value = knobValue(knob, level);
+    switch (knob) {
+        case Knob::VelocityIterations:
+            metrics.velocityIterations = static_cast<int>(value);
+            world.setVelocityIterations(metrics.velocityIterations);
+            break;
+        case Knob::ClothIterations:
+            metrics.clothIterations = static_cast<int>(value);
+            break;
+        case Knob::LodDistance: {
+            metrics.lodDistanceScale = value;
+            PhysicsWorld::LodSettings lod = baseLod;
+            PhysicsWorld3D::LodSettings clothLod = baseClothLod;
+            if (level > 0) {
+                lod.enabled = true;
+                lod.halfRateDistance *= value;
+                lod.quarterRateDistance *= value;
+                clothLod.enabled = true;
+                clothLod.halfRateDistance *= value;
+                clothLod.quarterRateDistance *= value;
+                clothLod.freezeDistance *= value;
+            }
+            world.setLodSettings(lod);
+            if (clothWorld) {
+                clothWorld->setLodSettings(clothLod);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+bool FrameBudgetGovernor::degrade() {
+    for (size_t i = 0; i < KnobCount; ++i) {
+        const Knob knob = static_cast<Knob>(i);
+        if (applies(knob) && levels[i] < maxLevel(knob)) {
+            const int previous = levels[i]++;
+            taken.push_back(knob);
+            apply(knob, levels[i]);
+            record(knob, true, previous);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FrameBudgetGovernor::restore() {
+    // Priority order alone is not enough: a knob skipped while it could not
+    // help may be taken after later ones
+    if (taken.empty()) return false;
+
+    const Knob knob = taken.back();
+    taken.pop_back();
+    const int previous = levels[indexOf(knob)]--;
+    apply(knob, levels[indexOf(knob)]);
+    record(knob, false, previous);
+    return true;
+}
+
+void FrameBudgetGovernor::record(Knob knob, bool degraded, int previousLevel) {
+    lastDecision.frame = metrics.frames;
+    lastDecision.knob = knob;
+    lastDecision.degraded = degraded;
+    lastDecision.previous = knobValue(knob, previousLevel);
+    lastDecision.value = knobValue(knob, levels[indexOf(knob)]);
+    lastDecision.frameMs = metrics.frameMs;
+
+    if (degraded) {
+        ++metrics.degradations;
+        ++metrics.notchesTaken;
+    } else {
+        ++metrics.restorations;
+        --metrics.notchesTaken;
+    }
+    ++metrics.decisionsByKnob[indexOf(knob)];
+
+    char message[160];
+    std::snprintf(message, sizeof(message), "Physics budget: %s %s %g -> %g (%.2f of %.2f ms)",
+                  degraded ? "lowered" : "restored", getKnobName(knob), lastDecision.previous,
+                  lastDecision.value, metrics.frameMs, settings.budgetMs);
+    Logger::log(message, LogLevel::Info);
+
+    if (onDecision) {
+        onDecision(lastDecision);
+    }
+}
+
+} // namespace engine::physics
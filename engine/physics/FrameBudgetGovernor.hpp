@@ -0,0 +1,126 @@
+#pragma once
+#include "PhysicsWorld.hpp"
+#include "PhysicsWorld3D.hpp"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace engine::physics {
+
+/**
+ * @brief Holds physics to a per-frame time budget by trading away quality
+ *
+ * Call update() once per frame, after stepping. It adds the world's phase
+ * times to the cloth time the caller measured and compares the sum with the
+ * budget. A frame in which the world hit maxSubSteps and fell behind counts
+ * as over budget whatever it measured, since it did not do all its work.
+ *
+ * After overBudgetFrames such frames in a row the governor takes one notch
+ * off the first of these that still has room:
+ *   1. PhysicsWorld velocity iterations, velocityIterationStep at a time
+ *   2. cloth solver iterations, halved (the caller passes getClothIterations()
+ *      to its cloth update)
+ *   3. distance LOD tier distances, scaled by lodDistanceStep, so more bodies
+ *      and cloths step at reduced rate; enables LOD if it was off
+ * After restoreFrames frames in a row under restoreRatio of the budget it
+ * gives one notch back, most recently taken first. Knobs that cannot help
+ * are skipped: cloth when no cloth time is reported, LOD when nothing has
+ * observers.
+ *
+ * Every decision is counted in the metrics, kept as the last decision,
+ * logged and passed to onDecision. The governor owns these knobs while it
+ * lives: baselines are read at construction and restored by restoreAll().
+ */
+class FrameBudgetGovernor {
+public:
+    struct Settings {
+        float budgetMs = 8.0f;
+        float restoreRatio = 0.7f;              // Give quality back below this share of the budget
+        int overBudgetFrames = 3;
+        int restoreFrames = 60;
+        int clothIterations = 5;                // Baseline for getClothIterations()
+        int minVelocityIterations = 2;
+        int velocityIterationStep = 2;
+        int minClothIterations = 2;
+        float lodDistanceStep = 0.7f;
+        float minLodDistanceScale = 0.25f;
+    };
+
+    enum class Knob : uint8_t { VelocityIterations, ClothIterations, LodDistance, Count };
+
+    struct Decision {
+        uint64_t frame = 0;
+        Knob knob = Knob::VelocityIterations;
+        bool degraded = false;                  // False when quality was given back
+        float previous = 0.0f;                  // Iterations, or LOD distance scale
+        float value = 0.0f;
+        float frameMs = 0.0f;                   // Measurement of the frame that decided
+    };
+
+    struct Metrics {
+        uint64_t frames = 0;
+        float budgetMs = 0.0f;
+        float frameMs = 0.0f;                   // Last frame: physics plus cloth
+        float averageMs = 0.0f;                 // Exponential average of frameMs
+        float broadPhaseMs = 0.0f;
+        float narrowPhaseMs = 0.0f;
+        float solverMs = 0.0f;
+        float clothMs = 0.0f;
+        int stepsBehind = 0;                    // From the world; nonzero when maxSubSteps cut in
+        uint64_t framesOverBudget = 0;
+        uint64_t framesBehind = 0;
+        uint64_t degradations = 0;
+        uint64_t restorations = 0;
+        uint64_t decisionsByKnob[static_cast<size_t>(Knob::Count)] = {};
+        int velocityIterations = 0;
+        int clothIterations = 0;
+        float lodDistanceScale = 1.0f;
+        int notchesTaken = 0;                   // Over all knobs; 0 is full quality
+        bool saturated = false;                 // Over budget with nothing left to give
+    };
+
+    FrameBudgetGovernor(PhysicsWorld& world, const Settings& settings, PhysicsWorld3D* clothWorld = nullptr);
+
+    // Measures the frame just stepped and adjusts the knobs
+    void update(float clothMs = 0.0f);
+
+    // Puts every knob back to its baseline
+    void restoreAll();
+
+    void setBudgetMs(float budgetMs) { settings.budgetMs = budgetMs; }
+
+    int getClothIterations() const { return metrics.clothIterations; }
+    const Metrics& getMetrics() const { return metrics; }
+    const Decision& getLastDecision() const { return lastDecision; }
+
+    static const char* getKnobName(Knob knob);
+
+    std::function<void(const Decision&)> onDecision;
+
+private:
+    PhysicsWorld& world;
+    PhysicsWorld3D* clothWorld;
+    Settings settings;
+
+    // Baselines
+    int baseVelocityIterations;
+    PhysicsWorld::LodSettings baseLod;
+    PhysicsWorld3D::LodSettings baseClothLod;
+
+    int levels[static_cast<size_t>(Knob::Count)] = {};
+    std::vector<Knob> taken;                    // One entry per notch taken, newest last
+    int overStreak = 0;
+    int underStreak = 0;
+    Metrics metrics;
+    Decision lastDecision;
+
+    int maxLevel(Knob knob) const;
+    bool applies(Knob knob) const;
+    float knobValue(Knob knob, int level) const;
+    void apply(Knob knob, int level);
+    bool degrade();
+    bool restore();
+    void record(Knob knob, bool degraded, int previousLevel);
+};
+
+} // namespace engine::physics
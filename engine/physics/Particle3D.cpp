@@ -12,6 +12,14 @@ void Particle3D::applyForce(const glm::vec3& force) {
     }
 }
 
+void Particle3D::scaleForce(float factor) {
+    accumulatedForce *= factor;
+}
+
+void Particle3D::clearForce() {
+    accumulatedForce = glm::vec3(0.0f);
+}
+
 void Particle3D::integrate(float dt, float globalDamping) {
     if (pinned) {
         previousPosition = position; // stay locked
@@ -54,6 +62,10 @@ const glm::vec3& Particle3D::getPreviousPosition() const {
     return previousPosition;
 }
 
+void Particle3D::setPreviousPosition(const glm::vec3& pos) {
+    previousPosition = pos;
+}
+
 float Particle3D::getMass() const {
     return mass;
 }
@@ -11,6 +11,8 @@ public:
     Particle3D(const glm::vec3& position, float mass = 1.0f, bool pinned = false);
 
     void applyForce(const glm::vec3& force);
+    void scaleForce(float factor);
+    void clearForce();
     void integrate(float dt, float globalDamping = 0.98f);
     void pin();
     void unpin();
@@ -20,6 +22,7 @@ public:
     const glm::vec3& getPosition() const;
     void setPosition(const glm::vec3& pos);
     const glm::vec3& getPreviousPosition() const;
+    void setPreviousPosition(const glm::vec3& pos);
     float getMass() const;
 
 private:
@@ -0,0 +1,133 @@
+#pragma once
+#include "../core/TripleBuffer.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace engine::physics {
+
+/**
+ * @brief Steps a physics world on a dedicated thread
+ * World must provide update(float), a TransformSnapshot type and
+ * writeSnapshot(TransformSnapshot&) const. After every step the thread
+ * publishes a snapshot that the render thread reads without blocking.
+ *
+ * While running, the world belongs to the physics thread: anything that
+ * mutates it (forces, spawns, removals) goes through enqueue() and runs at
+ * the start of the next step, in submission order. Work that must happen on
+ * every step, such as a continuous force, goes in the step hook instead,
+ * which runs after the commands and before each update.
+ */
+template <typename World>
+class PhysicsThread {
+public:
+    using Snapshot = typename World::TransformSnapshot;
+    using Command = std::function<void(World&)>;
+
+    PhysicsThread(World& world, float stepInterval)
+        : world(world), stepInterval(stepInterval) {}
+
+    ~PhysicsThread() { stop(); }
+
+    PhysicsThread(const PhysicsThread&) = delete;
+    PhysicsThread& operator=(const PhysicsThread&) = delete;
+
+    void start() {
+        if (running.exchange(true)) return;
+
+        // Readers get a valid snapshot before the first step completes
+        world.writeSnapshot(snapshots.writeBuffer());
+        snapshots.publish();
+
+        thread = std::thread([this] { run(); });
+    }
+
+    // Finishes the step in progress; queued commands stay queued for the next start()
+    void stop() {
+        if (!running.exchange(false)) return;
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+    void enqueue(Command command) {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        pendingCommands.push_back(std::move(command));
+    }
+
+    // Runs on the physics thread before every step; set it while stopped
+    void setStepHook(Command hook) { stepHook = std::move(hook); }
+
+    // Render thread only; the reference stays valid until the next call
+    const Snapshot& acquireSnapshot() { return snapshots.read(); }
+
+    uint64_t getStepCount() const { return stepCount.load(std::memory_order_relaxed); }
+    float getLastStepTime() const { return lastStepTime.load(std::memory_order_relaxed); }   // ms
+
+private:
+    World& world;
+    float stepInterval;
+
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    std::mutex commandMutex;
+    std::vector<Command> pendingCommands;
+    std::vector<Command> executingCommands;     // Physics thread only
+    Command stepHook;
+
+    core::threading::TripleBuffer<Snapshot> snapshots;
+
+    std::atomic<uint64_t> stepCount{0};
+    std::atomic<float> lastStepTime{0.0f};
+
+    void run() {
+        using clock = std::chrono::steady_clock;
+        const auto interval = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<float>(stepInterval));
+        auto nextStep = clock::now();
+
+        while (running.load(std::memory_order_acquire)) {
+            const auto stepStart = clock::now();
+
+            {
+                std::lock_guard<std::mutex> lock(commandMutex);
+                executingCommands.swap(pendingCommands);
+            }
+            for (Command& command : executingCommands) {
+                command(world);
+            }
+            executingCommands.clear();
+
+            if (stepHook) {
+                stepHook(world);
+            }
+            world.update(stepInterval);
+            world.writeSnapshot(snapshots.writeBuffer());
+            snapshots.publish();
+
+            stepCount.fetch_add(1, std::memory_order_relaxed);
+            lastStepTime.store(std::chrono::duration<float, std::milli>(clock::now() - stepStart).count(),
+                               std::memory_order_relaxed);
+
+            // Fixed cadence; after a stall resume from now rather than
+            // running a burst of catch-up steps
+            nextStep += interval;
+            const auto now = clock::now();
+            if (nextStep < now) {
+                nextStep = now;
+            } else {
+                std::this_thread::sleep_until(nextStep);
+            }
+        }
+    }
+};
+
+} // namespace engine::physics
@@ -376,22 +376,67 @@
 
 
 #include "PhysicsWorld.hpp"
+#include "SphereShape.hpp"
 #include "engine/core/Logger.hpp"
+#include "engine/core/Hash.hpp"
 #include <algorithm>
 #include <unordered_set>
 #include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <optional>
 #include <sstream>
+#include <type_traits>
 
 namespace engine::physics {
 
-PhysicsWorld::PhysicsWorld() {
-    rigidBodies.reserve(1000);
-    contactManifolds.reserve(1000);
-    activePairs.reserve(500);
-    newPairs.reserve(500);
+struct PhysicsWorld::SnapshotHeader {
+   static constexpr uint32_t Magic = 0x50534E50u;   // "PNSP"
+   static constexpr uint32_t Version = 2;
+   
+   uint32_t magic;
+   uint32_t version;
+   uint64_t stepCount;
+   uint64_t lastStateHash;
+   float accumulator;
+   uint32_t bodyCount;
+   uint32_t pairCount;
+   uint32_t reserved;
+};
+
+// Per-body state a step changes: RigidBody keeps it in one run from position
+// through statePadding, copied as raw bytes. It includes the interpolation
+// pose, so a restored world interpolates from where it was at save. Mass,
+// inertia and damping only change through setters and are treated as
+// configuration; damping factors and broad-phase proxies are caches and are
+// rebuilt instead.
+struct PhysicsWorld::BodySnapshot {
+   static constexpr size_t StateOffset = offsetof(RigidBody, position);
+   static constexpr size_t StateBytes = offsetof(RigidBody, statePadding) + sizeof(RigidBody::statePadding) - StateOffset;
+   
+   // Implicit padding would copy indeterminate bytes into the buffer
+   static_assert(StateBytes == 6 * sizeof(glm::vec3) + 2 * sizeof(glm::quat) + sizeof(glm::mat3) +
+                               sizeof(float) + 2 * sizeof(uint64_t) + sizeof(bool) + 2 * sizeof(uint8_t) +
+                               sizeof(RigidBody::statePadding),
+                 "RigidBody snapshot block has implicit padding");
+   
+   BodyHandle handle;
+   unsigned char state[StateBytes];
+};
+
+PhysicsWorld::PhysicsWorld() : PhysicsWorld(Settings{}) {
+}
+
+PhysicsWorld::PhysicsWorld(const Settings& settings)
+    : frameArenas(1, settings.frameArenaBytes) {
+    rigidBodies.reserve(settings.expectedBodies);
+    integrationBatch.reserve(settings.expectedBodies);
+    contactManifolds.reserve(settings.expectedBodies);
+    activePairs.reserve(settings.expectedBodies / 2);
+    newPairs.reserve(settings.expectedBodies / 2);
     
     // Initialize with spatial hash broad phase
-    broadPhase = std::make_unique<SpatialHashBroadPhase>(5.0f);
+    broadPhase = std::make_unique<SpatialHashBroadPhase>(settings.broadPhaseCellSize);
 }
 
 PhysicsWorld::~PhysicsWorld() {
@@ -405,42 +450,71 @@ void PhysicsWorld::update(float dt) {
     // Reset performance stats
     perfStats = PerformanceStats{};
     
+    // Everything transient this update comes from the frame arena
+    frameArenas.reset();
+    core::memory::FrameArena::Scope arenaScope(frameArenas[0]);
+    
+    // Bodies removed since the last update never enter this one
+    flushRemovals();
+    
     // Fixed timestep with accumulator
     accumulator += dt;
     
     int steps = 0;
     while (accumulator >= fixedTimeStep && steps < maxSubSteps) {
+        // Remember where this step starts for render interpolation
+        storePreviousPoses();
+        
+        // Distance LOD picks the bodies that move this step; their gravity
+        // is added at integration, scaled to their stride
+        const bool lodStep = scheduleLodStep(stepCount + 1);
+        
         // Apply gravity and other forces
-        integrateForces(fixedTimeStep);
+        if (!lodStep) {
+            integrateForces(fixedTimeStep);
+        }
         
         // Broad phase collision detection
         auto broadStart = high_resolution_clock::now();
         broadPhaseCollision();
-        perfStats.broadPhaseTime = endTimer(broadStart);
+        perfStats.broadPhaseTime += endTimer(broadStart);
         
         // Narrow phase collision detection
         auto narrowStart = high_resolution_clock::now();
         narrowPhaseCollision();
-        perfStats.narrowPhaseTime = endTimer(narrowStart);
+        perfStats.narrowPhaseTime += endTimer(narrowStart);
         
         // Collision resolution
         auto solverStart = high_resolution_clock::now();
+        if (lodStep) {
+            prepareLodBodies(stepCount + 1);
+        }
         resolveCollisions();
-        perfStats.solverTime = endTimer(solverStart);
+        perfStats.solverTime += endTimer(solverStart);
         
         // Integrate velocities to positions
-// Integrate velocities to positions
-       integrateBodies(fixedTimeStep);
+       if (lodStep) {
+           integrateLodBodies();
+       } else {
+           integrateBodies(fixedTimeStep);
+       }
        
        // Update collision events
        updateCollisionEvents();
        
        accumulator -= fixedTimeStep;
        steps++;
+       stepCount++;
+       
+       if (deterministic) {
+           lastStateHash = computeStateHash();
+       }
    }
    
    // Update performance stats
    perfStats.totalTime = endTimer(frameStart);
+   perfStats.subSteps = steps;
+   perfStats.stepsBehind = static_cast<int>(accumulator / fixedTimeStep);
    perfStats.contactsGenerated = contactManifolds.size();
    
    size_t activeCount = 0, sleepingCount = 0;
@@ -450,19 +524,34 @@ void PhysicsWorld::update(float dt) {
        } else {
            activeCount++;
        }
+       if (body->getBodyType() == RigidBody::BodyType::Dynamic) {
+           perfStats.bodiesPerTier[body->updateTier]++;
+       }
    }
    perfStats.bodiesActive = activeCount;
    perfStats.bodiesSleeping = sleepingCount;
+   perfStats.frameArenaBytes = frameArenas.getUsed();
+   perfStats.frameArenaOverflows = frameArenas.getOverflowCount();
    
    // Clear old contact manifolds
    contactManifolds.clear();
+   
+   // Removals requested during the step (e.g. from collision callbacks)
+   flushRemovals();
 }
 
 void PhysicsWorld::clear() {
+   // Release every slot but keep generations so stale handles stay invalid
+   for (uint32_t slotIndex : denseToSlot) {
+       releaseSlot(slotIndex);
+   }
    rigidBodies.clear();
+   denseToSlot.clear();
+   pendingRemovals.clear();
    contactManifolds.clear();
    activePairs.clear();
    newPairs.clear();
+   pairHints.clear();
    accumulator = 0.0f;
    perfStats = PerformanceStats{};
    
@@ -471,49 +560,223 @@ void PhysicsWorld::clear() {
    }
 }
 
-void PhysicsWorld::addRigidBody(std::shared_ptr<RigidBody> body) {
-   if (body && std::find(rigidBodies.begin(), rigidBodies.end(), body) == rigidBodies.end()) {
-       rigidBodies.push_back(body);
-       
-       if (broadPhase) {
-           broadPhase->insertBody(body.get());
+BodyHandle PhysicsWorld::createRigidBody(RigidBody::BodyType type, float mass) {
+   BodyHandle handle = registerBody(bodyPool.create(type, mass), nullptr);
+   if (broadPhase) {
+       broadPhase->insertBody(bodySlots[handle.index].body);
+   }
+   return handle;
+}
+
+BodyHandle PhysicsWorld::addRigidBody(std::shared_ptr<RigidBody> body) {
+   if (!body) {
+       return BodyHandle{};
+   }
+   
+   BodyHandle existing = findRegistered(body.get());
+   if (existing.isValid()) {
+       return existing;
+   }
+   
+   RigidBody* raw = body.get();
+   BodyHandle handle = registerBody(raw, std::move(body));
+   if (broadPhase) {
+       broadPhase->insertBody(raw);
+   }
+   return handle;
+}
+
+std::vector<BodyHandle> PhysicsWorld::createRigidBodies(size_t count, const BodySetup& setup,
+                                                       RigidBody::BodyType type, float mass) {
+   std::vector<BodyHandle> handles;
+   handles.reserve(count);
+   rigidBodies.reserve(rigidBodies.size() + count);
+   denseToSlot.reserve(denseToSlot.size() + count);
+   
+   bodyBatch.clear();
+   for (size_t i = 0; i < count; ++i) {
+       RigidBody* body = bodyPool.create(type, mass);
+       if (setup) {
+           setup(*body, i);
        }
+       handles.push_back(registerBody(body, nullptr));
+       bodyBatch.push_back(body);
    }
+   
+   if (broadPhase) {
+       broadPhase->insertBodies(bodyBatch);
+   }
+   return handles;
 }
 
-void PhysicsWorld::removeRigidBody(std::shared_ptr<RigidBody> body) {
-   auto it = std::find(rigidBodies.begin(), rigidBodies.end(), body);
-   if (it != rigidBodies.end()) {
-       if (broadPhase) {
-           broadPhase->removeBody(body.get());
+std::vector<BodyHandle> PhysicsWorld::addRigidBodies(const std::vector<std::shared_ptr<RigidBody>>& bodies) {
+   std::vector<BodyHandle> handles;
+   handles.reserve(bodies.size());
+   rigidBodies.reserve(rigidBodies.size() + bodies.size());
+   denseToSlot.reserve(denseToSlot.size() + bodies.size());
+   
+   bodyBatch.clear();
+   for (const auto& body : bodies) {
+       if (!body) {
+           handles.push_back(BodyHandle{});
+           continue;
+       }
+       BodyHandle existing = findRegistered(body.get());
+       if (existing.isValid()) {
+           handles.push_back(existing);
+           continue;
+       }
+       handles.push_back(registerBody(body.get(), body));
+       bodyBatch.push_back(body.get());
+   }
+   
+   if (broadPhase) {
+       broadPhase->insertBodies(bodyBatch);
+   }
+   return handles;
+}
+
+BodyHandle PhysicsWorld::findRegistered(RigidBody* body) {
+   // Already in this world: the handle's slot points back at the body
+   const BodyHandle existing = body->handle;
+   if (existing.index >= bodySlots.size() || bodySlots[existing.index].body != body) {
+       return BodyHandle{};
+   }
+   
+   // Removed since the last flush: cancel the removal rather than register
+   // a second copy that the flush would then take out again
+   BodySlot& slot = bodySlots[existing.index];
+   if (slot.pendingRemoval) {
+       slot.pendingRemoval = false;
+       pendingRemovals.erase(std::remove(pendingRemovals.begin(), pendingRemovals.end(), existing),
+                             pendingRemovals.end());
+   }
+   return existing;
+}
+
+BodyHandle PhysicsWorld::registerBody(RigidBody* body, std::shared_ptr<RigidBody> shared) {
+   uint32_t slotIndex = freeSlot;
+   if (slotIndex != BodyHandle::InvalidIndex) {
+       freeSlot = bodySlots[slotIndex].nextFree;
+   } else {
+       slotIndex = static_cast<uint32_t>(bodySlots.size());
+       bodySlots.emplace_back();
+   }
+   
+   BodySlot& slot = bodySlots[slotIndex];
+   slot.body = body;
+   slot.shared = std::move(shared);
+   slot.denseIndex = static_cast<uint32_t>(rigidBodies.size());
+   slot.nextFree = BodyHandle::InvalidIndex;
+   slot.pendingRemoval = false;
+   
+   rigidBodies.push_back(body);
+   denseToSlot.push_back(slotIndex);
+   
+   body->handle = BodyHandle{slotIndex, slot.generation};
+   return body->handle;
+}
+
+void PhysicsWorld::removeRigidBody(BodyHandle handle) {
+   if (!isValid(handle)) {
+       return;
+   }
+   bodySlots[handle.index].pendingRemoval = true;
+   pendingRemovals.push_back(handle);
+}
+
+void PhysicsWorld::removeRigidBody(const std::shared_ptr<RigidBody>& body) {
+   if (body) {
+       removeRigidBody(body->handle);
+   }
+}
+
+void PhysicsWorld::removeRigidBodies(const std::vector<BodyHandle>& handles) {
+   pendingRemovals.reserve(pendingRemovals.size() + handles.size());
+   for (const BodyHandle& handle : handles) {
+       removeRigidBody(handle);
+   }
+}
+
+RigidBody* PhysicsWorld::getRigidBody(BodyHandle handle) const {
+   return isValid(handle) ? bodySlots[handle.index].body : nullptr;
+}
+
+bool PhysicsWorld::isValid(BodyHandle handle) const {
+   if (handle.index >= bodySlots.size()) {
+       return false;
+   }
+   const BodySlot& slot = bodySlots[handle.index];
+   return slot.generation == handle.generation && slot.body && !slot.pendingRemoval;
+}
+
+void PhysicsWorld::flushRemovals() {
+   if (pendingRemovals.empty()) {
+       return;
+   }
+   
+   // One pass over each pair cache, while every body pointer is still alive
+   auto isRemoved = [this](const RigidBody* body) {
+       return bodySlots[body->handle.index].pendingRemoval;
+   };
+   auto pairRemoved = [&](const CollisionPair& pair) {
+       return isRemoved(pair.bodyA) || isRemoved(pair.bodyB);
+   };
+   activePairs.erase(std::remove_if(activePairs.begin(), activePairs.end(), pairRemoved), activePairs.end());
+   newPairs.erase(std::remove_if(newPairs.begin(), newPairs.end(), pairRemoved), newPairs.end());
+   contactManifolds.erase(
+       std::remove_if(contactManifolds.begin(), contactManifolds.end(),
+           [&](const ContactManifold& manifold) {
+               return isRemoved(manifold.getBodyA()) || isRemoved(manifold.getBodyB());
+           }),
+       contactManifolds.end());
+   
+   if (broadPhase) {
+       bodyBatch.clear();
+       for (const BodyHandle& handle : pendingRemovals) {
+           bodyBatch.push_back(bodySlots[handle.index].body);
        }
+       broadPhase->removeBodies(bodyBatch);
+   }
+   
+   for (const BodyHandle& handle : pendingRemovals) {
+       BodySlot& slot = bodySlots[handle.index];
        
-       rigidBodies.erase(it);
+       // Swap-remove from the dense arrays
+       uint32_t dense = slot.denseIndex;
+       uint32_t last = static_cast<uint32_t>(rigidBodies.size() - 1);
+       rigidBodies[dense] = rigidBodies[last];
+       denseToSlot[dense] = denseToSlot[last];
+       bodySlots[denseToSlot[dense]].denseIndex = dense;
+       rigidBodies.pop_back();
+       denseToSlot.pop_back();
        
-       // Remove any collision pairs involving this body
-       activePairs.erase(
-           std::remove_if(activePairs.begin(), activePairs.end(),
-               [body](const CollisionPair& pair) {
-                   return pair.bodyA == body.get() || pair.bodyB == body.get();
-               }),
-           activePairs.end()
-       );
+       releaseSlot(handle.index);
+   }
+   pendingRemovals.clear();
+}
+
+void PhysicsWorld::releaseSlot(uint32_t slotIndex) {
+   BodySlot& slot = bodySlots[slotIndex];
+   slot.body->handle = BodyHandle{};
+   if (slot.shared) {
+       slot.shared.reset();
+   } else {
+       bodyPool.destroy(slot.body);
    }
+   
+   slot.body = nullptr;
+   slot.pendingRemoval = false;
+   ++slot.generation;
+   slot.nextFree = freeSlot;
+   freeSlot = slotIndex;
 }
 
 void PhysicsWorld::setBroadPhase(std::unique_ptr<BroadPhase> newBroadPhase) {
    if (newBroadPhase) {
        // Transfer all bodies to new broad phase
-       std::vector<RigidBody*> bodiesToTransfer;
-       for (const auto& body : rigidBodies) {
-           bodiesToTransfer.push_back(body.get());
-       }
-       
        broadPhase = std::move(newBroadPhase);
-       
-       for (RigidBody* body : bodiesToTransfer) {
-           broadPhase->insertBody(body);
-       }
+       broadPhase->insertBodies(rigidBodies);
    }
 }
 
@@ -524,14 +787,14 @@ bool PhysicsWorld::raycast(const Ray& ray, RaycastHit& hit) const {
    for (const auto& body : rigidBodies) {
        if (!body->getCollisionShape()) continue;
        
-       Transform transform = getRigidBodyTransform(body.get());
+       Transform transform = getRigidBodyTransform(body);
        RaycastHit tempHit;
        
        if (body->getCollisionShape()->raycast(ray, transform, tempHit)) {
            if (tempHit.distance < closestDistance) {
                closestDistance = tempHit.distance;
                hit = tempHit;
-               hit.body = body.get();
+               hit.body = body;
            }
        }
    }
@@ -545,11 +808,11 @@ std::vector<RaycastHit> PhysicsWorld::raycastAll(const Ray& ray) const {
    for (const auto& body : rigidBodies) {
        if (!body->getCollisionShape()) continue;
        
-       Transform transform = getRigidBodyTransform(body.get());
+       Transform transform = getRigidBodyTransform(body);
        RaycastHit hit;
        
        if (body->getCollisionShape()->raycast(ray, transform, hit)) {
-           hit.body = body.get();
+           hit.body = body;
            hits.push_back(hit);
        }
    }
@@ -564,27 +827,91 @@ std::vector<RaycastHit> PhysicsWorld::raycastAll(const Ray& ray) const {
 }
 
 std::vector<RigidBody*> PhysicsWorld::getOverlappingBodies(const BoundingBox& aabb) const {
+   std::vector<RigidBody*> overlapping;
+   getOverlappingBodies(aabb, [&](RigidBody* body) {
+       overlapping.push_back(body);
+       return true;
+   });
+   return overlapping;
+}
+
+void PhysicsWorld::getOverlappingBodies(const BoundingBox& aabb, BodyVisitor visitor,
+                                        const QueryFilter& filter) const {
+   refreshBroadPhase();
    if (broadPhase) {
-       return broadPhase->queryRegion(aabb.min, aabb.max);
+       broadPhase->queryRegion(aabb.min, aabb.max, visitor, filter);
+       return;
    }
    
    // Fallback: linear search
-   std::vector<RigidBody*> overlapping;
-   for (const auto& body : rigidBodies) {
-       if (!body->getCollisionShape()) continue;
+   for (RigidBody* body : rigidBodies) {
+       if (!body->getCollisionShape() || !filter.accepts(body->getCollisionFilter())) continue;
        
-       Transform transform = getRigidBodyTransform(body.get());
+       Transform transform = getRigidBodyTransform(body);
        BoundingBox bodyAABB = body->getCollisionShape()->getAABB(transform);
        
-       if (aabb.intersects(bodyAABB)) {
-           overlapping.push_back(body.get());
+       if (aabb.intersects(bodyAABB) && !visitor(body)) {
+           return;
        }
    }
+}
+
+size_t PhysicsWorld::getOverlappingBodies(const BoundingBox& aabb, RigidBody** results, size_t capacity,
+                                          const QueryFilter& filter) const {
+   size_t count = 0;
+   if (capacity == 0) return 0;
+   getOverlappingBodies(aabb, [&](RigidBody* body) {
+       results[count++] = body;
+       return count < capacity;
+   }, filter);
+   return count;
+}
+
+void PhysicsWorld::overlapShape(const CollisionShape& shape, const Transform& transform, BodyVisitor visitor,
+                                const QueryFilter& filter) const {
+   // Narrow-phase scratch goes to the frame arena; outside a step borrow the
+   // stepping thread's arena without resetting it
+   std::optional<core::memory::FrameArena::Scope> arenaScope;
+   if (!core::memory::FrameArena::current()) {
+       arenaScope.emplace(frameArenas[0]);
+   }
    
-   return overlapping;
+   const BoundingBox queryAABB = shape.getAABB(transform);
+   ContactManifold manifold;
+   
+   getOverlappingBodies(queryAABB, [&](RigidBody* body) {
+       const CollisionShape* bodyShape = body->getCollisionShape().get();
+       if (!bodyShape) return true;
+       
+       // The detector's verdict is the overlap test; contacts are only scratch
+       manifold.clearContacts();
+       const bool overlapping = CollisionDetector::detectShapes(shape, transform, *bodyShape,
+                                                                getRigidBodyTransform(body), manifold);
+       return !overlapping || visitor(body);
+   }, filter);
+}
+
+size_t PhysicsWorld::overlapShape(const CollisionShape& shape, const Transform& transform,
+                                  RigidBody** results, size_t capacity, const QueryFilter& filter) const {
+   size_t count = 0;
+   if (capacity == 0) return 0;
+   overlapShape(shape, transform, [&](RigidBody* body) {
+       results[count++] = body;
+       return count < capacity;
+   }, filter);
+   return count;
+}
+
+size_t PhysicsWorld::overlapSphere(const glm::vec3& center, float radius, RigidBody** results, size_t capacity,
+                                   const QueryFilter& filter) const {
+   const SphereShape probe(radius);
+   Transform transform;
+   transform.position = center;
+   return overlapShape(probe, transform, results, capacity, filter);
 }
 
 std::vector<RigidBody*> PhysicsWorld::getOverlappingBodies(const glm::vec3& point) const {
+   refreshBroadPhase();
    if (broadPhase) {
        return broadPhase->queryPoint(point);
    }
@@ -594,11 +921,11 @@ std::vector<RigidBody*> PhysicsWorld::getOverlappingBodies(const glm::vec3& poin
    for (const auto& body : rigidBodies) {
        if (!body->getCollisionShape()) continue;
        
-       Transform transform = getRigidBodyTransform(body.get());
+       Transform transform = getRigidBodyTransform(body);
        BoundingBox bodyAABB = body->getCollisionShape()->getAABB(transform);
        
        if (bodyAABB.contains(point)) {
-           overlapping.push_back(body.get());
+           overlapping.push_back(body);
        }
    }
    
@@ -619,6 +946,210 @@ bool PhysicsWorld::checkOverlap(RigidBody* bodyA, RigidBody* bodyB) const {
    return aabbA.intersects(aabbB);
 }
 
+void PhysicsWorld::writeSnapshot(TransformSnapshot& snapshot) const {
+   snapshot.step = stepCount;
+   snapshot.bodies.resize(rigidBodies.size());
+   
+   for (size_t i = 0; i < rigidBodies.size(); ++i) {
+       const RigidBody* body = rigidBodies[i];
+       BodyPose& pose = snapshot.bodies[i];
+       pose.handle = body->getHandle();
+       pose.position = body->getPosition();
+       pose.orientation = body->getOrientation();
+   }
+}
+
+float PhysicsWorld::getInterpolationAlpha() const {
+   // The accumulator can exceed one step when maxSubSteps was hit
+   return glm::clamp(accumulator / fixedTimeStep, 0.0f, 1.0f);
+}
+
+Transform PhysicsWorld::getInterpolatedTransform(const RigidBody* body) const {
+   Transform transform;
+   transform.position = body->getPosition();
+   transform.rotation = body->getOrientation();
+   
+   // Bodies that did not take part in the last step have nothing to blend from
+   if (stepCount == 0 || body->previousPoseStep != stepCount) {
+       return transform;
+   }
+   
+   const float alpha = getInterpolationAlpha();
+   transform.position = glm::mix(body->previousPosition, body->position, alpha);
+   transform.rotation = glm::slerp(body->previousOrientation, body->orientation, alpha);
+   return transform;
+}
+
+void PhysicsWorld::writeInterpolatedSnapshot(TransformSnapshot& snapshot) const {
+   snapshot.step = stepCount;
+   snapshot.bodies.resize(rigidBodies.size());
+   
+   for (size_t i = 0; i < rigidBodies.size(); ++i) {
+       const RigidBody* body = rigidBodies[i];
+       const Transform transform = getInterpolatedTransform(body);
+       BodyPose& pose = snapshot.bodies[i];
+       pose.handle = body->getHandle();
+       pose.position = transform.position;
+       pose.orientation = transform.rotation;
+   }
+}
+
+uint64_t PhysicsWorld::computeStateHash() const {
+   core::StateHasher hasher;
+   hasher.add(stepCount);
+   hasher.add(static_cast<uint64_t>(rigidBodies.size()));
+   
+   for (const RigidBody* body : rigidBodies) {
+       hasher.add(body->handle.index);
+       hasher.add(body->handle.generation);
+       hasher.add(&body->position.x, 3);
+       hasher.add(&body->orientation.x, 4);
+       hasher.add(&body->linearVelocity.x, 3);
+       hasher.add(&body->angularVelocity.x, 3);
+       hasher.add(body->sleeping);
+       hasher.add(body->sleepTime);
+   }
+   return hasher.get();
+}
+
+void PhysicsWorld::saveSnapshot(std::vector<uint8_t>& buffer) const {
+   static_assert(std::is_standard_layout_v<RigidBody>, "body state is located with offsetof");
+   
+   const size_t bodyBytes = rigidBodies.size() * sizeof(BodySnapshot);
+   const size_t pairBytes = activePairs.size() * 2 * sizeof(BodyHandle);
+   buffer.resize(sizeof(SnapshotHeader) + bodyBytes + pairBytes);
+   uint8_t* out = buffer.data();
+   
+   SnapshotHeader header{};
+   header.magic = SnapshotHeader::Magic;
+   header.version = SnapshotHeader::Version;
+   header.stepCount = stepCount;
+   header.lastStateHash = lastStateHash;
+   header.accumulator = accumulator;
+   header.bodyCount = static_cast<uint32_t>(rigidBodies.size());
+   header.pairCount = static_cast<uint32_t>(activePairs.size());
+   std::memcpy(out, &header, sizeof(header));
+   out += sizeof(header);
+   
+   // Written bytewise so the buffer needs no alignment
+   for (const RigidBody* body : rigidBodies) {
+       const auto* state = reinterpret_cast<const unsigned char*>(body) + BodySnapshot::StateOffset;
+       std::memcpy(out + offsetof(BodySnapshot, handle), &body->handle, sizeof(BodyHandle));
+       std::memcpy(out + offsetof(BodySnapshot, state), state, BodySnapshot::StateBytes);
+       out += sizeof(BodySnapshot);
+   }
+   
+   for (const CollisionPair& pair : activePairs) {
+       const BodyHandle handles[2] = {pair.bodyA->handle, pair.bodyB->handle};
+       std::memcpy(out, handles, sizeof(handles));
+       out += sizeof(handles);
+   }
+}
+
+bool PhysicsWorld::restoreSnapshot(const std::vector<uint8_t>& buffer) {
+   SnapshotHeader header;
+   if (buffer.size() < sizeof(header)) return false;
+   std::memcpy(&header, buffer.data(), sizeof(header));
+   
+   if (header.magic != SnapshotHeader::Magic || header.version != SnapshotHeader::Version ||
+       header.bodyCount != rigidBodies.size() ||
+       buffer.size() != sizeof(header) + header.bodyCount * sizeof(BodySnapshot) +
+                        header.pairCount * 2 * sizeof(BodyHandle)) {
+       return false;
+   }
+   
+   const uint8_t* bodyData = buffer.data() + sizeof(header);
+   const uint8_t* pairData = bodyData + header.bodyCount * sizeof(BodySnapshot);
+   
+   // Check the body set before touching anything so a mismatch leaves the
+   // world as it was; the slot table answers without visiting the bodies
+   for (size_t i = 0; i < denseToSlot.size(); ++i) {
+       BodyHandle handle;
+       std::memcpy(&handle, bodyData + i * sizeof(BodySnapshot) + offsetof(BodySnapshot, handle), sizeof(handle));
+       if (denseToSlot[i] != handle.index || bodySlots[handle.index].generation != handle.generation) {
+           return false;
+       }
+   }
+   
+   // Pairs resolve into the broad-phase scratch list, which is free between steps
+   newPairs.clear();
+   for (uint32_t i = 0; i < header.pairCount; ++i) {
+       BodyHandle handles[2];
+       std::memcpy(handles, pairData + i * sizeof(handles), sizeof(handles));
+       RigidBody* bodyA = getRigidBody(handles[0]);
+       RigidBody* bodyB = getRigidBody(handles[1]);
+       if (!bodyA || !bodyB) {
+           newPairs.clear();
+           return false;
+       }
+       newPairs.emplace_back(bodyA, bodyB);
+       // Keep the saved order, which is handle order in deterministic mode
+       newPairs.back().bodyA = bodyA;
+       newPairs.back().bodyB = bodyB;
+   }
+   
+   for (RigidBody* body : rigidBodies) {
+       auto* state = reinterpret_cast<unsigned char*>(body) + BodySnapshot::StateOffset;
+       std::memcpy(state, bodyData + offsetof(BodySnapshot, state), BodySnapshot::StateBytes);
+       bodyData += sizeof(BodySnapshot);
+   }
+   
+   activePairs.swap(newPairs);
+   newPairs.clear();
+   
+   stepCount = header.stepCount;
+   lastStateHash = header.lastStateHash;
+   accumulator = header.accumulator;
+   contactManifolds.clear();
+   pairHints.clear();
+   broadPhaseStale = true;
+   return true;
+}
+
+void PhysicsWorld::getSlotOrder(std::vector<BodyHandle>& order) const {
+   order.clear();
+   order.reserve(bodySlots.size());
+   for (uint32_t slotIndex : denseToSlot) {
+       order.push_back(BodyHandle{slotIndex, bodySlots[slotIndex].generation});
+   }
+   for (uint32_t slotIndex = freeSlot; slotIndex != BodyHandle::InvalidIndex;
+        slotIndex = bodySlots[slotIndex].nextFree) {
+       order.push_back(BodyHandle{slotIndex, bodySlots[slotIndex].generation});
+   }
+}
+
+bool PhysicsWorld::restoreSlotOrder(const std::vector<BodyHandle>& order) {
+   if (!rigidBodies.empty() || !pendingRemovals.empty()) {
+       return false;
+   }
+   
+   std::vector<uint8_t> seen(order.size(), 0);
+   for (const BodyHandle& handle : order) {
+       if (handle.index >= order.size() || seen[handle.index]) {
+           return false;
+       }
+       seen[handle.index] = 1;
+   }
+   
+   // Every slot is free, chained in the saved order
+   bodySlots.assign(order.size(), BodySlot{});
+   freeSlot = BodyHandle::InvalidIndex;
+   for (size_t i = order.size(); i-- > 0;) {
+       BodySlot& slot = bodySlots[order[i].index];
+       slot.generation = order[i].generation;
+       slot.nextFree = freeSlot;
+       freeSlot = order[i].index;
+   }
+   return true;
+}
+
+void PhysicsWorld::refreshBroadPhase() const {
+   if (broadPhaseStale && broadPhase) {
+       broadPhase->updateAllBodies();
+   }
+   broadPhaseStale = false;
+}
+
 int PhysicsWorld::getContactCount() const {
    int totalContacts = 0;
    for (const auto& manifold : contactManifolds) {
@@ -640,6 +1171,8 @@ std::string PhysicsWorld::getDebugInfo() const {
    oss << "    Broad Phase: " << perfStats.broadPhaseTime << " ms\n";
    oss << "    Narrow Phase: " << perfStats.narrowPhaseTime << " ms\n";
    oss << "    Solver: " << perfStats.solverTime << " ms\n";
+   oss << "    Frame Arena: " << (perfStats.frameArenaBytes / 1024) << " KB used, "
+       << perfStats.frameArenaOverflows << " overflows\n";
    
    if (broadPhase) {
        oss << "  Broad Phase Info:\n";
@@ -654,24 +1187,82 @@ void PhysicsWorld::broadPhaseCollision() {
    
    // Update broad phase with current body positions
    broadPhase->updateAllBodies();
+   broadPhaseStale = false;
    
    // Find potential collision pairs
-   newPairs = broadPhase->findPotentialCollisions();
+   broadPhase->findPotentialCollisions(newPairs);
    perfStats.pairsProcessed = newPairs.size();
+   
+   if (deterministic) {
+       // Pairs come out in address order; handles are the same on every run,
+       // so key the narrow phase, solver and events on them instead
+       for (CollisionPair& pair : newPairs) {
+           if (pair.bodyA->handle.index > pair.bodyB->handle.index) {
+               std::swap(pair.bodyA, pair.bodyB);
+           }
+       }
+       std::sort(newPairs.begin(), newPairs.end(), [](const CollisionPair& a, const CollisionPair& b) {
+           if (a.bodyA->handle.index != b.bodyA->handle.index) {
+               return a.bodyA->handle.index < b.bodyA->handle.index;
+           }
+           return a.bodyB->handle.index < b.bodyB->handle.index;
+       });
+   }
 }
 
 void PhysicsWorld::narrowPhaseCollision() {
+   // At most one manifold per pair, so after this the loop never reallocates;
+   // clear() keeps the capacity, so a steady scene allocates nothing here
    contactManifolds.clear();
    contactManifolds.reserve(newPairs.size());
+   nextPairHints.clear();
+   nextPairHints.reserve(newPairs.size());
    
    for (const auto& pair : newPairs) {
-       ContactManifold manifold;
-       if (CollisionDetector::detectCollision(pair.bodyA, pair.bodyB, manifold)) {
-           if (manifold.hasContacts()) {
-               contactManifolds.push_back(manifold);
+       // On LOD steps only pairs with a scheduled body are tested; the other
+       // body of a touching pair then steps too (one hop, so the order of
+       // pairs does not matter)
+       if (!lodDue.empty() && !isLodScheduled(pair.bodyA) && !isLodScheduled(pair.bodyB)) {
+           continue;
+       }
+       // Detect straight into the next slot; a miss gives it back
+       ContactManifold& manifold = contactManifolds.emplace_back();
+       // Support hints can settle a tie on a different vertex, which a
+       // restored snapshot would not reproduce, so deterministic worlds skip them
+       const uint64_t key = (static_cast<uint64_t>(pair.bodyA->handle.index) << 32) | pair.bodyB->handle.index;
+       if (!deterministic) {
+           auto cached = std::lower_bound(pairHints.begin(), pairHints.end(), key,
+                                          [](const PairHints& entry, uint64_t k) { return entry.key < k; });
+           if (cached != pairHints.end() && cached->key == key) {
+               manifold.getSupportHints() = cached->hints;
+           }
+       }
+       const bool touching = CollisionDetector::detectCollision(pair.bodyA, pair.bodyB, manifold)
+                             && manifold.hasContacts();
+       
+       // Hints are kept through near misses too; hulls hovering apart still search
+       const SupportHints& hints = manifold.getSupportHints();
+       if (!deterministic && (hints.vertex[0] | hints.vertex[1] | hints.vertex[2] | hints.vertex[3])) {
+           nextPairHints.push_back(PairHints{key, hints});
+       }
+       if (!touching) {
+           contactManifolds.pop_back();
+           continue;
+       }
+       if (!lodDue.empty()) {
+           for (const RigidBody* body : {pair.bodyA, pair.bodyB}) {
+               uint8_t& due = lodDue[body->handle.index];
+               if (!due && body->getBodyType() == RigidBody::BodyType::Dynamic) {
+                   due = 2;
+               }
            }
        }
    }
+   
+   // Pairs arrive in pointer or handle order; key order is what the lookup needs
+   std::sort(nextPairHints.begin(), nextPairHints.end(),
+             [](const PairHints& a, const PairHints& b) { return a.key < b.key; });
+   pairHints.swap(nextPairHints);
 }
 
 void PhysicsWorld::resolveCollisions() {
@@ -740,14 +1331,137 @@ void PhysicsWorld::integrateForces(float dt) {
    }
 }
 
+void PhysicsWorld::storePreviousPoses() {
+   const uint64_t step = stepCount + 1;
+   for (RigidBody* body : rigidBodies) {
+       if (body->getBodyType() == RigidBody::BodyType::Static) continue;
+       body->previousPosition = body->position;
+       body->previousOrientation = body->orientation;
+       body->previousPoseStep = step;
+   }
+}
+
 void PhysicsWorld::integrateBodies(float dt) {
+   integrationBatch.clear();
    for (auto& body : rigidBodies) {
        if (body->getBodyType() == RigidBody::BodyType::Dynamic && !body->isSleeping()) {
-           body->integrate(dt);
-           
-           // Update broad phase
-           if (broadPhase) {
-               broadPhase->updateBody(body.get());
+           integrationBatch.push_back(body);
+       }
+   }
+   
+   batchIntegrator.integrate(integrationBatch, dt);
+   perfStats.bodiesStepped = integrationBatch.size();
+   
+   // Update broad phase
+   if (broadPhase) {
+       for (RigidBody* body : integrationBatch) {
+           broadPhase->updateBody(body);
+       }
+   }
+}
+
+bool PhysicsWorld::scheduleLodStep(uint64_t step) {
+   if (!lod.enabled || observers.empty()) {
+       if (!lodDue.empty()) {
+           // Back to full rate: drop the tiers so stats and a later restart agree
+           for (RigidBody* body : rigidBodies) {
+               body->updateTier = 0;
+           }
+           lodDue.clear();
+       }
+       return false;
+   }
+   
+   // 1 = scheduled by tier and phase, 2 = pulled in by a contact. Static and
+   // kinematic bodies are never scheduled, so they do not keep far pairs alive.
+   lodDue.assign(bodySlots.size(), 0);
+   for (const RigidBody* body : rigidBodies) {
+       if (body->getBodyType() != RigidBody::BodyType::Dynamic) continue;
+       const uint64_t stride = uint64_t(1) << body->updateTier;
+       const bool onPhase = ((step + body->updatePhase) & (stride - 1)) == 0;
+       // Catches up bodies whose phase just changed or that are new
+       if (onPhase || step - body->lastUpdateStep >= stride) {
+           lodDue[body->handle.index] = 1;
+       }
+   }
+   return true;
+}
+
+bool PhysicsWorld::isLodScheduled(const RigidBody* body) const {
+   return body->handle.index < lodDue.size() && lodDue[body->handle.index] == 1;
+}
+
+uint8_t PhysicsWorld::lodTierAt(const glm::vec3& position) const {
+   float nearest = FLT_MAX;
+   for (const glm::vec3& observer : observers) {
+       const glm::vec3 offset = position - observer;
+       nearest = std::min(nearest, glm::dot(offset, offset));
+   }
+   if (nearest > lod.quarterRateDistance * lod.quarterRateDistance) return 2;
+   if (nearest > lod.halfRateDistance * lod.halfRateDistance) return 1;
+   return 0;
+}
+
+void PhysicsWorld::prepareLodBodies(uint64_t step) {
+   constexpr uint64_t maxStride = uint64_t(1) << MaxUpdateTier;
+   for (auto& batch : strideBatches) {
+       batch.clear();
+   }
+   
+   for (RigidBody* body : rigidBodies) {
+       const uint32_t index = body->handle.index;
+       if (body->getBodyType() != RigidBody::BodyType::Dynamic || index >= lodDue.size() || !lodDue[index]) {
+           continue;
+       }
+       
+       // A body covers every step since it last moved, up to its stride.
+       // Forces applied in between were meant per step, so average them.
+       const uint64_t stride = uint64_t(1) << body->updateTier;
+       const uint64_t elapsed = std::clamp<uint64_t>(step - body->lastUpdateStep, 1, stride);
+       const bool retier = ((step + body->updatePhase) & (maxStride - 1)) == 0;
+       body->lastUpdateStep = step;
+       
+       if (retier) {
+           const glm::vec3 cell = glm::floor(body->position / lod.groupCellSize);
+           uint32_t hash = static_cast<uint32_t>(static_cast<int32_t>(cell.x)) * 73856093u ^
+                           static_cast<uint32_t>(static_cast<int32_t>(cell.y)) * 19349663u ^
+                           static_cast<uint32_t>(static_cast<int32_t>(cell.z)) * 83492791u;
+           hash ^= hash >> 16;
+           // Fast bodies keep a finer rate, so one long step cannot carry
+           // them deep into whatever they hit
+           uint8_t tier = lodTierAt(body->position);
+           const float travel = glm::length(body->linearVelocity) * fixedTimeStep;
+           while (tier > 0 && travel * static_cast<float>(1u << tier) > lod.maxStrideTravel) {
+               --tier;
+           }
+           body->updateTier = tier;
+           body->updatePhase = static_cast<uint8_t>(hash & (maxStride - 1));
+       }
+       
+       if (body->isSleeping()) continue;
+       if (elapsed > 1) {
+           // Gravity for the whole stride goes in before the solver, which
+           // runs once for all of it and can then hold the body up
+           body->force /= static_cast<float>(elapsed);
+           body->torque /= static_cast<float>(elapsed);
+           body->linearVelocity += gravity * (fixedTimeStep * static_cast<float>(elapsed));
+       } else {
+           body->applyForce(gravity * body->getMass());
+       }
+       strideBatches[elapsed - 1].push_back(body);
+   }
+}
+
+void PhysicsWorld::integrateLodBodies() {
+   constexpr uint64_t maxStride = uint64_t(1) << MaxUpdateTier;
+   perfStats.bodiesStepped = 0;
+   for (uint64_t i = 0; i < maxStride; ++i) {
+       if (strideBatches[i].empty()) continue;
+       batchIntegrator.integrate(strideBatches[i], fixedTimeStep * static_cast<float>(i + 1));
+       perfStats.bodiesStepped += strideBatches[i].size();
+       if (broadPhase) {
+           for (RigidBody* body : strideBatches[i]) {
+               broadPhase->updateBody(body);
            }
        }
    }
@@ -755,14 +1469,28 @@ void PhysicsWorld::integrateBodies(float dt) {
 
 void PhysicsWorld::updateCollisionEvents() {
    // Convert manifolds to pairs for event processing
-   std::vector<CollisionPair> currentPairs;
+   core::memory::FrameVector<CollisionPair> currentPairs;
+   currentPairs.reserve(contactManifolds.size());
    for (const auto& manifold : contactManifolds) {
        currentPairs.emplace_back(manifold.getBodyA(), manifold.getBodyB());
+       if (deterministic) {
+           // Keep the handle order rather than CollisionPair's address order,
+           // so callbacks see the same bodyA/bodyB on every run
+           currentPairs.back().bodyA = manifold.getBodyA();
+           currentPairs.back().bodyB = manifold.getBodyB();
+       }
    }
    
+   // Pairs skipped by an LOD step were not tested, so they have not ended
+   core::memory::FrameVector<CollisionPair> untestedPairs;
+   
    // Find exiting collisions
    for (const auto& pair : activePairs) {
        if (std::find(currentPairs.begin(), currentPairs.end(), pair) == currentPairs.end()) {
+           if (!lodDue.empty() && !isLodScheduled(pair.bodyA) && !isLodScheduled(pair.bodyB)) {
+               untestedPairs.push_back(pair);
+               continue;
+           }
            // Collision ended
            if (onCollisionExit) {
                onCollisionExit(pair.bodyA, pair.bodyB);
@@ -788,7 +1516,8 @@ void PhysicsWorld::updateCollisionEvents() {
        }
    }
    
-   activePairs = currentPairs;
+   activePairs.assign(currentPairs.begin(), currentPairs.end());
+   activePairs.insert(activePairs.end(), untestedPairs.begin(), untestedPairs.end());
 }
 
 Transform PhysicsWorld::getRigidBodyTransform(RigidBody* body) const {
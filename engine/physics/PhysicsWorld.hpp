@@ -123,11 +123,15 @@
 #pragma once
 
 #include "RigidBody.hpp"
+#include "BodyHandle.hpp"
+#include "BatchIntegrator.hpp"
 #include "collision/BroadPhase.hpp"
 #include "collision/ContactManifold.hpp"
 #include "collision/CollisionDetector.hpp"
 #include "collision/SpatialHashBroadPhase.hpp"
 #include "../core/Time.hpp"
+#include "../core/FrameArena.hpp"
+#include "../core/ObjectPool.hpp"
 #include <vector>
 #include <memory>
 #include <functional>
@@ -139,17 +143,52 @@ namespace engine::physics {
  */
 class PhysicsWorld {
 public:
+    // Up-front sizing; small values suit many small worlds (see WorldBatch),
+    // everything still grows on demand
+    struct Settings {
+        size_t expectedBodies = 1000;
+        size_t frameArenaBytes = 256 * 1024;
+        float broadPhaseCellSize = 5.0f;
+    };
+    
     PhysicsWorld();
+    explicit PhysicsWorld(const Settings& settings);
     ~PhysicsWorld();
 
     // World management
     void update(float dt);
     void clear();
 
-    // Body management
-    void addRigidBody(std::shared_ptr<RigidBody> body);
-    void removeRigidBody(std::shared_ptr<RigidBody> body);
-    const std::vector<std::shared_ptr<RigidBody>>& getRigidBodies() const { return rigidBodies; }
+    // Body management. Bodies made by createRigidBody live in a pool owned by
+    // the world; shared bodies are kept alive until they are removed.
+    BodyHandle createRigidBody(RigidBody::BodyType type = RigidBody::BodyType::Dynamic, float mass = 1.0f);
+    BodyHandle addRigidBody(std::shared_ptr<RigidBody> body);
+    
+    // Bulk variants for level loads and mass spawns: slots are filled first
+    // and the broad phase is updated once for the whole batch. setup runs on
+    // each new body before insertion so the broad phase sees its final AABB.
+    using BodySetup = std::function<void(RigidBody& body, size_t index)>;
+    std::vector<BodyHandle> createRigidBodies(size_t count, const BodySetup& setup,
+                                              RigidBody::BodyType type = RigidBody::BodyType::Dynamic,
+                                              float mass = 1.0f);
+    std::vector<BodyHandle> addRigidBodies(const std::vector<std::shared_ptr<RigidBody>>& bodies);
+    
+    // Removal is deferred: the handle stops resolving at once, and the body
+    // leaves the simulation in one batch at the next flush. This includes
+    // removeRigidBody(shared_ptr), which used to erase at once: until the
+    // flush the world still holds its reference and getRigidBodies() still
+    // lists it. Adding the body again before the flush cancels the removal
+    // and returns its existing handle.
+    void removeRigidBody(BodyHandle handle);
+    void removeRigidBody(const std::shared_ptr<RigidBody>& body);
+    void removeRigidBodies(const std::vector<BodyHandle>& handles);
+    void flushRemovals();   // Called by update() before and after stepping
+    
+    RigidBody* getRigidBody(BodyHandle handle) const;
+    bool isValid(BodyHandle handle) const;
+    
+    // Dense body list; order changes when bodies are removed
+    const std::vector<RigidBody*>& getRigidBodies() const { return rigidBodies; }
 
     // Global physics properties
     void setGravity(const glm::vec3& gravity) { this->gravity = gravity; }
@@ -176,9 +215,23 @@ public:
     bool raycast(const Ray& ray, RaycastHit& hit) const;
     std::vector<RaycastHit> raycastAll(const Ray& ray) const;
     
-    // Overlap queries
+    // Overlap queries. The visitor and buffer forms never allocate; buffer
+    // forms return how many bodies were written, at most capacity.
+    using BodyVisitor = BroadPhase::BodyVisitor;
     std::vector<RigidBody*> getOverlappingBodies(const BoundingBox& aabb) const;
     std::vector<RigidBody*> getOverlappingBodies(const glm::vec3& point) const;
+    void getOverlappingBodies(const BoundingBox& aabb, BodyVisitor visitor,
+                              const QueryFilter& filter = QueryFilter{}) const;
+    size_t getOverlappingBodies(const BoundingBox& aabb, RigidBody** results, size_t capacity,
+                                const QueryFilter& filter = QueryFilter{}) const;
+    
+    // Exact shape overlap: broad-phase candidates confirmed by the narrow phase
+    void overlapShape(const CollisionShape& shape, const Transform& transform, BodyVisitor visitor,
+                      const QueryFilter& filter = QueryFilter{}) const;
+    size_t overlapShape(const CollisionShape& shape, const Transform& transform,
+                        RigidBody** results, size_t capacity, const QueryFilter& filter = QueryFilter{}) const;
+    size_t overlapSphere(const glm::vec3& center, float radius, RigidBody** results, size_t capacity,
+                         const QueryFilter& filter = QueryFilter{}) const;
     bool checkOverlap(RigidBody* bodyA, RigidBody* bodyB) const;
 
     // Debug information
@@ -188,17 +241,106 @@ public:
     
     // Performance statistics
     struct PerformanceStats {
-        float broadPhaseTime = 0.0f;
+        float broadPhaseTime = 0.0f;     // Phase times add up over the update's sub-steps
         float narrowPhaseTime = 0.0f;
         float solverTime = 0.0f;
         float totalTime = 0.0f;
+        int subSteps = 0;                // Fixed steps taken by the last update
+        int stepsBehind = 0;             // Steps still owed when maxSubSteps cut the update short
         size_t pairsProcessed = 0;
         size_t contactsGenerated = 0;
         size_t bodiesActive = 0;
         size_t bodiesSleeping = 0;
+        size_t frameArenaBytes = 0;      // Scratch used by the last update
+        size_t frameArenaOverflows = 0;  // Heap fallbacks; zero once the arena has grown to fit
+        size_t bodiesStepped = 0;        // Dynamic bodies integrated by the last step
+        size_t bodiesPerTier[3] = {};    // Dynamic bodies at full, half and quarter rate
     };
     
     const PerformanceStats& getPerformanceStats() const { return perfStats; }
+    
+    // Fixed steps taken since construction
+    uint64_t getStepCount() const { return stepCount; }
+    
+    // Deterministic mode orders collision pairs by body handle instead of
+    // broad-phase hash order, so two worlds built by the same sequence of
+    // calls step bit-identically on any machine (given the same compiler
+    // floating-point settings). It also hashes the state after every step.
+    void setDeterministic(bool enabled) { deterministic = enabled; }
+    bool isDeterministic() const { return deterministic; }
+    
+    // 64-bit hash of the step count and every body's handle, pose, velocities
+    // and sleep state, in dense order
+    uint64_t computeStateHash() const;
+    
+    // Hash after the last fixed step; only kept up to date in deterministic mode
+    uint64_t getLastStateHash() const { return lastStateHash; }
+    
+    // Distance LOD: dynamic bodies far from every observer step every second
+    // or fourth fixed step, with dt scaled to match, so far-away crowds cost
+    // a fraction of nearby ones. Bodies in the same groupCellSize cell share
+    // a phase and step together, which keeps piles coherent, while different
+    // cells spread their steps evenly over frames. Tiers are reassigned on
+    // each body's own quarter-rate step, and a body fast enough to move more
+    // than maxStrideTravel in one long step keeps a finer tier. A body in
+    // contact with one that steps is stepped along with it. Off, or with no
+    // observers, every body steps every time.
+    struct LodSettings {
+        bool enabled = false;
+        float halfRateDistance = 50.0f;
+        float quarterRateDistance = 100.0f;
+        float groupCellSize = 16.0f;
+        float maxStrideTravel = 0.1f;
+    };
+    
+    void setLodSettings(const LodSettings& settings) { lod = settings; }
+    const LodSettings& getLodSettings() const { return lod; }
+    void setObservers(const std::vector<glm::vec3>& positions) { observers = positions; }
+    const std::vector<glm::vec3>& getObservers() const { return observers; }
+    
+    // Rollback: saveSnapshot writes the simulation state (step count,
+    // accumulator, per-body motion and sleep state, active collision pairs)
+    // as flat records into buffer, reusing its capacity. restoreSnapshot puts
+    // it back and the broad phase resyncs on the next query or step. Body
+    // configuration (shape, mass, damping, filter) is not captured, and bodies
+    // are not created or destroyed: restore fails and changes nothing unless
+    // the world holds the same bodies, in the same dense order, as at save.
+    void saveSnapshot(std::vector<uint8_t>& buffer) const;
+    bool restoreSnapshot(const std::vector<uint8_t>& buffer);
+    
+    // Replays: getSlotOrder lists every slot as the handle it hands out next,
+    // live bodies first in dense order, then the free list. restoreSlotOrder
+    // loads that into a world with no bodies, so bodies created next in the
+    // same order get the saved handles and later spawns reuse slots as the
+    // saved world would. Fails and changes nothing if bodies exist or the
+    // list is not a permutation of slots.
+    void getSlotOrder(std::vector<BodyHandle>& order) const;
+    bool restoreSlotOrder(const std::vector<BodyHandle>& order);
+    
+    // Body poses after a step, for consumers on another thread (see PhysicsThread)
+    struct BodyPose {
+        BodyHandle handle;
+        glm::vec3 position{0.0f};
+        glm::quat orientation{1.0f, 0.0f, 0.0f, 0.0f};
+    };
+    
+    struct TransformSnapshot {
+        uint64_t step = 0;
+        std::vector<BodyPose> bodies;
+    };
+    
+    // Overwrites snapshot, reusing its storage
+    void writeSnapshot(TransformSnapshot& snapshot) const;
+    
+    // Render interpolation between the last two fixed steps. Alpha is the
+    // fraction of a step left in the accumulator; rendering at it trails the
+    // simulation by under one step but moves smoothly at any frame rate.
+    float getInterpolationAlpha() const;
+    Transform getInterpolatedTransform(const RigidBody* body) const;
+    void writeInterpolatedSnapshot(TransformSnapshot& snapshot) const;
+    
+    // Per-thread scratch arenas, reset at the start of every update
+    const core::memory::FrameArenaSet& getFrameArenas() const { return frameArenas; }
 
     // Events
     std::function<void(RigidBody*, RigidBody*, const ContactManifold&)> onCollisionEnter;
@@ -206,15 +348,57 @@ public:
     std::function<void(RigidBody*, RigidBody*)> onCollisionExit;
 
 private:
+    // Slot table behind BodyHandles; bumping the generation on removal
+    // invalidates outstanding handles
+    struct BodySlot {
+        RigidBody* body = nullptr;
+        std::shared_ptr<RigidBody> shared;     // Empty for pooled bodies
+        uint32_t generation = 0;
+        uint32_t denseIndex = 0;
+        uint32_t nextFree = BodyHandle::InvalidIndex;
+        bool pendingRemoval = false;
+    };
+    
     // Physics state
-    std::vector<std::shared_ptr<RigidBody>> rigidBodies;
+    std::vector<RigidBody*> rigidBodies;          // Dense, swap-removed
+    std::vector<uint32_t> denseToSlot;            // Parallel to rigidBodies
+    std::vector<BodySlot> bodySlots;
+    uint32_t freeSlot = BodyHandle::InvalidIndex;
+    std::vector<BodyHandle> pendingRemovals;
+    std::vector<RigidBody*> bodyBatch;            // Scratch for batched broad-phase updates
+    core::memory::ObjectPool<RigidBody> bodyPool;
+    
     std::vector<ContactManifold> contactManifolds;
     std::vector<CollisionPair> activePairs;
     std::vector<CollisionPair> newPairs;
     
+    // Hull support hints by pair (handle indices), sorted by key; only pairs
+    // with a non-zero hint are kept, and last step's list is rebuilt into next
+    struct PairHints {
+        uint64_t key;
+        SupportHints hints;
+    };
+    std::vector<PairHints> pairHints;
+    std::vector<PairHints> nextPairHints;
+    
     // Collision detection
     std::unique_ptr<BroadPhase> broadPhase;
     
+    // Integration
+    BatchIntegrator batchIntegrator;
+    std::vector<RigidBody*> integrationBatch;
+    
+    // Distance LOD
+    static constexpr uint8_t MaxUpdateTier = 2;
+    LodSettings lod;
+    std::vector<glm::vec3> observers;
+    std::vector<uint8_t> lodDue;                  // By slot index; empty on full-rate steps
+    std::vector<RigidBody*> strideBatches[1 << MaxUpdateTier];
+    
+    // Transient per-step allocations; index 0 is the stepping thread.
+    // Mutable so const queries can borrow it for narrow-phase scratch.
+    mutable core::memory::FrameArenaSet frameArenas;
+    
     // Physics parameters
     glm::vec3 gravity{0.0f, -9.81f, 0.0f};
     float fixedTimeStep = 1.0f / 60.0f;
@@ -222,6 +406,12 @@ private:
     int velocityIterations = 8;
     int positionIterations = 3;
     float accumulator = 0.0f;
+    uint64_t stepCount = 0;
+    bool deterministic = false;
+    uint64_t lastStateHash = 0;
+    
+    // Set by restoreSnapshot; queries and the next step resync the broad phase
+    mutable bool broadPhaseStale = false;
     
     // Performance tracking
     PerformanceStats perfStats;
@@ -232,8 +422,24 @@ private:
     void resolveCollisions();
     void integrateForces(float dt);
     void integrateBodies(float dt);
+    bool scheduleLodStep(uint64_t step);
+    void prepareLodBodies(uint64_t step);
+    void integrateLodBodies();
+    uint8_t lodTierAt(const glm::vec3& position) const;
+    bool isLodScheduled(const RigidBody* body) const;
+    void storePreviousPoses();
     void updateCollisionEvents();
     
+    // Body slots
+    BodyHandle findRegistered(RigidBody* body);
+    BodyHandle registerBody(RigidBody* body, std::shared_ptr<RigidBody> shared);
+    void releaseSlot(uint32_t slotIndex);
+    
+    // Snapshot records
+    struct SnapshotHeader;
+    struct BodySnapshot;
+    void refreshBroadPhase() const;
+    
     // Utility
     Transform getRigidBodyTransform(RigidBody* body) const;
     bool pairExists(const CollisionPair& pair, const std::vector<CollisionPair>& pairs) const;
@@ -1,4 +1,8 @@
 #include "engine/physics/PhysicsWorld3D.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <unordered_set>
 
 namespace engine::physics {
 
@@ -10,15 +14,178 @@ void PhysicsWorld3D::setGravity(const glm::vec3& g) {
     gravity = g;
 }
 
+void PhysicsWorld3D::addRigidBody(std::shared_ptr<RigidBody> body) {
+    rigidBodies.push_back(body);
+}
+
+void PhysicsWorld3D::removeRigidBody(std::shared_ptr<RigidBody> body) {
+    auto it = std::find(rigidBodies.begin(), rigidBodies.end(), body);
+    if (it != rigidBodies.end()) {
+        rigidBodies.erase(it);
+    }
+}
+
 void PhysicsWorld3D::update(float dt, int solverIterations_) {
     solverIterations = solverIterations_;
 
-    // Now simply use the base class update
-    VertletSystem3D::update(dt, gravity, solverIterations);
+    if (lod.enabled && !observers.empty()) {
+        updateLod(dt);
+    } else {
+        // Now simply use the base class update
+        VertletSystem3D::update(dt, gravity, solverIterations);
+        lodStats = LodStats{};
+        lodStats.clothsPerTier[0] = cloths.size();
+        lodStats.particlesStepped = getParticles().size();
+    }
+
+    updateRigidBodies(dt);
+    stepCount++;
+}
+
+void PhysicsWorld3D::updateRigidBodies(float dt) {
+    for (auto& body : rigidBodies) {
+        if (body->getBodyType() == RigidBody::BodyType::Dynamic) {
+            body->applyForce(gravity * body->getMass());
+            body->integrate(dt);
+        }
+    }
+}
+
+void PhysicsWorld3D::updateLod(float dt) {
+    refreshLooseLists();
+    lodStats = LodStats{};
+
+    // Everything outside a cloth, and every constraint, steps at full rate
+    step(looseParticles, looseSprings, getConstraints(), dt, gravity, solverIterations, 0.98f);
+    lodStats.particlesStepped = looseParticles.size();
+
+    static const std::vector<std::shared_ptr<Constraint3D>> noConstraints;
+    for (size_t i = 0; i < cloths.size(); ++i) {
+        ClothSolver3D& cloth = *cloths[i];
+        ClothLod& state = clothLods[i];
+
+        // Offsetting by the cloth index makes cloths take turns
+        const uint64_t phase = stepCount + i;
+        if ((phase & 3) == 0) {
+            state.tier = clothTier(cloth);
+        }
+        lodStats.clothsPerTier[state.tier]++;
+        if (state.tier == FrozenTier) {
+            // Nothing integrates them, so they would pile up until it thaws
+            for (const auto& particle : cloth.getParticles()) {
+                particle->clearForce();
+            }
+            state.pendingSteps = 0;
+            continue;
+        }
+
+        // Skipped updates leave their forces accumulated; one step of
+        // dt * stride takes in their average
+        ++state.pendingSteps;
+        const uint8_t stride = static_cast<uint8_t>(1u << state.tier);
+        if ((phase & (stride - 1)) != 0) continue;
+
+        if (state.pendingSteps > 1) {
+            const float average = 1.0f / static_cast<float>(state.pendingSteps);
+            for (const auto& particle : cloth.getParticles()) {
+                particle->scaleForce(average);
+            }
+        }
+        state.pendingSteps = 0;
+
+        // Verlet velocity is the last displacement; stretch it to the new step length
+        if (stride != state.lastStride) {
+            const float scale = static_cast<float>(stride) / static_cast<float>(state.lastStride);
+            for (const auto& particle : cloth.getParticles()) {
+                const glm::vec3& position = particle->getPosition();
+                particle->setPreviousPosition(position - (position - particle->getPreviousPosition()) * scale);
+            }
+            state.lastStride = stride;
+        }
+
+        // Iterations stay as they are: springs are relaxed per iteration, not
+        // per second, and fewer of them let a longer step stretch the cloth
+        step(cloth.getParticles(), cloth.getSprings(), noConstraints, dt * stride, gravity,
+             solverIterations, std::pow(0.98f, static_cast<float>(stride)));
+        lodStats.particlesStepped += cloth.getParticles().size();
+    }
+}
+
+void PhysicsWorld3D::refreshLooseLists() {
+    // Nothing is ever unregistered, so unchanged counts mean unchanged lists
+    const auto& particles = getParticles();
+    const auto& springs = getSprings();
+    if (particles.size() == looseParticleSource && springs.size() == looseSpringSource) {
+        return;
+    }
+
+    std::unordered_set<const Particle3D*> clothParticles;
+    std::unordered_set<const Spring3D*> clothSprings;
+    for (const auto& cloth : cloths) {
+        for (const auto& particle : cloth->getParticles()) clothParticles.insert(particle.get());
+        for (const auto& spring : cloth->getSprings()) clothSprings.insert(spring.get());
+    }
+
+    looseParticles.clear();
+    for (const auto& particle : particles) {
+        if (!clothParticles.count(particle.get())) looseParticles.push_back(particle);
+    }
+    looseSprings.clear();
+    for (const auto& spring : springs) {
+        if (!clothSprings.count(spring.get())) looseSprings.push_back(spring);
+    }
+    looseParticleSource = particles.size();
+    looseSpringSource = springs.size();
+}
+
+uint8_t PhysicsWorld3D::clothTier(const ClothSolver3D& cloth) const {
+    const auto& particles = cloth.getParticles();
+    if (particles.empty()) return 0;
+
+    glm::vec3 low(FLT_MAX), high(-FLT_MAX);
+    for (const auto& particle : particles) {
+        low = glm::min(low, particle->getPosition());
+        high = glm::max(high, particle->getPosition());
+    }
+
+    float nearest = FLT_MAX;
+    for (const glm::vec3& observer : observers) {
+        const glm::vec3 offset = observer - glm::clamp(observer, low, high);
+        nearest = std::min(nearest, glm::dot(offset, offset));
+    }
+    if (nearest > lod.freezeDistance * lod.freezeDistance) return FrozenTier;
+    if (nearest > lod.quarterRateDistance * lod.quarterRateDistance) return 2;
+    if (nearest > lod.halfRateDistance * lod.halfRateDistance) return 1;
+    return 0;
+}
+
+void PhysicsWorld3D::writeSnapshot(TransformSnapshot& snapshot) const {
+    snapshot.step = stepCount;
+
+    const auto& particles = getParticles();
+    snapshot.particlePositions.resize(particles.size());
+    for (size_t i = 0; i < particles.size(); ++i) {
+        snapshot.particlePositions[i] = particles[i]->getPosition();
+    }
+
+    snapshot.ballPositions.resize(balls.size());
+    for (size_t i = 0; i < balls.size(); ++i) {
+        snapshot.ballPositions[i] = balls[i]->getPosition();
+    }
 }
 
 void PhysicsWorld3D::addCloth(const std::shared_ptr<ClothSolver3D>& cloth) {
     cloths.push_back(cloth);
+    clothLods.emplace_back();
+
+    // A cloth built against this world registered itself in createCloth;
+    // adding it again would step every particle twice
+    const auto& registered = getParticles();
+    if (!cloth->getParticles().empty() &&
+        std::find(registered.begin(), registered.end(), cloth->getParticles().front()) != registered.end()) {
+        return;
+    }
+
     // Automatically register particles and springs
     for (const auto& particle : cloth->getParticles()) {
         addParticle(particle);
@@ -34,28 +201,3 @@ void PhysicsWorld3D::addBall(const std::shared_ptr<engine::objects::Ball3D>& bal
 }
 
 } // namespace engine::physics
-
-
-void PhysicsWorld3D::addRigidBody(std::shared_ptr<RigidBody> body) {
-    rigidBodies.push_back(body);
-}
-
-void PhysicsWorld3D::removeRigidBody(std::shared_ptr<RigidBody> body) {
-    auto it = std::find(rigidBodies.begin(), rigidBodies.end(), body);
-    if (it != rigidBodies.end()) {
-        rigidBodies.erase(it);
-    }
-}
-
-// In the update method, add:
-void PhysicsWorld3D::update(float dt, int solverIterations_) {
-    // ... existing cloth code ...
-    
-    // Update rigid bodies
-    for (auto& body : rigidBodies) {
-        if (body->getBodyType() == RigidBody::BodyType::Dynamic) {
-            body->applyForce(gravity * body->getMass());
-            body->integrate(dt);
-        }
-    }
-}
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #include "VertletSystem3D.hpp"
 #include "ClothSolver3D.hpp"
+#include "RigidBody.hpp"
 #include "SoftBodySystem3D.hpp"
 #include "../objects/Ball3D.hpp"
 
@@ -30,12 +31,73 @@ public:
     const std::vector<std::shared_ptr<ClothSolver3D>>& getCloths() const { return cloths; }
     const std::vector<std::shared_ptr<engine::objects::Ball3D>>& getBalls() const { return balls; }
 
+    // Positions after a step, for consumers on another thread (see PhysicsThread).
+    // Particles are in registration order, so each cloth is a contiguous range.
+    struct TransformSnapshot {
+        uint64_t step = 0;
+        std::vector<glm::vec3> particlePositions;
+        std::vector<glm::vec3> ballPositions;
+    };
+
+    // Overwrites snapshot, reusing its storage
+    void writeSnapshot(TransformSnapshot& snapshot) const;
+
+    // Distance LOD for cloth. A cloth whose bounds are farther than
+    // halfRateDistance from every observer steps every second update with
+    // twice the dt, beyond quarterRateDistance every fourth with four times
+    // the dt, and beyond freezeDistance not at all. Forces applied to a
+    // cloth's particles between its steps are averaged over them, and a
+    // frozen cloth drops them every update.
+    // Cloths take turns, so their steps spread evenly over updates; tiers
+    // change every fourth update. Particles and springs that belong to no
+    // cloth, and rigid bodies, always step at full rate.
+    struct LodSettings {
+        bool enabled = false;
+        float halfRateDistance = 30.0f;
+        float quarterRateDistance = 60.0f;
+        float freezeDistance = 120.0f;
+    };
+
+    struct LodStats {
+        size_t clothsPerTier[4] = {};   // Full, half, quarter rate and frozen
+        size_t particlesStepped = 0;    // By the last update
+    };
+
+    void setLodSettings(const LodSettings& settings) { lod = settings; }
+    const LodSettings& getLodSettings() const { return lod; }
+    void setObservers(const std::vector<glm::vec3>& positions) { observers = positions; }
+    const std::vector<glm::vec3>& getObservers() const { return observers; }
+    const LodStats& getLodStats() const { return lodStats; }
+
 private:
+    static constexpr uint8_t FrozenTier = 3;
+
+    struct ClothLod {
+        uint8_t tier = 0;
+        uint8_t lastStride = 1;         // Stride of the cloth's last step, to rescale Verlet velocity
+        uint8_t pendingSteps = 0;       // Updates whose forces the next step takes in
+    };
+
     glm::vec3 gravity;
     int solverIterations;
+    uint64_t stepCount = 0;
     std::vector<std::shared_ptr<RigidBody>> rigidBodies;
     std::vector<std::shared_ptr<ClothSolver3D>> cloths;
     std::vector<std::shared_ptr<engine::objects::Ball3D>> balls;
+
+    LodSettings lod;
+    LodStats lodStats;
+    std::vector<glm::vec3> observers;
+    std::vector<ClothLod> clothLods;    // Parallel to cloths
+    std::vector<std::shared_ptr<Particle3D>> looseParticles;
+    std::vector<std::shared_ptr<Spring3D>> looseSprings;
+    size_t looseParticleSource = 0;     // Registered counts the loose lists were built from
+    size_t looseSpringSource = 0;
+
+    void updateLod(float dt);
+    void refreshLooseLists();
+    uint8_t clothTier(const ClothSolver3D& cloth) const;
+    void updateRigidBodies(float dt);
 };
 
 } // namespace engine::physics
@@ -0,0 +1,330 @@
+#include "RegionStreamer.hpp"
+#include "../core/Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+namespace engine::physics {
+
+using engine::core::log::Logger;
+using engine::core::log::LogLevel;
+
+RegionStreamer::RegionStreamer(PhysicsWorld& world, const Settings& settings)
+    : world(world), settings(settings) {
+    ioThread = std::thread([this] { ioLoop(); });
+}
+
+RegionStreamer::~RegionStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        stopping = true;
+    }
+    ioWake.notify_all();
+    if (ioThread.joinable()) {
+        ioThread.join();
+    }
+}
+
+RegionStreamer::RegionCoord RegionStreamer::regionOf(const glm::vec3& position, float regionSize) {
+    return RegionCoord{static_cast<int32_t>(std::floor(position.x / regionSize)),
+                       static_cast<int32_t>(std::floor(position.z / regionSize))};
+}
+
+RegionStreamer::RegionCoord RegionStreamer::regionAt(const glm::vec3& position) const {
+    return regionOf(position, settings.regionSize);
+}
+
+std::string RegionStreamer::regionPath(const std::string& directory, RegionCoord coord) {
+    return directory + "/region_" + std::to_string(coord.x) + "_" + std::to_string(coord.z) + ".lscn";
+}
+
+std::string RegionStreamer::getRegionPath(RegionCoord coord) const {
+    return regionPath(settings.directory, coord);
+}
+
+bool RegionStreamer::isActive(RegionCoord coord) const {
+    auto found = regions.find(coord);
+    return found != regions.end() && found->second.state == RegionState::Active;
+}
+
+float RegionStreamer::distanceToRegion(RegionCoord coord, const glm::vec3& point) const {
+    const float minX = coord.x * settings.regionSize;
+    const float minZ = coord.z * settings.regionSize;
+    const float dx = std::max({minX - point.x, 0.0f, point.x - (minX + settings.regionSize)});
+    const float dz = std::max({minZ - point.z, 0.0f, point.z - (minZ + settings.regionSize)});
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+float RegionStreamer::nearestPointDistance(RegionCoord coord) const {
+    float nearest = std::numeric_limits<float>::max();
+    for (const glm::vec3& point : pointsOfInterest) {
+        nearest = std::min(nearest, distanceToRegion(coord, point));
+    }
+    return nearest;
+}
+
+void RegionStreamer::adoptBody(BodyHandle handle) {
+    if (world.getRigidBody(handle)) {
+        streamedBodies.insert(handle);
+    }
+}
+
+void RegionStreamer::update() {
+    const auto start = std::chrono::steady_clock::now();
+
+    // Request every region within reach of a point
+    const float reach = settings.activationRadius;
+    for (const glm::vec3& point : pointsOfInterest) {
+        const RegionCoord low = regionAt(point - glm::vec3(reach, 0.0f, reach));
+        const RegionCoord high = regionAt(point + glm::vec3(reach, 0.0f, reach));
+        for (int32_t x = low.x; x <= high.x; ++x) {
+            for (int32_t z = low.z; z <= high.z; ++z) {
+                const RegionCoord coord{x, z};
+                if (regions.count(coord) || distanceToRegion(coord, point) > reach) continue;
+                regions.emplace(coord, Region{});
+                submit(Job{Job::Type::Load, coord, getRegionPath(coord), {}});
+            }
+        }
+    }
+
+    // Bodies drift out of the region they came from. A region holding one is
+    // requested even when no point is near, so the body is saved with the
+    // region it ended up in instead of staying in the world for good.
+    occupied.clear();
+    for (auto it = streamedBodies.begin(); it != streamedBodies.end();) {
+        const RigidBody* body = world.getRigidBody(*it);
+        if (!body) {
+            it = streamedBodies.erase(it);   // Removed by someone else
+            continue;
+        }
+        ++occupied[regionAt(body->getPosition())];
+        ++it;
+    }
+    for (const auto& entry : occupied) {
+        if (regions.count(entry.first)) continue;
+        regions.emplace(entry.first, Region{});
+        submit(Job{Job::Type::Load, entry.first, getRegionPath(entry.first), {}});
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        for (LoadResult& result : loaded) {
+            activating.push_back(std::move(result));
+        }
+        loaded.clear();
+    }
+
+    // Activation creates bodies, so only a few regions go live per update.
+    // Loads that are no longer wanted are dropped without touching the world;
+    // one holding drifted bodies goes live and is released straight after.
+    size_t activations = 0;
+    while (!activating.empty() && activations < settings.maxActivationsPerUpdate) {
+        LoadResult result = std::move(activating.front());
+        activating.pop_front();
+        if (nearestPointDistance(result.coord) > settings.deactivationRadius && !occupied.count(result.coord)) {
+            regions.erase(result.coord);
+            continue;
+        }
+        if (result.openFailed) {
+            // Activating it empty would let release() save over the file
+            Logger::log("Failed to open region file, leaving region out: " + getRegionPath(result.coord),
+                        LogLevel::Error);
+            regions[result.coord].state = RegionState::Failed;
+            continue;
+        }
+        activate(result);
+        ++activations;
+    }
+
+    // Failed regions hold nothing to save; forgetting them lets a later
+    // approach try the file again. One that drifted bodies sit in is kept,
+    // or it would be requested and fail again on every update.
+    std::vector<RegionCoord> expired;
+    for (auto it = regions.begin(); it != regions.end();) {
+        const bool outOfRange = it->second.state != RegionState::Loading &&
+                                nearestPointDistance(it->first) > settings.deactivationRadius;
+        if (outOfRange && it->second.state == RegionState::Failed) {
+            if (occupied.count(it->first)) {
+                ++it;
+                continue;
+            }
+            it = regions.erase(it);
+            continue;
+        }
+        if (outOfRange) {
+            expired.push_back(it->first);
+        }
+        ++it;
+    }
+    for (RegionCoord coord : expired) {
+        release(coord, true);
+    }
+
+    stats.activeRegions = 0;
+    stats.pendingLoads = 0;
+    stats.failedRegions = 0;
+    for (const auto& entry : regions) {
+        if (entry.second.state == RegionState::Active) ++stats.activeRegions;
+        else if (entry.second.state == RegionState::Failed) ++stats.failedRegions;
+        else ++stats.pendingLoads;
+    }
+    stats.streamedBodies = streamedBodies.size();
+    stats.lastUpdateMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void RegionStreamer::activate(LoadResult& result) {
+    Region& region = regions[result.coord];
+    region.state = RegionState::Active;
+    region.hasFile = result.fileExists;
+
+    if (result.scene) {
+        for (BodyHandle handle : result.scene->createBodies(world)) {
+            streamedBodies.insert(handle);
+        }
+        result.scene->close();
+    }
+    ++stats.regionsActivated;
+}
+
+void RegionStreamer::release(RegionCoord coord, bool removeBodies) {
+    std::vector<const RigidBody*> inside;
+    std::vector<BodyHandle> handles;
+    for (auto it = streamedBodies.begin(); it != streamedBodies.end();) {
+        const RigidBody* body = world.getRigidBody(*it);
+        if (!body) {
+            it = streamedBodies.erase(it);   // Removed by someone else
+            continue;
+        }
+        if (regionAt(body->getPosition()) == coord) {
+            inside.push_back(body);
+            handles.push_back(*it);
+        }
+        ++it;
+    }
+
+    // Serialize here, where the world is safe to read; only the disk write
+    // goes to the I/O thread
+    Region& region = regions[coord];
+    if (!inside.empty() || region.hasFile) {
+        Job job{Job::Type::Write, coord, getRegionPath(coord), {}};
+        if (SceneFile::writeBodies(job.data, world, inside)) {
+            submit(std::move(job));
+            region.hasFile = true;
+        }
+    }
+
+    if (removeBodies) {
+        for (BodyHandle handle : handles) {
+            world.removeRigidBody(handle);
+            streamedBodies.erase(handle);
+        }
+        regions.erase(coord);
+        ++stats.regionsReleased;
+    }
+}
+
+void RegionStreamer::flush() {
+    std::vector<RegionCoord> active;
+    for (const auto& entry : regions) {
+        if (entry.second.state == RegionState::Active) active.push_back(entry.first);
+    }
+    for (RegionCoord coord : active) {
+        release(coord, false);
+    }
+
+    std::unique_lock<std::mutex> lock(ioMutex);
+    ioIdle.wait(lock, [&] { return jobs.empty() && !busy; });
+}
+
+void RegionStreamer::submit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        jobs.push_back(std::move(job));
+    }
+    ioWake.notify_one();
+}
+
+bool RegionStreamer::writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!out) {
+            Logger::log("Failed to write region file: " + temporary, LogLevel::Error);
+            return false;
+        }
+    }
+    // rename does not replace an existing file everywhere
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(path.c_str());
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            Logger::log("Failed to replace region file: " + path, LogLevel::Error);
+            return false;
+        }
+    }
+    return true;
+}
+
+void RegionStreamer::ioLoop() {
+    std::unique_lock<std::mutex> lock(ioMutex);
+    for (;;) {
+        ioWake.wait(lock, [&] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) break;     // Stopping, with every write done
+
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        busy = true;
+        const bool skipLoad = stopping;
+        lock.unlock();
+
+        LoadResult result{job.coord, nullptr, false, false};
+        if (job.type == Job::Type::Write) {
+            writeFile(job.path, job.data);
+        } else if (!skipLoad) {
+            result.fileExists = std::ifstream(job.path, std::ios::binary).good();
+            if (result.fileExists) {
+                auto scene = std::make_unique<SceneFile>();
+                if (scene->open(job.path)) {
+                    // Fault the records in here so activation never waits on the disk
+                    volatile float sink = 0.0f;
+                    for (size_t i = 0; i < scene->getBodyCount(); ++i) {
+                        sink = sink + scene->getBodies()[i].position[0];
+                    }
+                    result.scene = std::move(scene);
+                } else {
+                    result.openFailed = true;
+                }
+            }
+        }
+
+        lock.lock();
+        busy = false;
+        if (job.type == Job::Type::Load) {
+            loaded.push_back(std::move(result));
+        }
+        if (jobs.empty()) {
+            ioIdle.notify_all();
+        }
+    }
+}
+
+size_t RegionStreamer::exportRegions(const PhysicsWorld& world, const std::string& directory, float regionSize) {
+    std::unordered_map<RegionCoord, std::vector<const RigidBody*>, CoordHash> groups;
+    for (const RigidBody* body : world.getRigidBodies()) {
+        groups[regionOf(body->getPosition(), regionSize)].push_back(body);
+    }
+
+    size_t written = 0;
+    std::vector<uint8_t> data;
+    for (const auto& [coord, bodies] : groups) {
+        if (SceneFile::writeBodies(data, world, bodies) && writeFile(regionPath(directory, coord), data)) {
+            ++written;
+        }
+    }
+    return written;
+}
+
+} // namespace engine::physics
@@ -0,0 +1,159 @@
+#pragma once
+#include "PhysicsWorld.hpp"
+#include "SceneFile.hpp"
+#include <glm/glm.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace engine::physics {
+
+/**
+ * @brief Streams a large map through one PhysicsWorld, region by region
+ *
+ * The map is cut into square tiles on the XZ plane, each stored as its own
+ * scene file. Regions near a point of interest are loaded; regions that no
+ * point has come near for a while are saved back and their bodies removed,
+ * so body count, broad phase size and solver work follow the area around
+ * players instead of the whole map.
+ *
+ * File work happens on one I/O thread: it maps, validates and pre-faults
+ * region files, and writes released regions to disk (through a temporary
+ * file, so a region is never half written). The world itself is only
+ * touched from update(), which must run on the thread that steps it.
+ * update() also caps activations per call, so a burst of regions coming
+ * into range is spread over several frames.
+ *
+ * Only bodies the streamer loaded, or that were handed over with
+ * adoptBody(), are ever saved or removed. A released region takes every
+ * such body currently inside its bounds, wherever the body was loaded from,
+ * and a body that drifts into a region no point is near gets that region
+ * loaded, so it is saved and removed along with the bodies stored there.
+ * A region whose file exists but does not open is logged and left out: it
+ * is neither activated nor saved, so the file is never overwritten, and it
+ * is tried again only after every point has moved away from it.
+ * Cloths are not streamed.
+ */
+class RegionStreamer {
+public:
+    struct Settings {
+        std::string directory = ".";            // Holds region_<x>_<z>.lscn files
+        float regionSize = 64.0f;
+        float activationRadius = 96.0f;         // Load regions whose bounds come this close
+        float deactivationRadius = 128.0f;      // Release regions farther than this from every point
+        size_t maxActivationsPerUpdate = 2;
+    };
+
+    struct RegionCoord {
+        int32_t x = 0;
+        int32_t z = 0;
+
+        bool operator==(const RegionCoord& other) const { return x == other.x && z == other.z; }
+    };
+
+    struct Stats {
+        size_t activeRegions = 0;
+        size_t pendingLoads = 0;                // Requested or loaded but not yet activated
+        size_t failedRegions = 0;               // Files present but unreadable, left untouched
+        size_t streamedBodies = 0;              // Bodies the streamer currently owns
+        size_t regionsActivated = 0;            // Totals since construction
+        size_t regionsReleased = 0;
+        float lastUpdateMs = 0.0f;
+    };
+
+    RegionStreamer(PhysicsWorld& world, const Settings& settings);
+    // Waits for queued writes; active regions are not saved (call flush first)
+    ~RegionStreamer();
+
+    RegionStreamer(const RegionStreamer&) = delete;
+    RegionStreamer& operator=(const RegionStreamer&) = delete;
+
+    void setPointsOfInterest(const std::vector<glm::vec3>& points) { pointsOfInterest = points; }
+
+    // Requests, activates and releases regions for the current points
+    void update();
+
+    // Saves every active region without releasing it and waits for the writes
+    void flush();
+
+    // Lets the streamer save and release a body spawned at runtime
+    void adoptBody(BodyHandle handle);
+
+    RegionCoord regionAt(const glm::vec3& position) const;
+    bool isActive(RegionCoord coord) const;
+    std::string getRegionPath(RegionCoord coord) const;
+    const Stats& getStats() const { return stats; }
+
+    // Authoring: cuts every body of world into region files under directory
+    static size_t exportRegions(const PhysicsWorld& world, const std::string& directory, float regionSize);
+
+private:
+    struct CoordHash {
+        size_t operator()(const RegionCoord& coord) const {
+            return std::hash<uint64_t>()((uint64_t(uint32_t(coord.x)) << 32) | uint32_t(coord.z));
+        }
+    };
+
+    enum class RegionState { Loading, Active, Failed };
+
+    struct Region {
+        RegionState state = RegionState::Loading;
+        bool hasFile = false;                   // Saving is skipped for regions that never held bodies
+    };
+
+    struct Job {
+        enum class Type { Load, Write };
+        Type type;
+        RegionCoord coord;
+        std::string path;
+        std::vector<uint8_t> data;              // Write only
+    };
+
+    struct LoadResult {
+        RegionCoord coord;
+        std::unique_ptr<SceneFile> scene;       // Null when the file is missing or invalid
+        bool fileExists = false;
+        bool openFailed = false;                // The file exists but SceneFile::open rejected it
+    };
+
+    PhysicsWorld& world;
+    Settings settings;
+    std::vector<glm::vec3> pointsOfInterest;
+
+    std::unordered_map<RegionCoord, Region, CoordHash> regions;
+    std::unordered_set<BodyHandle> streamedBodies;
+    std::unordered_map<RegionCoord, size_t, CoordHash> occupied;   // Streamed bodies per region, rebuilt each update
+    Stats stats;
+
+    // I/O thread
+    std::thread ioThread;
+    std::mutex ioMutex;
+    std::condition_variable ioWake;
+    std::condition_variable ioIdle;
+    std::deque<Job> jobs;
+    std::vector<LoadResult> loaded;             // Guarded by ioMutex
+    bool busy = false;
+    bool stopping = false;
+
+    std::deque<LoadResult> activating;          // Update thread only
+
+    static RegionCoord regionOf(const glm::vec3& position, float regionSize);
+    static std::string regionPath(const std::string& directory, RegionCoord coord);
+    static bool writeFile(const std::string& path, const std::vector<uint8_t>& data);
+
+    float distanceToRegion(RegionCoord coord, const glm::vec3& point) const;
+    float nearestPointDistance(RegionCoord coord) const;
+    void activate(LoadResult& result);
+    void release(RegionCoord coord, bool removeBodies);
+    void submit(Job job);
+    void ioLoop();
+};
+
+} // namespace engine::physics
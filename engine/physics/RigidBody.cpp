@@ -3,9 +3,46 @@
 #include "engine/core/Logger.hpp"
 #include <glm/gtx/matrix_decompose.hpp>
 #include <algorithm>
+#include <cmath>
 
 namespace engine::physics {
 
+namespace {
+    // pow for base in (0, 1] using only basic arithmetic, so every platform
+    // gets the same bits; libm pow may differ in the last ulp between vendors.
+    // Range-reduced log and exp series in double, accurate well past float.
+    float portablePow(float base, float exponent) {
+        if (base <= 0.0f) return 0.0f;
+        if (base == 1.0f || exponent == 0.0f) return 1.0f;
+        
+        constexpr double Ln2 = 0.69314718055994530942;
+        
+        // ln(base) = e*ln2 + ln(m), m in [0.5, 1), via 2*atanh((m-1)/(m+1))
+        int e = 0;
+        const double m = std::frexp(static_cast<double>(base), &e);
+        const double z = (m - 1.0) / (m + 1.0);
+        const double z2 = z * z;
+        double term = z;
+        double series = 0.0;
+        for (int k = 1; k < 40; k += 2) {
+            series += term / k;
+            term *= z2;
+        }
+        const double y = static_cast<double>(exponent) * (e * Ln2 + 2.0 * series);
+        
+        // exp(y) = 2^n * exp(r), |r| <= ln2/2
+        const double n = std::floor(y / Ln2 + 0.5);
+        const double r = y - n * Ln2;
+        double result = 1.0;
+        term = 1.0;
+        for (int k = 1; k < 20; ++k) {
+            term *= r / k;
+            result += term;
+        }
+        return static_cast<float>(std::ldexp(result, static_cast<int>(n)));
+    }
+}
+
 RigidBody::RigidBody(BodyType type, float bodyMass) 
     : bodyType(type) {
     setMass(bodyMass);
@@ -33,33 +70,40 @@ void RigidBody::integrate(float dt) {
         return;
     }
 
+    // Every operation below is the one BatchIntegrator::integrateLanes does,
+    // in the same order, so a body gets the same bits from a SIMD lane or
+    // from the scalar tail. Keep the two in step.
+    updateDampingFactors(dt);
+
     // Linear integration using semi-implicit Euler
-    // v = v + a * dt
+    // v = (v + F * m^-1 * dt) * damping
     // p = p + v * dt
-    glm::vec3 acceleration = force * inverseMass;
-    linearVelocity += acceleration * dt;
-    
-    // Apply linear damping
-    linearVelocity *= std::pow(1.0f - linearDamping, dt);
-    
-    // Update position
-    position += linearVelocity * dt;
+    const float invMassDt = inverseMass * dt;
+    for (int axis = 0; axis < 3; ++axis) {
+        linearVelocity[axis] = (force[axis] * invMassDt + linearVelocity[axis]) * linearDampingFactor;
+        position[axis] = linearVelocity[axis] * dt + position[axis];
+    }
 
     // Angular integration
-    // ω = ω + I^-1 * τ * dt
-    // q = q + 0.5 * ω * q * dt
-    glm::vec3 angularAcceleration = worldInverseInertiaTensor * torque;
-    angularVelocity += angularAcceleration * dt;
-    
-    // Apply angular damping
-    angularVelocity *= std::pow(1.0f - angularDamping, dt);
-    
-    // Update orientation using quaternion integration
-    if (glm::length(angularVelocity) > 0.0001f) {
-        glm::quat angularVelQuat(0.0f, angularVelocity.x, angularVelocity.y, angularVelocity.z);
-        glm::quat deltaOrientation = 0.5f * angularVelQuat * orientation * dt;
-        orientation += deltaOrientation;
-        orientation = glm::normalize(orientation);
+    // ω = (ω + I^-1 * τ * dt) * damping
+    const glm::mat3& iw = worldInverseInertiaTensor;
+    for (int i = 0; i < 3; ++i) {
+        float acceleration = (iw[0][i] * torque[0] + iw[1][i] * torque[1]) + iw[2][i] * torque[2];
+        angularVelocity[i] = (acceleration * dt + angularVelocity[i]) * angularDampingFactor;
+    }
+
+    // Orientation: q = normalize(q + 0.5 * (0, ω) * q * dt), once |ω| > 0.0001
+    const glm::vec3& w = angularVelocity;
+    const float spinSq = (w.x * w.x + w.y * w.y) + w.z * w.z;
+    if (spinSq > 0.0001f * 0.0001f) {
+        const glm::quat q = orientation;
+        const float h = 0.5f * dt;
+        const float nw = q.w + h * (0.0f - ((w.x * q.x + w.y * q.y) + w.z * q.z));
+        const float nx = q.x + h * (q.w * w.x + (w.y * q.z - w.z * q.y));
+        const float ny = q.y + h * (q.w * w.y + (w.z * q.x - w.x * q.z));
+        const float nz = q.z + h * (q.w * w.z + (w.x * q.y - w.y * q.x));
+        const float invLength = 1.0f / std::sqrt((nx * nx + ny * ny) + (nz * nz + nw * nw));
+        orientation = glm::quat(nw * invLength, nx * invLength, ny * invLength, nz * invLength);
     }
 
     // Update world-space inverse inertia tensor
@@ -170,6 +214,9 @@ void RigidBody::setMass(float newMass) {
         );
         inverseInertiaTensor = glm::inverse(inertiaTensor);
         updateInertiaTensor();
+
+        // A shape with mass properties replaces the default
+        applyShapeInertia();
     }
 }
 
@@ -203,9 +250,16 @@ void RigidBody::setCollisionShape(std::shared_ptr<CollisionShape> shape) {
     collisionShape = shape;
     
     // Auto-calculate inertia tensor based on shape
-    if (shape && mass > 0.0f) {
-        // This will be implemented when we add specific shapes
-        // For now, keep the default inertia tensor
+    applyShapeInertia();
+}
+
+void RigidBody::applyShapeInertia() {
+    if (!collisionShape || mass <= 0.0f) return;
+
+    glm::mat3 tensor = collisionShape->calculateInertiaTensor(mass);
+    // Shapes without mass properties (meshes, heightfields) keep the current tensor
+    if (glm::determinant(tensor) > 1e-12f) {
+        setInertiaTensor(tensor);
     }
 }
 
@@ -240,10 +294,17 @@ void RigidBody::updateInertiaTensor() {
         return;
     }
 
-    // Transform inertia tensor to world space: I_world = R * I_body * R^T
+    // Rotate the body-space inverse directly: (R * I * R^T)^-1 = R * I^-1 * R^T
     glm::mat3 rotationMatrix = glm::mat3_cast(orientation);
-    glm::mat3 worldInertiaTensor = rotationMatrix * inertiaTensor * glm::transpose(rotationMatrix);
-    worldInverseInertiaTensor = glm::inverse(worldInertiaTensor);
+    worldInverseInertiaTensor = rotationMatrix * inverseInertiaTensor * glm::transpose(rotationMatrix);
+}
+
+void RigidBody::updateDampingFactors(float dt) {
+    if (dt == dampingFactorDt) return;
+
+    linearDampingFactor = portablePow(1.0f - linearDamping, dt);
+    angularDampingFactor = portablePow(1.0f - angularDamping, dt);
+    dampingFactorDt = dt;
 }
 
 void RigidBody::updateSleepState(float dt) {
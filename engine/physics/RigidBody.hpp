@@ -3,12 +3,15 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include "collision/CollisionFilter.hpp"
+#include "BodyHandle.hpp"
 #include <memory>
 #include <vector>
 
 namespace engine::physics {
 
 class CollisionShape;
+class BatchIntegrator;
 
 /**
  * @brief Rigid body with 6DOF physics simulation
@@ -49,6 +52,13 @@ public:
     void setOrientation(const glm::quat& orient);
     
     glm::mat4 getTransform() const;
+    
+    // Pose before the world's most recent step, for render interpolation
+    const glm::vec3& getPreviousPosition() const { return previousPosition; }
+    const glm::quat& getPreviousOrientation() const { return previousOrientation; }
+    
+    // Call after teleporting so rendering snaps to the new pose instead of sliding
+    void resetInterpolation() { previousPoseStep = 0; }
 
     // Velocity
     const glm::vec3& getLinearVelocity() const { return linearVelocity; }
@@ -60,10 +70,13 @@ public:
     // Mass properties
     float getMass() const { return mass; }
     float getInverseMass() const { return inverseMass; }
+    // Also re-derives the inertia tensor: from the collision shape when it has
+    // mass properties, else the unit cube default
     void setMass(float newMass);
     
     const glm::mat3& getInertiaTensor() const { return inertiaTensor; }
     const glm::mat3& getInverseInertiaTensor() const { return inverseInertiaTensor; }
+    const glm::mat3& getWorldInverseInertiaTensor() const { return worldInverseInertiaTensor; }
     void setInertiaTensor(const glm::mat3& tensor);
 
     // Body type
@@ -72,15 +85,28 @@ public:
 
     // Physics properties
     float getLinearDamping() const { return linearDamping; }
-    void setLinearDamping(float damping) { linearDamping = damping; }
+    void setLinearDamping(float damping) { linearDamping = damping; dampingFactorDt = -1.0f; }
     
     float getAngularDamping() const { return angularDamping; }
-    void setAngularDamping(float damping) { angularDamping = damping; }
+    void setAngularDamping(float damping) { angularDamping = damping; dampingFactorDt = -1.0f; }
 
-    // Collision shape
+    // Collision shape; a dynamic body takes the shape's inertia tensor when it has one
     void setCollisionShape(std::shared_ptr<CollisionShape> shape);
     std::shared_ptr<CollisionShape> getCollisionShape() const { return collisionShape; }
 
+    // Collision filtering (evaluated by the broad phase before pairs are emitted)
+    const CollisionFilter& getCollisionFilter() const { return collisionFilter; }
+    void setCollisionFilter(const CollisionFilter& filter) { collisionFilter = filter; }
+    
+    uint32_t getCollisionLayer() const { return collisionFilter.layer; }
+    void setCollisionLayer(uint32_t layer) { collisionFilter.layer = layer; }
+    
+    uint32_t getCollisionMask() const { return collisionFilter.mask; }
+    void setCollisionMask(uint32_t mask) { collisionFilter.mask = mask; }
+    
+    uint32_t getCollisionGroup() const { return collisionFilter.group; }
+    void setCollisionGroup(uint32_t group) { collisionFilter.group = group; }
+
     // Utility
     glm::vec3 getVelocityAtPoint(const glm::vec3& worldPoint) const;
     glm::vec3 worldToLocal(const glm::vec3& worldPoint) const;
@@ -91,7 +117,13 @@ public:
     void setSleeping(bool sleep);
     void wakeUp();
 
+    // Handle in the owning world; invalid while the body is not in a world
+    BodyHandle getHandle() const { return handle; }
+
 private:
+    friend class BatchIntegrator;
+    friend class PhysicsWorld;
+
     // Transform
     glm::vec3 position{0.0f};
     glm::quat orientation{1.0f, 0.0f, 0.0f, 0.0f};
@@ -103,31 +135,60 @@ private:
     // Angular motion
     glm::vec3 angularVelocity{0.0f};
     glm::vec3 torque{0.0f};
+    glm::mat3 worldInverseInertiaTensor{1.0f};
+
+    // Sleep system
+    float sleepTime = 0.0f;
+
+    // Render interpolation; previousPoseStep is the world step that started
+    // from the previous pose, 0 when there is none
+    glm::vec3 previousPosition{0.0f};
+    glm::quat previousOrientation{1.0f, 0.0f, 0.0f, 0.0f};
+    uint64_t previousPoseStep = 0;
+
+    // Update-rate tier set by PhysicsWorld's distance LOD: the body steps
+    // every (1 << updateTier) world steps, when (step + updatePhase) is a
+    // multiple of that. lastUpdateStep is the world step it last moved in.
+    uint64_t lastUpdateStep = 0;
+    bool sleeping = false;
+    uint8_t updateTier = 0;
+    uint8_t updatePhase = 0;
+
+    // Everything from position to here is per-step state that PhysicsWorld
+    // snapshots copy as one block; keep such fields inside it, ordered so
+    // the block has no padding other than this explicit, zeroed tail
+    uint8_t statePadding[5] = {};
+    static constexpr float SLEEP_THRESHOLD = 2.0f;
+    static constexpr float SLEEP_LINEAR_VELOCITY = 0.01f;
+    static constexpr float SLEEP_ANGULAR_VELOCITY = 0.01f;
 
     // Mass properties
     float mass = 1.0f;
     float inverseMass = 1.0f;
     glm::mat3 inertiaTensor{1.0f};
     glm::mat3 inverseInertiaTensor{1.0f};
-    glm::mat3 worldInverseInertiaTensor{1.0f};
 
     // Body properties
     BodyType bodyType = BodyType::Dynamic;
     float linearDamping = 0.01f;
     float angularDamping = 0.05f;
 
+    // Per-step damping multipliers, recomputed only when dt or damping changes
+    float linearDampingFactor = 1.0f;
+    float angularDampingFactor = 1.0f;
+    float dampingFactorDt = -1.0f;
+
     // Collision
     std::shared_ptr<CollisionShape> collisionShape;
+    CollisionFilter collisionFilter;
 
-    // Sleep system
-    bool sleeping = false;
-    float sleepTime = 0.0f;
-    static constexpr float SLEEP_THRESHOLD = 2.0f;
-    static constexpr float SLEEP_LINEAR_VELOCITY = 0.01f;
-    static constexpr float SLEEP_ANGULAR_VELOCITY = 0.01f;
+    // World membership
+    BodyHandle handle;
 
     // Helper methods
     void updateInertiaTensor();
+    void applyShapeInertia();
+    void updateDampingFactors(float dt);
     void updateSleepState(float dt);
     glm::mat3 calculateBoxInertia(const glm::vec3& size) const;
     glm::mat3 calculateSphereInertia(float radius) const;
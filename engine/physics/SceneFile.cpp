@@ -0,0 +1,439 @@
+#include "SceneFile.hpp"
+#include "SphereShape.hpp"
+#include "BoxShape.hpp"
+#include "shapes/CapsuleShape.hpp"
+#include "../core/Logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+
+namespace engine::physics {
+
+using engine::core::log::Logger;
+using engine::core::log::LogLevel;
+
+namespace {
+
+constexpr char SceneFileMagic[4] = {'L', 'S', 'C', 'N'};
+
+uint64_t alignTo16(uint64_t offset) {
+    return (offset + 15) & ~uint64_t(15);
+}
+
+template <typename Record>
+SceneFile::Section makeSection(SceneFile::SectionType type, const std::vector<Record>& records) {
+    SceneFile::Section section{};
+    section.type = type;
+    section.recordSize = sizeof(Record);
+    section.count = records.size();
+    return section;
+}
+
+// Particles and springs of one loaded cloth live in single blocks; the
+// shared_ptrs handed to the solver alias into them
+struct ParticleBlock {
+    std::vector<Particle3D> particles;
+};
+
+struct SpringBlock {
+    std::vector<Spring3D> springs;
+};
+
+} // namespace
+
+bool SceneFile::describeShape(const CollisionShape& shape, ShapeRecord& record) {
+    record = ShapeRecord{};
+    record.type = static_cast<uint32_t>(shape.getType());
+    switch (shape.getType()) {
+        case CollisionShape::ShapeType::Sphere:
+            record.params[0] = static_cast<const SphereShape&>(shape).getRadius();
+            return true;
+        case CollisionShape::ShapeType::Box: {
+            const glm::vec3& halfExtents = static_cast<const BoxShape&>(shape).getHalfExtents();
+            record.params[0] = halfExtents.x;
+            record.params[1] = halfExtents.y;
+            record.params[2] = halfExtents.z;
+            return true;
+        }
+        case CollisionShape::ShapeType::Capsule: {
+            const auto& capsule = static_cast<const CapsuleShape&>(shape);
+            record.params[0] = capsule.getRadius();
+            record.params[1] = capsule.getHeight();
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+bool SceneFile::save(const std::string& path, const PhysicsWorld& world,
+                     const std::vector<const ClothSolver3D*>& clothSolvers) {
+    std::vector<uint8_t> buffer;
+    const auto& bodies = world.getRigidBodies();
+    if (!serialize(buffer, world, {bodies.begin(), bodies.end()}, clothSolvers, path)) {
+        return false;
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        Logger::log("Failed to write scene file: " + path, LogLevel::Error);
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(out);
+}
+
+bool SceneFile::write(std::vector<uint8_t>& buffer, const PhysicsWorld& world,
+                      const std::vector<const ClothSolver3D*>& clothSolvers) {
+    const auto& bodies = world.getRigidBodies();
+    return serialize(buffer, world, {bodies.begin(), bodies.end()}, clothSolvers, "(memory)");
+}
+
+bool SceneFile::writeBodies(std::vector<uint8_t>& buffer, const PhysicsWorld& world,
+                            const std::vector<const RigidBody*>& bodies) {
+    return serialize(buffer, world, bodies, {}, "(memory)");
+}
+
+bool SceneFile::serialize(std::vector<uint8_t>& buffer, const PhysicsWorld& world,
+                          const std::vector<const RigidBody*>& bodies,
+                          const std::vector<const ClothSolver3D*>& clothSolvers, const std::string& path) {
+    std::vector<WorldRecord> worldRecords(1);
+    WorldRecord& settings = worldRecords[0];
+    settings = WorldRecord{};
+    for (int i = 0; i < 3; ++i) {
+        settings.gravity[i] = world.getGravity()[i];
+    }
+    settings.timeStep = world.getTimeStep();
+    settings.velocityIterations = world.getVelocityIterations();
+    settings.positionIterations = world.getPositionIterations();
+    settings.maxSubSteps = world.getMaxSubSteps();
+
+    // Shapes are written once and shared by index
+    std::vector<ShapeRecord> shapeRecords;
+    std::unordered_map<const CollisionShape*, uint32_t> shapeIndices;
+    size_t unsupportedShapes = 0;
+
+    auto shapeIndexOf = [&](const CollisionShape* shape) -> uint32_t {
+        if (!shape) return NoShape;
+        auto found = shapeIndices.find(shape);
+        if (found != shapeIndices.end()) return found->second;
+
+        ShapeRecord record;
+        if (!describeShape(*shape, record)) {
+            ++unsupportedShapes;
+            shapeIndices.emplace(shape, NoShape);
+            return NoShape;
+        }
+
+        const uint32_t index = static_cast<uint32_t>(shapeRecords.size());
+        shapeRecords.push_back(record);
+        shapeIndices.emplace(shape, index);
+        return index;
+    };
+
+    std::vector<BodyRecord> bodyRecords;
+    bodyRecords.reserve(bodies.size());
+    for (const RigidBody* body : bodies) {
+        BodyRecord record{};
+        const glm::vec3& position = body->getPosition();
+        const glm::quat& orientation = body->getOrientation();
+        const glm::vec3& linearVelocity = body->getLinearVelocity();
+        const glm::vec3& angularVelocity = body->getAngularVelocity();
+        for (int i = 0; i < 3; ++i) {
+            record.position[i] = position[i];
+            record.linearVelocity[i] = linearVelocity[i];
+            record.angularVelocity[i] = angularVelocity[i];
+        }
+        record.orientation[0] = orientation.w;
+        record.orientation[1] = orientation.x;
+        record.orientation[2] = orientation.y;
+        record.orientation[3] = orientation.z;
+        record.mass = body->getMass();
+        record.linearDamping = body->getLinearDamping();
+        record.angularDamping = body->getAngularDamping();
+        record.shapeIndex = shapeIndexOf(body->getCollisionShape().get());
+        record.bodyType = static_cast<uint32_t>(body->getBodyType());
+        record.collisionLayer = body->getCollisionLayer();
+        record.collisionMask = body->getCollisionMask();
+        record.collisionGroup = body->getCollisionGroup();
+        bodyRecords.push_back(record);
+    }
+
+    if (unsupportedShapes > 0) {
+        Logger::log("Scene file " + path + ": " + std::to_string(unsupportedShapes) +
+                    " shape(s) of unsupported type saved as no shape", LogLevel::Warning);
+    }
+
+    std::vector<ClothRecord> clothRecords;
+    std::vector<ParticleRecord> particleRecords;
+    std::vector<SpringRecord> springRecords;
+    std::unordered_map<const Particle3D*, uint32_t> particleIndices;
+
+    for (const ClothSolver3D* cloth : clothSolvers) {
+        ClothRecord record{};
+        record.width = cloth->getWidth();
+        record.height = cloth->getHeight();
+        record.particleDistance = cloth->getParticleDistance();
+        record.firstParticle = static_cast<uint32_t>(particleRecords.size());
+        record.particleCount = static_cast<uint32_t>(cloth->getParticles().size());
+        record.firstSpring = static_cast<uint32_t>(springRecords.size());
+        record.springCount = static_cast<uint32_t>(cloth->getSprings().size());
+        clothRecords.push_back(record);
+
+        particleIndices.clear();
+        for (const auto& particle : cloth->getParticles()) {
+            ParticleRecord particleRecord{};
+            const glm::vec3& position = particle->getPosition();
+            for (int i = 0; i < 3; ++i) {
+                particleRecord.position[i] = position[i];
+            }
+            particleRecord.mass = particle->getMass();
+            particleRecord.pinned = particle->isPinned() ? 1u : 0u;
+            particleIndices.emplace(particle.get(), static_cast<uint32_t>(particleIndices.size()));
+            particleRecords.push_back(particleRecord);
+        }
+
+        for (const auto& spring : cloth->getSprings()) {
+            auto a = particleIndices.find(spring->getParticleA().get());
+            auto b = particleIndices.find(spring->getParticleB().get());
+            if (a == particleIndices.end() || b == particleIndices.end()) {
+                Logger::log("Scene file " + path + ": cloth spring joins particles of another cloth",
+                            LogLevel::Error);
+                return false;
+            }
+            springRecords.push_back(SpringRecord{a->second, b->second, spring->getStiffness(),
+                                                 spring->getRestLength()});
+        }
+    }
+
+    Section sections[] = {
+        makeSection(SectionType::World, worldRecords),
+        makeSection(SectionType::Shapes, shapeRecords),
+        makeSection(SectionType::Bodies, bodyRecords),
+        makeSection(SectionType::Cloths, clothRecords),
+        makeSection(SectionType::ClothParticles, particleRecords),
+        makeSection(SectionType::ClothSprings, springRecords),
+    };
+    const void* sectionData[] = {
+        worldRecords.data(), shapeRecords.data(), bodyRecords.data(),
+        clothRecords.data(), particleRecords.data(), springRecords.data(),
+    };
+    constexpr uint32_t SectionCount = sizeof(sections) / sizeof(sections[0]);
+
+    uint64_t offset = sizeof(FileHeader) + sizeof(sections);
+    for (Section& section : sections) {
+        section.offset = alignTo16(offset);
+        offset = section.offset + section.count * section.recordSize;
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, SceneFileMagic, sizeof(header.magic));
+    header.version = Version;
+    header.sectionCount = SectionCount;
+
+    // Gaps between sections are zero padding from the resize
+    buffer.assign(static_cast<size_t>(offset), 0);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + sizeof(header), sections, sizeof(sections));
+    for (uint32_t i = 0; i < SectionCount; ++i) {
+        if (sections[i].count > 0) {
+            std::memcpy(buffer.data() + sections[i].offset, sectionData[i],
+                        static_cast<size_t>(sections[i].count * sections[i].recordSize));
+        }
+    }
+    return true;
+}
+
+bool SceneFile::open(const std::string& path) {
+    close();
+    if (!file.open(path)) {
+        return false;
+    }
+    return bind(file.data(), file.size(), path);
+}
+
+bool SceneFile::openBuffer(const uint8_t* data, size_t size, const std::string& sourceName) {
+    close();
+    return bind(data, size, sourceName);
+}
+
+bool SceneFile::bind(const uint8_t* fileData, size_t fileSize, const std::string& path) {
+    auto fail = [&](const std::string& reason) {
+        Logger::log("Invalid scene file " + path + ": " + reason, LogLevel::Error);
+        close();
+        return false;
+    };
+
+    FileHeader header;
+    if (fileSize < sizeof(header)) return fail("too small");
+    if (reinterpret_cast<uintptr_t>(fileData) % 16 != 0) return fail("data not 16-byte aligned");
+    std::memcpy(&header, fileData, sizeof(header));
+    if (std::memcmp(header.magic, SceneFileMagic, sizeof(header.magic)) != 0) return fail("bad magic");
+    if (header.version != Version) return fail("unsupported version " + std::to_string(header.version));
+    if (sizeof(header) + uint64_t(header.sectionCount) * sizeof(Section) > fileSize) {
+        return fail("truncated section table");
+    }
+
+    for (uint32_t i = 0; i < header.sectionCount; ++i) {
+        Section section;
+        std::memcpy(&section, fileData + sizeof(header) + i * sizeof(Section), sizeof(section));
+        if (section.offset % 16 != 0 || section.offset > fileSize ||
+            section.count > (fileSize - section.offset) / std::max<uint32_t>(section.recordSize, 1)) {
+            return fail("section out of bounds");
+        }
+
+        const uint8_t* data = fileData + section.offset;
+        auto bind = [&](auto*& records, size_t* count) {
+            using Record = std::remove_const_t<std::remove_pointer_t<std::remove_reference_t<decltype(records)>>>;
+            if (section.recordSize != sizeof(Record)) return false;
+            records = reinterpret_cast<const Record*>(data);
+            if (count) *count = static_cast<size_t>(section.count);
+            return true;
+        };
+
+        bool ok = true;
+        switch (section.type) {
+            case SectionType::World:
+                ok = bind(world, nullptr) && section.count == 1;
+                break;
+            case SectionType::Shapes: ok = bind(shapes, &shapeCount); break;
+            case SectionType::Bodies: ok = bind(bodies, &bodyCount); break;
+            case SectionType::Cloths: ok = bind(cloths, &clothCount); break;
+            case SectionType::ClothParticles: ok = bind(particles, &particleCount); break;
+            case SectionType::ClothSprings: ok = bind(springs, &springCount); break;
+            default: break;   // Unknown sections are skipped so newer writers can add data
+        }
+        if (!ok) return fail("bad record size or count in section " + std::to_string(i));
+    }
+
+    // Cross-references are checked once here so the builders can trust them
+    for (size_t i = 0; i < bodyCount; ++i) {
+        if (bodies[i].shapeIndex != NoShape && bodies[i].shapeIndex >= shapeCount) {
+            return fail("body shape index out of range");
+        }
+    }
+    for (size_t i = 0; i < clothCount; ++i) {
+        const ClothRecord& cloth = cloths[i];
+        if (uint64_t(cloth.firstParticle) + cloth.particleCount > particleCount ||
+            uint64_t(cloth.firstSpring) + cloth.springCount > springCount) {
+            return fail("cloth range out of bounds");
+        }
+        for (uint32_t s = 0; s < cloth.springCount; ++s) {
+            const SpringRecord& spring = springs[cloth.firstSpring + s];
+            if (spring.particleA >= cloth.particleCount || spring.particleB >= cloth.particleCount) {
+                return fail("spring particle index out of range");
+            }
+        }
+    }
+    opened = true;
+    return true;
+}
+
+void SceneFile::close() {
+    file.close();
+    opened = false;
+    world = nullptr;
+    shapes = nullptr;
+    bodies = nullptr;
+    cloths = nullptr;
+    particles = nullptr;
+    springs = nullptr;
+    shapeCount = bodyCount = clothCount = particleCount = springCount = 0;
+}
+
+void SceneFile::applyWorldSettings(PhysicsWorld& target) const {
+    if (!world) return;
+    target.setGravity(glm::vec3(world->gravity[0], world->gravity[1], world->gravity[2]));
+    target.setTimeStep(world->timeStep);
+    target.setVelocityIterations(world->velocityIterations);
+    target.setPositionIterations(world->positionIterations);
+    target.setMaxSubSteps(world->maxSubSteps);
+}
+
+std::shared_ptr<CollisionShape> SceneFile::createShape(const ShapeRecord& record) {
+    switch (static_cast<CollisionShape::ShapeType>(record.type)) {
+        case CollisionShape::ShapeType::Sphere:
+            return std::make_shared<SphereShape>(record.params[0]);
+        case CollisionShape::ShapeType::Box:
+            return std::make_shared<BoxShape>(glm::vec3(record.params[0], record.params[1], record.params[2]));
+        case CollisionShape::ShapeType::Capsule:
+            return std::make_shared<CapsuleShape>(record.params[0], record.params[1]);
+        default:
+            return nullptr;
+    }
+}
+
+std::vector<BodyHandle> SceneFile::createBodies(PhysicsWorld& target) const {
+    std::vector<std::shared_ptr<CollisionShape>> shapeObjects(shapeCount);
+    for (size_t i = 0; i < shapeCount; ++i) {
+        shapeObjects[i] = createShape(shapes[i]);
+    }
+
+    return target.createRigidBodies(bodyCount, [&](RigidBody& body, size_t index) {
+        const BodyRecord& record = bodies[index];
+        const auto type = static_cast<RigidBody::BodyType>(record.bodyType);
+
+        // Type, then mass, then shape: the shape derives inertia from the mass
+        body.setBodyType(type);
+        if (type == RigidBody::BodyType::Dynamic) {
+            body.setMass(record.mass);
+        }
+        if (record.shapeIndex != NoShape) {
+            body.setCollisionShape(shapeObjects[record.shapeIndex]);
+        }
+
+        body.setPosition(glm::vec3(record.position[0], record.position[1], record.position[2]));
+        body.setOrientation(glm::quat(record.orientation[0], record.orientation[1],
+                                      record.orientation[2], record.orientation[3]));
+        body.setLinearVelocity(glm::vec3(record.linearVelocity[0], record.linearVelocity[1],
+                                         record.linearVelocity[2]));
+        body.setAngularVelocity(glm::vec3(record.angularVelocity[0], record.angularVelocity[1],
+                                          record.angularVelocity[2]));
+        body.setLinearDamping(record.linearDamping);
+        body.setAngularDamping(record.angularDamping);
+        body.setCollisionFilter(CollisionFilter{record.collisionLayer, record.collisionMask,
+                                                record.collisionGroup});
+    });
+}
+
+std::vector<std::unique_ptr<ClothSolver3D>> SceneFile::createCloths(VertletSystem3D& system) const {
+    std::vector<std::unique_ptr<ClothSolver3D>> result;
+    result.reserve(clothCount);
+
+    for (size_t c = 0; c < clothCount; ++c) {
+        const ClothRecord& cloth = cloths[c];
+
+        auto particleBlock = std::make_shared<ParticleBlock>();
+        particleBlock->particles.reserve(cloth.particleCount);
+        std::vector<std::shared_ptr<Particle3D>> clothParticles;
+        clothParticles.reserve(cloth.particleCount);
+        for (uint32_t i = 0; i < cloth.particleCount; ++i) {
+            const ParticleRecord& record = particles[cloth.firstParticle + i];
+            particleBlock->particles.emplace_back(
+                glm::vec3(record.position[0], record.position[1], record.position[2]), record.mass,
+                record.pinned != 0);
+            clothParticles.emplace_back(particleBlock, &particleBlock->particles.back());
+        }
+
+        // Springs keep the particle block alive, never the other way round
+        auto springBlock = std::make_shared<SpringBlock>();
+        springBlock->springs.reserve(cloth.springCount);
+        std::vector<std::shared_ptr<Spring3D>> clothSprings;
+        clothSprings.reserve(cloth.springCount);
+        for (uint32_t i = 0; i < cloth.springCount; ++i) {
+            const SpringRecord& record = springs[cloth.firstSpring + i];
+            springBlock->springs.emplace_back(clothParticles[record.particleA], clothParticles[record.particleB],
+                                              record.stiffness, record.restLength);
+            clothSprings.emplace_back(springBlock, &springBlock->springs.back());
+        }
+
+        auto solver = std::make_unique<ClothSolver3D>(system, cloth.width, cloth.height, cloth.particleDistance);
+        solver->adoptCloth(std::move(clothParticles), std::move(clothSprings));
+        result.push_back(std::move(solver));
+    }
+    return result;
+}
+
+} // namespace engine::physics
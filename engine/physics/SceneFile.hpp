@@ -0,0 +1,174 @@
+#pragma once
+#include "PhysicsWorld.hpp"
+#include "ClothSolver3D.hpp"
+#include "VertletSystem3D.hpp"
+#include "../core/MappedFile.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace engine::physics {
+
+/**
+ * @brief Versioned binary level format, memory-mapped for loading
+ *
+ * Layout: a fixed header, a section table, then one 16-byte aligned array of
+ * POD records per section. Bodies reference shapes by index, so shapes
+ * shared in the saved world stay shared after loading. Cloth particles and
+ * springs are stored per cloth, and springs reference particles by their
+ * index within that cloth.
+ *
+ * Loading reads the records in place from the mapping. Bodies go through
+ * PhysicsWorld::createRigidBodies, and each cloth's particles and springs are
+ * built in one block allocation, so no parsing happens and allocation count
+ * does not grow with body or particle count.
+ * Sphere, box and capsule shapes are embedded. Triangle meshes have their own
+ * cache format (TriangleMeshShape::saveToFile); bodies with any other shape
+ * are saved without one and a warning is logged.
+ */
+class SceneFile {
+public:
+    enum class SectionType : uint32_t {
+        World = 1,
+        Shapes = 2,
+        Bodies = 3,
+        Cloths = 4,
+        ClothParticles = 5,
+        ClothSprings = 6,
+    };
+
+    struct FileHeader {
+        char magic[4];                 // "LSCN"
+        uint32_t version;
+        uint32_t sectionCount;
+        uint32_t reserved;
+    };
+
+    struct Section {
+        SectionType type;
+        uint32_t recordSize;           // Checked on load so stale files are rejected
+        uint64_t offset;               // From file start, 16-byte aligned
+        uint64_t count;
+    };
+
+    struct WorldRecord {
+        float gravity[3];
+        float timeStep;
+        int32_t velocityIterations;
+        int32_t positionIterations;
+        int32_t maxSubSteps;
+        uint32_t reserved;
+    };
+
+    struct ShapeRecord {
+        uint32_t type;                 // CollisionShape::ShapeType
+        float params[3];               // Sphere: radius; box: half extents; capsule: radius, height
+    };
+
+    struct BodyRecord {
+        float position[3];
+        float orientation[4];          // w, x, y, z
+        float linearVelocity[3];
+        float angularVelocity[3];
+        float mass;
+        float linearDamping;
+        float angularDamping;
+        uint32_t shapeIndex;           // NoShape when the body has none
+        uint32_t bodyType;             // RigidBody::BodyType
+        uint32_t collisionLayer;
+        uint32_t collisionMask;
+        uint32_t collisionGroup;
+        uint32_t reserved;
+    };
+
+    struct ClothRecord {
+        int32_t width;
+        int32_t height;
+        float particleDistance;
+        uint32_t firstParticle;
+        uint32_t particleCount;
+        uint32_t firstSpring;
+        uint32_t springCount;
+        uint32_t reserved;
+    };
+
+    struct ParticleRecord {
+        float position[3];
+        float mass;
+        uint32_t pinned;
+    };
+
+    struct SpringRecord {
+        uint32_t particleA;            // Indices within the owning cloth
+        uint32_t particleB;
+        float stiffness;
+        float restLength;
+    };
+
+    static constexpr uint32_t Version = 1;
+    static constexpr uint32_t NoShape = 0xFFFFFFFFu;
+
+    // Writes the world's bodies and settings plus the given cloths
+    static bool save(const std::string& path, const PhysicsWorld& world,
+                     const std::vector<const ClothSolver3D*>& cloths = {});
+    // Same layout into memory, for embedding in other files
+    static bool write(std::vector<uint8_t>& buffer, const PhysicsWorld& world,
+                      const std::vector<const ClothSolver3D*>& cloths = {});
+    // Only the given bodies of world, with its settings
+    static bool writeBodies(std::vector<uint8_t>& buffer, const PhysicsWorld& world,
+                            const std::vector<const RigidBody*>& bodies);
+
+    // Maps and validates the file; returns false and logs on failure
+    bool open(const std::string& path);
+    // Validates a scene already in memory. The data must stay alive and
+    // 16-byte aligned while the scene is open.
+    bool openBuffer(const uint8_t* data, size_t size, const std::string& sourceName);
+    void close();
+    bool isOpen() const { return opened; }
+
+    // Shape parameters as stored in ShapeRecord; false for unsupported types
+    static bool describeShape(const CollisionShape& shape, ShapeRecord& record);
+    static std::shared_ptr<CollisionShape> createShape(const ShapeRecord& record);
+
+    // Builders; valid while the file is open
+    void applyWorldSettings(PhysicsWorld& world) const;
+    std::vector<BodyHandle> createBodies(PhysicsWorld& world) const;
+    std::vector<std::unique_ptr<ClothSolver3D>> createCloths(VertletSystem3D& system) const;
+
+    // Raw record arrays, pointing into the mapping
+    const WorldRecord* getWorld() const { return world; }
+    const ShapeRecord* getShapes() const { return shapes; }
+    size_t getShapeCount() const { return shapeCount; }
+    const BodyRecord* getBodies() const { return bodies; }
+    size_t getBodyCount() const { return bodyCount; }
+    const ClothRecord* getCloths() const { return cloths; }
+    size_t getClothCount() const { return clothCount; }
+    const ParticleRecord* getParticles() const { return particles; }
+    size_t getParticleCount() const { return particleCount; }
+    const SpringRecord* getSprings() const { return springs; }
+    size_t getSpringCount() const { return springCount; }
+
+private:
+    core::io::MappedFile file;
+    bool opened = false;
+
+    const WorldRecord* world = nullptr;
+    const ShapeRecord* shapes = nullptr;
+    const BodyRecord* bodies = nullptr;
+    const ClothRecord* cloths = nullptr;
+    const ParticleRecord* particles = nullptr;
+    const SpringRecord* springs = nullptr;
+    size_t shapeCount = 0;
+    size_t bodyCount = 0;
+    size_t clothCount = 0;
+    size_t particleCount = 0;
+    size_t springCount = 0;
+
+    static bool serialize(std::vector<uint8_t>& buffer, const PhysicsWorld& world,
+                          const std::vector<const RigidBody*>& bodies,
+                          const std::vector<const ClothSolver3D*>& cloths, const std::string& sourceName);
+    bool bind(const uint8_t* data, size_t size, const std::string& sourceName);
+};
+
+} // namespace engine::physics
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CollisionShape.hpp"
+#include <algorithm>
+
+namespace engine::physics {
+
+/**
+ * @brief Sphere collision shape
+ * Cheapest shape to test, and the one most bodies in a scene use
+ */
+class SphereShape : public CollisionShape {
+public:
+    explicit SphereShape(float radius);
+
+    // CollisionShape interface
+    ShapeType getType() const override { return ShapeType::Sphere; }
+    BoundingBox getAABB(const Transform& transform) const override;
+    bool raycast(const Ray& ray, const Transform& transform, RaycastHit& hit) const override;
+    glm::vec3 support(const glm::vec3& direction, const Transform& transform) const override;
+    float calculateVolume() const override;
+    glm::mat3 calculateInertiaTensor(float mass) const override;
+
+    // Sphere-specific
+    float getRadius() const { return radius; }
+    void setRadius(float newRadius);
+
+    // Direct sphere-sphere test, faster than going through GJK
+    static bool sphereVsSphere(const SphereShape& a, const Transform& transformA,
+                               const SphereShape& b, const Transform& transformB,
+                               glm::vec3& contactPoint, glm::vec3& normal, float& penetration);
+
+private:
+    float radius;
+};
+
+} // namespace engine::physics
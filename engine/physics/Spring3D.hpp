@@ -12,6 +12,11 @@ public:
     void solve();
     float getCurrentLength() const;
 
+    const std::shared_ptr<Particle3D>& getParticleA() const { return particleA; }
+    const std::shared_ptr<Particle3D>& getParticleB() const { return particleB; }
+    float getStiffness() const { return stiffness; }
+    float getRestLength() const { return restLength; }
+
 private:
     std::shared_ptr<Particle3D> particleA;
     std::shared_ptr<Particle3D> particleB;
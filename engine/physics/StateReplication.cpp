@@ -0,0 +1,327 @@
+#include "StateReplication.hpp"
+#include "../core/BitStream.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace engine::physics {
+
+using core::io::BitReader;
+using core::io::BitWriter;
+
+namespace {
+
+const QuantizedBodyState EmptyState{};
+
+// Round half away from zero; clamped so the conversion is always defined.
+// copysign keeps it branchless, since velocity signs are unpredictable.
+int32_t quantizeValue(float value, float scale) {
+    const float scaled = std::min(std::max(value * scale, -2.0e9f), 2.0e9f);
+    return static_cast<int32_t>(scaled + std::copysign(0.5f, scaled));
+}
+
+// Smallest-three components are at most 1/sqrt(2) in magnitude
+float orientationScale(int bits) {
+    return float((1 << (bits - 1)) - 1) * 1.41421356f;
+}
+
+uint32_t zigzag(uint32_t delta) {
+    const int32_t value = static_cast<int32_t>(delta);
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+uint32_t unzigzag(uint32_t value) {
+    return (value >> 1) ^ (0u - (value & 1u));
+}
+
+constexpr int DeltaClassBits[4] = {0, 7, 14, 32};
+constexpr int GapClassBits[4] = {4, 8, 16, 32};
+
+// Three components sharing one 2-bit width class; deltas wrap, so any int32
+// pair round-trips
+void writeDelta(BitWriter& out, const int32_t* now, const int32_t* base) {
+    uint32_t encoded[3];
+    uint32_t combined = 0;
+    for (int i = 0; i < 3; ++i) {
+        encoded[i] = zigzag(static_cast<uint32_t>(now[i]) - static_cast<uint32_t>(base[i]));
+        combined |= encoded[i];
+    }
+    const uint32_t widthClass = combined == 0 ? 0 : combined < (1u << 7) ? 1 : combined < (1u << 14) ? 2 : 3;
+    out.write(widthClass, 2);
+    if (widthClass == 0) return;
+    for (uint32_t value : encoded) {
+        out.write(value, DeltaClassBits[widthClass]);
+    }
+}
+
+void readDelta(BitReader& in, int32_t* value) {
+    const int bits = DeltaClassBits[in.read(2)];
+    if (bits == 0) return;
+    for (int i = 0; i < 3; ++i) {
+        value[i] = static_cast<int32_t>(static_cast<uint32_t>(value[i]) + unzigzag(in.read(bits)));
+    }
+}
+
+// '1' steps to the next index, '01' + class + (gap - 2) steps further, '00' ends
+void writeGap(BitWriter& out, uint32_t gap) {
+    if (gap == 1) {
+        out.write(1, 1);
+        return;
+    }
+    const uint32_t value = gap - 2;
+    const uint32_t gapClass = value < (1u << 4) ? 0 : value < (1u << 8) ? 1 : value < (1u << 16) ? 2 : 3;
+    out.write(0b10, 2);
+    out.write(gapClass, 2);
+    out.write(value, GapClassBits[gapClass]);
+}
+
+} // namespace
+
+// ============================================================================
+// Encoder
+// ============================================================================
+
+StateReplicationEncoder::StateReplicationEncoder(const ReplicationSettings& settings)
+    : settings(settings), history(settings.historySize) {}
+
+QuantizedBodyState StateReplicationEncoder::quantize(const RigidBody& body, const ReplicationSettings& settings) {
+    QuantizedBodyState state{};
+    state.present = 1;
+    state.sleeping = body.isSleeping() ? 1 : 0;
+
+    const float positionScale = 1.0f / settings.positionResolution;
+    const glm::vec3& position = body.getPosition();
+    state.position[0] = quantizeValue(position.x, positionScale);
+    state.position[1] = quantizeValue(position.y, positionScale);
+    state.position[2] = quantizeValue(position.z, positionScale);
+
+    const glm::quat& orientation = body.getOrientation();
+    const float components[4] = {orientation.w, orientation.x, orientation.y, orientation.z};
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (std::fabs(components[i]) > std::fabs(components[largest])) largest = i;
+    }
+    // q and -q are the same rotation; flip so the dropped component is positive
+    const float scale = orientationScale(settings.orientationBits) * (components[largest] < 0.0f ? -1.0f : 1.0f);
+    for (int i = 0, out = 0; i < 4; ++i) {
+        if (i != largest) state.orientation[out++] = quantizeValue(components[i], scale);
+    }
+    state.largestComponent = static_cast<uint8_t>(largest);
+
+    // Sleeping bodies replicate as at rest, so their records stop changing
+    if (!state.sleeping) {
+        const float velocityScale = 1.0f / settings.velocityResolution;
+        const glm::vec3& linearVelocity = body.getLinearVelocity();
+        const glm::vec3& angularVelocity = body.getAngularVelocity();
+        state.linearVelocity[0] = quantizeValue(linearVelocity.x, velocityScale);
+        state.linearVelocity[1] = quantizeValue(linearVelocity.y, velocityScale);
+        state.linearVelocity[2] = quantizeValue(linearVelocity.z, velocityScale);
+        state.angularVelocity[0] = quantizeValue(angularVelocity.x, velocityScale);
+        state.angularVelocity[1] = quantizeValue(angularVelocity.y, velocityScale);
+        state.angularVelocity[2] = quantizeValue(angularVelocity.z, velocityScale);
+    }
+    return state;
+}
+
+uint32_t StateReplicationEncoder::capture(const PhysicsWorld& world) {
+    const ReplicationSnapshot* previous = history.find(latestSequence);
+
+    const uint32_t sequence = nextSequence;
+    nextSequence = nextSequence + 1 == ReplicationSnapshot::NoSequence ? 0 : nextSequence + 1;
+
+    // Handle indices are dense from zero, so the previous table size is a
+    // good guess; the table only grows when a body lands past it
+    const size_t previousSize = previous ? previous->bodies.size() : 0;
+    ReplicationSnapshot& snapshot = history.acquire(sequence);
+    snapshot.bodies.assign(previousSize, EmptyState);
+
+    size_t tableSize = 0;
+    for (const RigidBody* body : world.getRigidBodies()) {
+        const uint32_t index = body->getHandle().index;
+        if (index >= snapshot.bodies.size()) {
+            snapshot.bodies.resize(std::max<size_t>(index + 1, snapshot.bodies.size() * 2), EmptyState);
+        }
+        tableSize = std::max<size_t>(tableSize, index + 1);
+
+        if (body->isSleeping() && index < previousSize && previous->bodies[index].sleeping) {
+            snapshot.bodies[index] = previous->bodies[index];
+        } else {
+            snapshot.bodies[index] = quantize(*body, settings);
+        }
+    }
+    snapshot.bodies.resize(tableSize);
+
+    latestSequence = sequence;
+    return sequence;
+}
+
+void StateReplicationEncoder::encode(std::vector<uint8_t>& buffer, uint32_t baselineSequence) const {
+    lastEntryCount = 0;
+    const ReplicationSnapshot* current = history.find(latestSequence);
+    if (!current) return;
+    const ReplicationSnapshot* baseline = history.find(baselineSequence);
+
+    const uint32_t tableSize = static_cast<uint32_t>(current->bodies.size());
+    const uint32_t baselineSize = baseline ? static_cast<uint32_t>(baseline->bodies.size()) : 0;
+    const uint32_t count = std::max(tableSize, baselineSize);
+
+    // Enough for every body changing by a small delta, so growth is rare
+    buffer.reserve(buffer.size() + 16 + size_t(count) * 8);
+    BitWriter out(buffer);
+    out.write(current->sequence, 32);
+    out.write(baseline ? baseline->sequence : ReplicationSnapshot::NoSequence, 32);
+    out.write(tableSize, 32);
+
+    uint32_t previousIndex = ~0u;   // First gap is index + 1
+    for (uint32_t i = 0; i < count; ++i) {
+        const QuantizedBodyState& now = i < tableSize ? current->bodies[i] : EmptyState;
+        const QuantizedBodyState& base = i < baselineSize ? baseline->bodies[i] : EmptyState;
+        if ((!now.present && !base.present) || std::memcmp(&now, &base, sizeof(QuantizedBodyState)) == 0) {
+            continue;
+        }
+
+        writeGap(out, i - previousIndex);
+        previousIndex = i;
+        ++lastEntryCount;
+
+        out.writeBool(!now.present);
+        if (!now.present) continue;
+
+        out.writeBool(now.sleeping != 0);
+        out.write(now.largestComponent, 2);
+        writeDelta(out, now.position, base.position);
+        writeDelta(out, now.orientation, base.orientation);
+        if (!now.sleeping) {
+            writeDelta(out, now.linearVelocity, base.linearVelocity);
+            writeDelta(out, now.angularVelocity, base.angularVelocity);
+        }
+    }
+    out.write(0, 2);
+    out.finish();
+}
+
+// ============================================================================
+// Decoder
+// ============================================================================
+
+StateReplicationDecoder::StateReplicationDecoder(const ReplicationSettings& settings)
+    : settings(settings), history(settings.historySize) {}
+
+bool StateReplicationDecoder::decode(const uint8_t* data, size_t size) {
+    BitReader in(data, size);
+    const uint32_t sequence = in.read(32);
+    const uint32_t baselineSequence = in.read(32);
+    const uint32_t tableSize = in.read(32);
+    if (!in.ok() || sequence == ReplicationSnapshot::NoSequence) return false;
+
+    // Too late to keep: its ring slot belongs to a newer snapshot
+    if (latestSequence != ReplicationSnapshot::NoSequence &&
+        static_cast<int32_t>(latestSequence - sequence) >= static_cast<int32_t>(history.getSize())) {
+        return false;
+    }
+
+    const ReplicationSnapshot* baseline = nullptr;
+    if (baselineSequence != ReplicationSnapshot::NoSequence) {
+        baseline = history.find(baselineSequence);
+        // The new snapshot must not land on top of its own baseline
+        if (!baseline || sequence % history.getSize() == baselineSequence % history.getSize()) return false;
+    }
+    const uint32_t baselineSize = baseline ? static_cast<uint32_t>(baseline->bodies.size()) : 0;
+    // The table is the sender's slot count, mostly empty slots after
+    // removals, so only an absolute cap keeps a bad packet from claiming
+    // unbounded memory
+    if (tableSize > settings.maxTableSize) return false;
+
+    // Built aside and committed only once the whole packet has decoded, so a
+    // bad packet cannot clobber a baseline
+    ReplicationSnapshot& snapshot = scratch;
+    snapshot.bodies.assign(tableSize, EmptyState);
+    if (baseline) {
+        std::copy_n(baseline->bodies.begin(), std::min(tableSize, baselineSize), snapshot.bodies.begin());
+    }
+
+    const uint32_t count = std::max(tableSize, baselineSize);
+    uint32_t index = ~0u;
+    for (;;) {
+        uint32_t gap = 1;
+        if (!in.readBool()) {
+            if (!in.readBool()) break;
+            gap = in.read(GapClassBits[in.read(2)]) + 2;
+        }
+        index += gap;
+        if (!in.ok() || index >= count) return false;
+
+        if (in.readBool()) {
+            if (index < tableSize) snapshot.bodies[index] = EmptyState;
+            continue;
+        }
+        if (index >= tableSize) return false;
+
+        QuantizedBodyState& state = snapshot.bodies[index];
+        state.present = 1;
+        state.sleeping = in.readBool() ? 1 : 0;
+        state.largestComponent = static_cast<uint8_t>(in.read(2));
+        readDelta(in, state.position);
+        readDelta(in, state.orientation);
+        if (state.sleeping) {
+            std::fill(std::begin(state.linearVelocity), std::end(state.linearVelocity), 0);
+            std::fill(std::begin(state.angularVelocity), std::end(state.angularVelocity), 0);
+        } else {
+            readDelta(in, state.linearVelocity);
+            readDelta(in, state.angularVelocity);
+        }
+    }
+    if (!in.ok()) return false;
+
+    // Swapping hands the slot's old storage to the next decode
+    history.acquire(sequence).bodies.swap(snapshot.bodies);
+
+    // Late packets still become baselines but never replace a newer latest
+    if (latestSequence == ReplicationSnapshot::NoSequence || static_cast<int32_t>(sequence - latestSequence) > 0) {
+        latestSequence = sequence;
+    }
+    return true;
+}
+
+void StateReplicationDecoder::dequantize(const QuantizedBodyState& state, const ReplicationSettings& settings,
+                                         glm::vec3& position, glm::quat& orientation,
+                                         glm::vec3& linearVelocity, glm::vec3& angularVelocity) {
+    for (int i = 0; i < 3; ++i) {
+        position[i] = float(state.position[i]) * settings.positionResolution;
+        linearVelocity[i] = float(state.linearVelocity[i]) * settings.velocityResolution;
+        angularVelocity[i] = float(state.angularVelocity[i]) * settings.velocityResolution;
+    }
+
+    const float inverseScale = 1.0f / orientationScale(settings.orientationBits);
+    float components[4];
+    float sumSquares = 0.0f;
+    for (int i = 0, in = 0; i < 4; ++i) {
+        if (i == state.largestComponent) continue;
+        components[i] = float(state.orientation[in++]) * inverseScale;
+        sumSquares += components[i] * components[i];
+    }
+    components[state.largestComponent] = std::sqrt(std::max(0.0f, 1.0f - sumSquares));
+    orientation = glm::normalize(glm::quat(components[0], components[1], components[2], components[3]));
+}
+
+void StateReplicationDecoder::apply(PhysicsWorld& world) const {
+    const ReplicationSnapshot* latest = getLatest();
+    if (!latest) return;
+
+    glm::vec3 position, linearVelocity, angularVelocity;
+    glm::quat orientation;
+    for (RigidBody* body : world.getRigidBodies()) {
+        const uint32_t index = body->getHandle().index;
+        if (index >= latest->bodies.size() || !latest->bodies[index].present) continue;
+
+        const QuantizedBodyState& state = latest->bodies[index];
+        dequantize(state, settings, position, orientation, linearVelocity, angularVelocity);
+        body->setPosition(position);
+        body->setOrientation(orientation);
+        body->setLinearVelocity(linearVelocity);
+        body->setAngularVelocity(angularVelocity);
+        body->setSleeping(state.sleeping != 0);
+    }
+}
+
+} // namespace engine::physics
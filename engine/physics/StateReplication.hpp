@@ -0,0 +1,153 @@
+#pragma once
+#include "PhysicsWorld.hpp"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+/**
+ * @brief Quantization shared by both ends of a replication stream
+ * The encoder and decoder must be built with the same settings; they are
+ * not sent on the wire.
+ */
+struct ReplicationSettings {
+    float positionResolution = 1.0f / 512.0f;   // Metres per grid step
+    float velocityResolution = 1.0f / 256.0f;   // m/s and rad/s per step
+    int orientationBits = 12;                   // Per smallest-three component, 2 to 16
+    uint32_t historySize = 32;                  // Snapshots kept as possible baselines
+    uint32_t maxTableSize = 1u << 20;           // Largest body table a decoder accepts
+};
+
+/**
+ * @brief One body's motion state on the quantization grid
+ * Equal records mean there is nothing to send. Orientation is stored as the
+ * three smallest quaternion components; the largest is dropped, made
+ * positive and rebuilt from the unit length on decode.
+ */
+struct QuantizedBodyState {
+    int32_t position[3];
+    int32_t orientation[3];
+    int32_t linearVelocity[3];
+    int32_t angularVelocity[3];
+    uint8_t largestComponent;                   // Dropped component: 0 w, 1 x, 2 y, 3 z
+    uint8_t sleeping;
+    uint8_t present;
+    uint8_t reserved;
+};
+
+struct ReplicationSnapshot {
+    static constexpr uint32_t NoSequence = 0xFFFFFFFFu;
+
+    uint32_t sequence = NoSequence;
+    std::vector<QuantizedBodyState> bodies;     // By body handle index
+};
+
+/**
+ * @brief Ring of recent snapshots, looked up by sequence
+ */
+class ReplicationHistory {
+public:
+    // At least two entries, so a new snapshot never overwrites the one before it
+    explicit ReplicationHistory(uint32_t size) : snapshots(size > 2 ? size : 2) {}
+
+    uint32_t getSize() const { return static_cast<uint32_t>(snapshots.size()); }
+
+    const ReplicationSnapshot* find(uint32_t sequence) const {
+        if (sequence == ReplicationSnapshot::NoSequence) return nullptr;
+        const ReplicationSnapshot& snapshot = snapshots[sequence % snapshots.size()];
+        return snapshot.sequence == sequence ? &snapshot : nullptr;
+    }
+
+    // Storage for sequence, overwriting whatever held its ring slot
+    ReplicationSnapshot& acquire(uint32_t sequence) {
+        ReplicationSnapshot& snapshot = snapshots[sequence % snapshots.size()];
+        snapshot.sequence = sequence;
+        return snapshot;
+    }
+
+private:
+    std::vector<ReplicationSnapshot> snapshots;
+};
+
+/**
+ * @brief Server side of snapshot replication
+ *
+ * capture() quantizes the world once per tick. encode() then writes that
+ * snapshot for one client as a delta against the newest snapshot the client
+ * acknowledged, so each client costs one compare pass plus the bits for
+ * what actually changed. Bodies are keyed by handle index; creating and
+ * destroying the matching bodies on the client is left to the caller.
+ *
+ * Bit layout, least significant bit first: sequence, baseline sequence and
+ * body table size (32 bits each), then one entry per changed body and a
+ * terminator. Each entry starts with a gap code ('1' for the next index,
+ * '01' plus a length class for a larger step, '00' ends the list), a removed
+ * bit, a sleeping bit and the 2-bit dropped quaternion component. Position,
+ * orientation and, for awake bodies, both velocities follow as vectors of
+ * zigzag deltas from the baseline, each prefixed by a 2-bit class:
+ * unchanged, 7, 14 or 32 bits per component. Bodies asleep and unchanged
+ * since the baseline are skipped entirely.
+ */
+class StateReplicationEncoder {
+public:
+    explicit StateReplicationEncoder(const ReplicationSettings& settings = ReplicationSettings());
+
+    // Quantizes every body into a new snapshot and returns its sequence.
+    // Bodies still asleep since the last capture reuse their record.
+    uint32_t capture(const PhysicsWorld& world);
+
+    // Appends the latest capture to buffer, delta encoded against
+    // baselineSequence. A baseline of NoSequence, or one that has left the
+    // history, sends every present body in full.
+    void encode(std::vector<uint8_t>& buffer, uint32_t baselineSequence) const;
+
+    uint32_t getLatestSequence() const { return latestSequence; }
+    size_t getLastEntryCount() const { return lastEntryCount; }
+
+    static QuantizedBodyState quantize(const RigidBody& body, const ReplicationSettings& settings);
+
+private:
+    ReplicationSettings settings;
+    ReplicationHistory history;
+    uint32_t latestSequence = ReplicationSnapshot::NoSequence;
+    uint32_t nextSequence = 0;
+    mutable size_t lastEntryCount = 0;
+};
+
+/**
+ * @brief Client side of snapshot replication
+ * Rebuilds each received snapshot from its baseline and keeps it as a
+ * future baseline. The sequence returned by getLatestSequence() is what to
+ * acknowledge to the server.
+ */
+class StateReplicationDecoder {
+public:
+    explicit StateReplicationDecoder(const ReplicationSettings& settings = ReplicationSettings());
+
+    // False on a malformed packet, one whose baseline is no longer held, or
+    // one older than anything the history keeps. A rejected packet leaves
+    // the history untouched.
+    bool decode(const uint8_t* data, size_t size);
+
+    uint32_t getLatestSequence() const { return latestSequence; }
+    const ReplicationSnapshot* getLatest() const { return history.find(latestSequence); }
+
+    // Sets pose, velocities and sleep state of every body in world whose
+    // handle index has replicated state in the latest snapshot
+    void apply(PhysicsWorld& world) const;
+
+    static void dequantize(const QuantizedBodyState& state, const ReplicationSettings& settings,
+                           glm::vec3& position, glm::quat& orientation,
+                           glm::vec3& linearVelocity, glm::vec3& angularVelocity);
+
+private:
+    ReplicationSettings settings;
+    ReplicationHistory history;
+    ReplicationSnapshot scratch;                // Decode target, swapped into the history on success
+    uint32_t latestSequence = ReplicationSnapshot::NoSequence;
+};
+
+} // namespace engine::physics
@@ -14,7 +14,19 @@ void VertletSystem3D::addConstraint(const std::shared_ptr<Constraint3D>& constra
     constraints.push_back(constraint);
 }
 
+void VertletSystem3D::reserve(size_t extraParticles, size_t extraSprings) {
+    particles.reserve(particles.size() + extraParticles);
+    springs.reserve(springs.size() + extraSprings);
+}
+
 void VertletSystem3D::update(float dt, const glm::vec3& gravity, int solverIterations) {
+    step(particles, springs, constraints, dt, gravity, solverIterations, 0.98f); // Damping coefficient here
+}
+
+void VertletSystem3D::step(const std::vector<std::shared_ptr<Particle3D>>& particles,
+                           const std::vector<std::shared_ptr<Spring3D>>& springs,
+                           const std::vector<std::shared_ptr<Constraint3D>>& constraints,
+                           float dt, const glm::vec3& gravity, int solverIterations, float damping) {
     // Step 1: Apply gravity
     for (auto& particle : particles) {
         if (!particle->isPinned())
@@ -23,7 +35,7 @@ void VertletSystem3D::update(float dt, const glm::vec3& gravity, int solverItera
 
     // Step 2: Integrate motion
     for (auto& particle : particles) {
-        particle->integrate(dt, 0.98f); // Damping coefficient here
+        particle->integrate(dt, damping);
     }
 
     // Step 3: Solve springs and constraints
@@ -15,12 +15,23 @@ public:
     void addSpring(const std::shared_ptr<Spring3D>& spring);
     void addConstraint(const std::shared_ptr<Constraint3D>& constraint);
 
+    // Room for this many more particles and springs, for bulk adds
+    void reserve(size_t extraParticles, size_t extraSprings);
+
     void update(float dt, const glm::vec3& gravity, int solverIterations = 5);
 
     const std::vector<std::shared_ptr<Particle3D>>& getParticles() const;
     const std::vector<std::shared_ptr<Spring3D>>& getSprings() const;
     const std::vector<std::shared_ptr<Constraint3D>>& getConstraints() const;
 
+protected:
+    // One step over any set of particles, springs and constraints;
+    // update() runs it over everything registered
+    static void step(const std::vector<std::shared_ptr<Particle3D>>& particles,
+                     const std::vector<std::shared_ptr<Spring3D>>& springs,
+                     const std::vector<std::shared_ptr<Constraint3D>>& constraints,
+                     float dt, const glm::vec3& gravity, int solverIterations, float damping);
+
 private:
     std::vector<std::shared_ptr<Particle3D>> particles;
     std::vector<std::shared_ptr<Spring3D>> springs;
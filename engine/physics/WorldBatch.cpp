@@ -0,0 +1,65 @@
+#include "WorldBatch.hpp"
+
+namespace engine::physics {
+
+PhysicsWorld::Settings WorldBatch::smallWorldSettings() {
+    PhysicsWorld::Settings settings;
+    settings.expectedBodies = 64;
+    settings.frameArenaBytes = 16 * 1024;
+    return settings;
+}
+
+WorldBatch::WorldBatch(size_t worldCount, const WorldSetup& setup,
+                       const PhysicsWorld::Settings& settings, size_t threadCount)
+    : pool(threadCount) {
+    worlds.reserve(worldCount);
+    for (size_t i = 0; i < worldCount; ++i) {
+        worlds.push_back(std::make_unique<PhysicsWorld>(settings));
+    }
+
+    // Population is independent per world too
+    if (setup) {
+        forEachWorld(setup);
+    }
+    worldOffsets.assign(worldCount + 1, 0);
+}
+
+void WorldBatch::step(float dt, int steps) {
+    pool.parallelFor(worlds.size(), [&](size_t index) {
+        PhysicsWorld& world = *worlds[index];
+        for (int i = 0; i < steps; ++i) {
+            world.update(dt);
+        }
+    });
+}
+
+void WorldBatch::forEachWorld(const std::function<void(PhysicsWorld& world, size_t worldIndex)>& fn) {
+    pool.parallelFor(worlds.size(), [&](size_t index) {
+        fn(*worlds[index], index);
+    });
+}
+
+void WorldBatch::gatherResults() {
+    // Offsets first so every world can then write its own range concurrently
+    worldOffsets[0] = 0;
+    for (size_t i = 0; i < worlds.size(); ++i) {
+        worldOffsets[i + 1] = worldOffsets[i] + worlds[i]->getRigidBodies().size();
+    }
+
+    const size_t total = worldOffsets.back();
+    positions.resize(total);
+    orientations.resize(total);
+    linearVelocities.resize(total);
+
+    pool.parallelFor(worlds.size(), [&](size_t index) {
+        const std::vector<RigidBody*>& bodies = worlds[index]->getRigidBodies();
+        const size_t offset = worldOffsets[index];
+        for (size_t j = 0; j < bodies.size(); ++j) {
+            positions[offset + j] = bodies[j]->getPosition();
+            orientations[offset + j] = bodies[j]->getOrientation();
+            linearVelocities[offset + j] = bodies[j]->getLinearVelocity();
+        }
+    });
+}
+
+} // namespace engine::physics
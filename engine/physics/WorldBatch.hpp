@@ -0,0 +1,64 @@
+#pragma once
+#include "PhysicsWorld.hpp"
+#include "../core/ThreadPool.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace engine::physics {
+
+/**
+ * @brief Many independent worlds stepped together across cores
+ * Intended for headless sweeps and rollouts. Worlds never interact, so each
+ * step is one parallel loop over worlds with no synchronisation inside it.
+ * Collision shapes are immutable during simulation and may be shared by
+ * bodies in every world; only per-body state is duplicated.
+ *
+ * Results are gathered world-major into flat arrays: body j of world i is at
+ * getWorldOffset(i) + j, in the world's dense body order.
+ */
+class WorldBatch {
+public:
+    using WorldSetup = std::function<void(PhysicsWorld& world, size_t worldIndex)>;
+
+    // threadCount 0 uses every hardware core
+    WorldBatch(size_t worldCount, const WorldSetup& setup,
+               const PhysicsWorld::Settings& settings = smallWorldSettings(), size_t threadCount = 0);
+
+    size_t size() const { return worlds.size(); }
+    PhysicsWorld& getWorld(size_t index) { return *worlds[index]; }
+    const PhysicsWorld& getWorld(size_t index) const { return *worlds[index]; }
+
+    // Advances every world by dt, repeated steps times
+    void step(float dt, int steps = 1);
+
+    // Runs fn on every world in parallel
+    void forEachWorld(const std::function<void(PhysicsWorld& world, size_t worldIndex)>& fn);
+
+    // Copies body state out of every world into the flat result arrays
+    void gatherResults();
+
+    const std::vector<glm::vec3>& getPositions() const { return positions; }
+    const std::vector<glm::quat>& getOrientations() const { return orientations; }
+    const std::vector<glm::vec3>& getLinearVelocities() const { return linearVelocities; }
+    size_t getWorldOffset(size_t worldIndex) const { return worldOffsets[worldIndex]; }
+    size_t getWorldBodyCount(size_t worldIndex) const {
+        return worldOffsets[worldIndex + 1] - worldOffsets[worldIndex];
+    }
+
+    size_t getThreadCount() const { return pool.getThreadCount(); }
+
+    // Small initial reservations; worlds grow as bodies are added
+    static PhysicsWorld::Settings smallWorldSettings();
+
+private:
+    core::threading::ThreadPool pool;
+    std::vector<std::unique_ptr<PhysicsWorld>> worlds;
+
+    std::vector<size_t> worldOffsets;   // size() + 1 entries
+    std::vector<glm::vec3> positions;
+    std::vector<glm::quat> orientations;
+    std::vector<glm::vec3> linearVelocities;
+};
+
+} // namespace engine::physics
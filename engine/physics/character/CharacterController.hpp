@@ -42,6 +42,7 @@ public:
     glm::vec3 getVelocity() const;
     glm::vec3 getGroundNormal() const { return groundInfo.normal; }
     float getGroundDistance() const { return groundInfo.distance; }
+    const std::shared_ptr<RigidBody>& getRigidBody() const { return rigidBody; }
     
     // Configuration
     void setStepHeight(float height) { stepHeight = glm::max(0.0f, height); }
@@ -3,6 +3,69 @@
 
 namespace engine::physics {
 
+size_t BroadPhase::queryRegion(const glm::vec3& min, const glm::vec3& max, RigidBody** results, size_t capacity,
+                               const QueryFilter& filter) {
+    size_t count = 0;
+    if (capacity == 0) return 0;
+    queryRegion(min, max, [&](RigidBody* body) {
+        results[count++] = body;
+        return count < capacity;
+    }, filter);
+    return count;
+}
+
+size_t BroadPhase::queryPoint(const glm::vec3& point, RigidBody** results, size_t capacity,
+                              const QueryFilter& filter) {
+    size_t count = 0;
+    if (capacity == 0) return 0;
+    queryPoint(point, [&](RigidBody* body) {
+        results[count++] = body;
+        return count < capacity;
+    }, filter);
+    return count;
+}
+
+std::vector<RigidBody*> BroadPhase::queryRegion(const glm::vec3& min, const glm::vec3& max) {
+    std::vector<RigidBody*> result;
+    queryRegion(min, max, [&](RigidBody* body) {
+        result.push_back(body);
+        return true;
+    });
+    return result;
+}
+
+std::vector<RigidBody*> BroadPhase::queryPoint(const glm::vec3& point) {
+    std::vector<RigidBody*> result;
+    queryPoint(point, [&](RigidBody* body) {
+        result.push_back(body);
+        return true;
+    });
+    return result;
+}
+
+std::vector<NearestHit> BroadPhase::queryNearest(const glm::vec3& point, size_t k, const QueryFilter& filter) {
+    std::vector<NearestHit> result(k);
+    result.resize(queryNearest(point, k, result.data(), filter));
+    return result;
+}
+
+RigidBody* BroadPhase::queryClosest(const glm::vec3& point, const QueryFilter& filter) {
+    NearestHit hit;
+    return queryNearest(point, 1, &hit, filter) > 0 ? hit.body : nullptr;
+}
+
+void BroadPhase::insertBodies(const std::vector<RigidBody*>& bodies) {
+    for (RigidBody* body : bodies) {
+        insertBody(body);
+    }
+}
+
+void BroadPhase::removeBodies(const std::vector<RigidBody*>& bodies) {
+    for (RigidBody* body : bodies) {
+        removeBody(body);
+    }
+}
+
 bool BroadPhase::shouldTestPair(RigidBody* bodyA, RigidBody* bodyB) const {
     if (!bodyA || !bodyB || bodyA == bodyB) {
         return false;
@@ -14,6 +77,11 @@ bool BroadPhase::shouldTestPair(RigidBody* bodyA, RigidBody* bodyB) const {
         return false;
     }
     
+    // Respect layer/mask/group filtering
+    if (!bodyA->getCollisionFilter().canCollide(bodyB->getCollisionFilter())) {
+        return false;
+    }
+    
     // Don't test two sleeping bodies
     if (bodyA->isSleeping() && bodyB->isSleeping()) {
         return false;
@@ -1,4 +1,9 @@
 #pragma once
+#include "CollisionFilter.hpp"
+#include "../../core/FunctionRef.hpp"
+#include <glm/glm.hpp>
+#include <atomic>
+#include <functional>
 #include <vector>
 #include <memory>
 #include <string>
@@ -35,6 +40,30 @@ struct CollisionPair {
     }
 };
 
+} // namespace engine::physics
+
+namespace std {
+template<>
+struct hash<engine::physics::CollisionPair> {
+    size_t operator()(const engine::physics::CollisionPair& pair) const {
+        size_t h = std::hash<engine::physics::RigidBody*>()(pair.bodyA);
+        return h ^ (std::hash<engine::physics::RigidBody*>()(pair.bodyB) + 0x9e3779b9 + (h << 6) + (h >> 2));
+    }
+};
+} // namespace std
+
+namespace engine::physics {
+
+/**
+ * @brief Result of a nearest-body query
+ * Distance is measured from the query point to the body's proxy AABB and is
+ * zero when the point lies inside it.
+ */
+struct NearestHit {
+    RigidBody* body = nullptr;
+    float distance = 0.0f;
+};
+
 /**
  * @brief Base class for broad phase collision detection algorithms
  */
@@ -48,10 +77,40 @@ public:
     virtual void updateBody(RigidBody* body) = 0;
     virtual void updateAllBodies() = 0;
     
-    // Collision detection
-    virtual std::vector<CollisionPair> findPotentialCollisions() = 0;
-    virtual std::vector<RigidBody*> queryRegion(const glm::vec3& min, const glm::vec3& max) = 0;
-    virtual std::vector<RigidBody*> queryPoint(const glm::vec3& point) = 0;
+    // Batch variants; implementations may restructure once instead of per body
+    virtual void insertBodies(const std::vector<RigidBody*>& bodies);
+    virtual void removeBodies(const std::vector<RigidBody*>& bodies);
+    
+    // Collision detection; pairs are written into the caller's vector so its capacity is reused
+    virtual void findPotentialCollisions(std::vector<CollisionPair>& pairs) = 0;
+    
+    // Spatial queries against proxy AABBs. Each body is visited at most once;
+    // the visitor returns false to stop the query early. Queries only read the
+    // broad phase, so they may run on several threads at once and nest inside
+    // a visitor, but not alongside an update.
+    using BodyVisitor = core::FunctionRef<bool(RigidBody*)>;
+    virtual void queryRegion(const glm::vec3& min, const glm::vec3& max, BodyVisitor visitor,
+                             const QueryFilter& filter = QueryFilter{}) = 0;
+    virtual void queryPoint(const glm::vec3& point, BodyVisitor visitor,
+                            const QueryFilter& filter = QueryFilter{}) = 0;
+    
+    // Buffer variants write up to capacity bodies and return how many were written
+    size_t queryRegion(const glm::vec3& min, const glm::vec3& max, RigidBody** results, size_t capacity,
+                       const QueryFilter& filter = QueryFilter{});
+    size_t queryPoint(const glm::vec3& point, RigidBody** results, size_t capacity,
+                      const QueryFilter& filter = QueryFilter{});
+    
+    // Convenience variants returning a new vector
+    std::vector<RigidBody*> queryRegion(const glm::vec3& min, const glm::vec3& max);
+    std::vector<RigidBody*> queryPoint(const glm::vec3& point);
+    
+    // Up to k bodies closest to the point, written to results in increasing
+    // distance order; returns how many were found
+    virtual size_t queryNearest(const glm::vec3& point, size_t k, NearestHit* results,
+                                const QueryFilter& filter = QueryFilter{}) = 0;
+    std::vector<NearestHit> queryNearest(const glm::vec3& point, size_t k,
+                                         const QueryFilter& filter = QueryFilter{});
+    RigidBody* queryClosest(const glm::vec3& point, const QueryFilter& filter = QueryFilter{});
     
     // Lifecycle
     virtual void clear() = 0;
@@ -67,11 +126,16 @@ public:
         size_t pairsGenerated = 0;
         size_t pairsFiltered = 0;
         float lastUpdateTime = 0.0f;
-        size_t totalQueries = 0;
+        std::atomic<size_t> totalQueries{0};   // Bumped by concurrent queries
     };
     
     const Stats& getStats() const { return stats; }
-    void resetStats() { stats = Stats{}; }
+    void resetStats() {
+        stats.pairsGenerated = 0;
+        stats.pairsFiltered = 0;
+        stats.lastUpdateTime = 0.0f;
+        stats.totalQueries = 0;
+    }
 
 protected:
     Stats stats;
@@ -0,0 +1,90 @@
+#pragma once
+#include "../CollisionShape.hpp"
+#include "../BoxShape.hpp"
+#include "../SphereShape.hpp"
+#include "ContactManifold.hpp"
+#include "../../core/FrameArena.hpp"
+#include <vector>
+
+namespace engine::physics {
+
+class CapsuleShape;
+
+/**
+ * @brief Narrow phase: exact contact generation between shape pairs
+ * Stateless; contacts are written into the caller's manifold with the
+ * normal pointing from A to B.
+ *
+ * Boxes meet convex hulls as 8-vertex hulls. Any pair with a cylinder or
+ * cone is unsupported: it reports no contact and logs a warning the first
+ * time each pair of types is seen.
+ */
+class CollisionDetector {
+public:
+    // Body pair entry point used by the world; resets the manifold
+    static bool detectCollision(RigidBody* bodyA, RigidBody* bodyB, ContactManifold& manifold);
+
+    // Shape pair dispatch; appends to the manifold without clearing it
+    static bool detectShapes(const CollisionShape& shapeA, const Transform& transformA,
+                             const CollisionShape& shapeB, const Transform& transformB,
+                             ContactManifold& manifold);
+
+    // Configuration
+    static float getContactTolerance() { return contactTolerance; }
+    static void setContactTolerance(float tolerance) { contactTolerance = tolerance; }
+    static int getMaxContactPoints() { return maxContactPoints; }
+    static void setMaxContactPoints(int count) { maxContactPoints = count; }
+
+private:
+    static float contactTolerance;
+    static int maxContactPoints;
+
+    // Primitive pairs
+    static bool sphereVsSphere(const SphereShape& sphereA, const Transform& transformA,
+                               const SphereShape& sphereB, const Transform& transformB,
+                               ContactManifold& manifold);
+    static bool boxVsBox(const BoxShape& boxA, const Transform& transformA,
+                         const BoxShape& boxB, const Transform& transformB,
+                         ContactManifold& manifold);
+    static bool sphereVsBox(const SphereShape& sphere, const Transform& sphereTransform,
+                            const BoxShape& box, const Transform& boxTransform,
+                            bool sphereIsA, ContactManifold& manifold);
+
+    // Capsule pairs: closed form on segment closest points, 1-2 contacts
+    static bool capsuleVsSphere(const CapsuleShape& capsule, const Transform& capsuleTransform,
+                                const SphereShape& sphere, const Transform& sphereTransform,
+                                bool capsuleIsA, ContactManifold& manifold);
+    static bool capsuleVsCapsule(const CapsuleShape& capsuleA, const Transform& transformA,
+                                 const CapsuleShape& capsuleB, const Transform& transformB,
+                                 ContactManifold& manifold);
+    static bool capsuleVsBox(const CapsuleShape& capsule, const Transform& capsuleTransform,
+                             const BoxShape& box, const Transform& boxTransform,
+                             bool capsuleIsA, ContactManifold& manifold);
+
+    // SAT helpers
+    static bool testSeparatingAxis(const glm::vec3& axis,
+                                   const core::memory::FrameVector<glm::vec3>& verticesA,
+                                   const core::memory::FrameVector<glm::vec3>& verticesB,
+                                   float& separation);
+    static void getBoxVertices(const BoxShape& box, const Transform& transform,
+                               core::memory::FrameVector<glm::vec3>& vertices);
+    static void getBoxAxes(const Transform& transform, core::memory::FrameVector<glm::vec3>& axes);
+    static void calculateBoxBoxContacts(const BoxShape& boxA, const Transform& transformA,
+                                        const BoxShape& boxB, const Transform& transformB,
+                                        const glm::vec3& normal, float separation,
+                                        ContactManifold& manifold);
+    static void clipFaceAgainstPlane(const core::memory::FrameVector<glm::vec3>& inputVertices,
+                                     const glm::vec3& planeNormal, float planeDistance,
+                                     core::memory::FrameVector<glm::vec3>& outputVertices);
+
+    // Geometry utilities
+    static glm::vec3 closestPointOnBox(const glm::vec3& point, const BoxShape& box,
+                                       const Transform& transform);
+    static float pointToPlaneDistance(const glm::vec3& point, const glm::vec3& planeNormal,
+                                      const glm::vec3& planePoint);
+    static void generateContactPoints(const core::memory::FrameVector<glm::vec3>& points,
+                                      const glm::vec3& normal, float separation,
+                                      ContactManifold& manifold);
+};
+
+} // namespace engine::physics
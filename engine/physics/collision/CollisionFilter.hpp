@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+
+namespace engine::physics {
+
+/**
+ * @brief Layer/mask/group bits deciding which bodies may collide
+ *
+ * Two bodies collide only if each one's layer is in the other's mask.
+ * Bodies sharing a non-zero group never collide with each other, which
+ * covers cases like a projectile ignoring the body that fired it.
+ */
+struct CollisionFilter {
+    static constexpr uint32_t AllLayers = 0xFFFFFFFFu;
+    static constexpr uint32_t DefaultLayer = 0x00000001u;
+    static constexpr uint32_t NoGroup = 0;
+
+    uint32_t layer = DefaultLayer;   // Layers this body belongs to
+    uint32_t mask = AllLayers;       // Layers this body collides with
+    uint32_t group = NoGroup;        // Bodies in the same non-zero group skip each other
+
+    // Written with bitwise operators so the test compiles without branches
+    bool canCollide(const CollisionFilter& other) const {
+        const bool layersMatch = ((layer & other.mask) != 0) & ((other.layer & mask) != 0);
+        const bool groupsDiffer = (group == NoGroup) | (group != other.group);
+        return layersMatch & groupsDiffer;
+    }
+};
+
+/**
+ * @brief Which bodies a spatial query reports
+ * A body passes if its layer is in layerMask and it is not in excludeGroup,
+ * so a character can query around itself without finding its own parts.
+ */
+struct QueryFilter {
+    uint32_t layerMask = CollisionFilter::AllLayers;
+    uint32_t excludeGroup = CollisionFilter::NoGroup;
+
+    bool accepts(const CollisionFilter& filter) const {
+        const bool layerMatches = (filter.layer & layerMask) != 0;
+        const bool groupAllowed = (excludeGroup == CollisionFilter::NoGroup) | (filter.group != excludeGroup);
+        return layerMatches & groupAllowed;
+    }
+};
+
+} // namespace engine::physics
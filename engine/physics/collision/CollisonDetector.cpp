@@ -1,11 +1,532 @@
 #include "CollisionDetector.hpp"
+#include "GeometryUtils.hpp"
 #include "../RigidBody.hpp"
+#include "../shapes/CapsuleShape.hpp"
+#include "../shapes/CompoundShape.hpp"
+#include "../shapes/ConvexHullShape.hpp"
+#include "../shapes/HeightfieldShape.hpp"
+#include "../shapes/TriangleMeshShape.hpp"
 #include "../../core/Logger.hpp"
 #include <algorithm>
+#include <atomic>
 #include <cfloat>
+#include <memory>
+#include <string>
 
 namespace engine::physics {
 
+namespace {
+
+constexpr size_t ShapeTypeCount = static_cast<size_t>(CollisionShape::ShapeType::Compound) + 1;
+
+const char* shapeTypeName(CollisionShape::ShapeType type) {
+    switch (type) {
+        case CollisionShape::ShapeType::Sphere: return "sphere";
+        case CollisionShape::ShapeType::Box: return "box";
+        case CollisionShape::ShapeType::Capsule: return "capsule";
+        case CollisionShape::ShapeType::Cylinder: return "cylinder";
+        case CollisionShape::ShapeType::Cone: return "cone";
+        case CollisionShape::ShapeType::ConvexMesh: return "convex hull";
+        case CollisionShape::ShapeType::ConcaveMesh: return "triangle mesh";
+        case CollisionShape::ShapeType::Heightfield: return "heightfield";
+        case CollisionShape::ShapeType::Compound: return "compound";
+        default: return "unknown";
+    }
+}
+
+// Pairs without a contact generator never collide; say so once per pair of types
+void reportUnsupportedPair(CollisionShape::ShapeType typeA, CollisionShape::ShapeType typeB) {
+    static std::atomic<bool> reported[ShapeTypeCount][ShapeTypeCount] = {};
+    const size_t a = std::min(static_cast<size_t>(typeA), static_cast<size_t>(typeB));
+    const size_t b = std::max(static_cast<size_t>(typeA), static_cast<size_t>(typeB));
+    if (a >= ShapeTypeCount || b >= ShapeTypeCount || reported[a][b].exchange(true, std::memory_order_relaxed)) {
+        return;
+    }
+    engine::core::log::Logger::log(std::string("No collision detection between ") + shapeTypeName(typeA) +
+                                   " and " + shapeTypeName(typeB) + " shapes; the pair will pass through",
+                                   engine::core::log::LogLevel::Warning);
+}
+
+// Writes one contact given a normal pointing from the first shape to the second
+void addOrientedContact(ContactManifold& manifold, bool firstIsA, const glm::vec3& normal,
+                        const glm::vec3& onFirst, const glm::vec3& onSecond, float depth) {
+    if (firstIsA) {
+        manifold.setNormal(normal);
+        manifold.addContact(onFirst, onSecond, depth);
+    } else {
+        manifold.setNormal(-normal);
+        manifold.addContact(onSecond, onFirst, depth);
+    }
+}
+
+// Concave (triangle mesh or heightfield) vs convex: contacts come from the triangles under the convex shape
+template <typename ConcaveShape>
+bool meshVsConvex(const ConcaveShape& mesh, const Transform& meshTransform,
+                  const CollisionShape& other, const Transform& otherTransform,
+                  bool meshIsA, ContactManifold& manifold) {
+    constexpr size_t MaxMeshContacts = 8;
+    MeshContact contacts[MaxMeshContacts];
+    size_t count = 0;
+
+    switch (other.getType()) {
+        case CollisionShape::ShapeType::Sphere: {
+            const auto& sphere = static_cast<const SphereShape&>(other);
+            count = mesh.collideSphere(otherTransform.position, sphere.getRadius(), meshTransform,
+                                       contacts, MaxMeshContacts);
+            break;
+        }
+        case CollisionShape::ShapeType::Box: {
+            const auto& box = static_cast<const BoxShape&>(other);
+            count = mesh.collideBox(box.getHalfExtents(), otherTransform, meshTransform,
+                                    contacts, MaxMeshContacts);
+            break;
+        }
+        case CollisionShape::ShapeType::Capsule: {
+            const auto& capsule = static_cast<const CapsuleShape&>(other);
+            glm::vec3 top, bottom;
+            capsule.getEndpoints(otherTransform, top, bottom);
+            count = mesh.collideCapsule(top, bottom, capsule.getRadius(), meshTransform,
+                                        contacts, MaxMeshContacts);
+            break;
+        }
+        case CollisionShape::ShapeType::ConvexMesh: {
+            count = mesh.collideHull(static_cast<const ConvexHullShape&>(other), otherTransform, meshTransform,
+                                     manifold.getSupportHints().vertex, contacts, MaxMeshContacts);
+            break;
+        }
+        default:
+            reportUnsupportedPair(mesh.getType(), other.getType());
+            return false;
+    }
+
+    if (count == 0) {
+        return false;
+    }
+
+    // The manifold carries a single normal; use the deepest contact's
+    const auto* deepest = std::max_element(contacts, contacts + count,
+        [](const auto& a, const auto& b) { return a.depth < b.depth; });
+    manifold.setNormal(meshIsA ? deepest->normal : -deepest->normal);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (meshIsA) {
+            manifold.addContact(contacts[i].pointOnMesh, contacts[i].pointOnOther, contacts[i].depth);
+        } else {
+            manifold.addContact(contacts[i].pointOnOther, contacts[i].pointOnMesh, contacts[i].depth);
+        }
+    }
+    return true;
+}
+
+// Clips a polygon against the plane dot(normal, x) <= offset (Sutherland-Hodgman)
+void clipPolygon(const core::memory::FrameVector<glm::vec3>& input, const glm::vec3& normal, float offset,
+                 core::memory::FrameVector<glm::vec3>& output) {
+    output.clear();
+    for (size_t i = 0; i < input.size(); ++i) {
+        const glm::vec3& a = input[i];
+        const glm::vec3& b = input[(i + 1) % input.size()];
+        float da = glm::dot(normal, a) - offset;
+        float db = glm::dot(normal, b) - offset;
+        if (da <= 0.0f) output.push_back(a);
+        if ((da < 0.0f) != (db < 0.0f) && da != db) {
+            output.push_back(a + (b - a) * (da / (da - db)));
+        }
+    }
+}
+
+// Convex hull vs convex hull: SAT over face normals and edge pairs, clipped face manifold
+bool hullVsHull(const ConvexHullShape& hullA, const Transform& transformA,
+                const ConvexHullShape& hullB, const Transform& transformB,
+                ContactManifold& manifold) {
+    // Work in A's local space
+    const glm::quat inverseA = glm::inverse(transformA.rotation);
+    const glm::quat rotationB = inverseA * transformB.rotation;     // B local -> A local
+    const glm::quat inverseRotationB = glm::inverse(rotationB);
+    const glm::vec3 positionB = inverseA * (transformB.position - transformA.position);
+    auto toA = [&](const glm::vec3& v) { return positionB + rotationB * v; };
+
+    // Each loop starts from where its first search ended last step, kept on
+    // the manifold; the axes move little between steps, so the climbs are short
+    SupportHints& hints = manifold.getSupportHints();
+
+    // Face axes of A
+    float bestFaceA = -FLT_MAX;
+    uint32_t faceA = 0;
+    uint32_t hint = hints.vertex[0];
+    for (uint32_t i = 0; i < hullA.getFaceCount(); ++i) {
+        const auto& face = hullA.getFace(i);
+        hint = hullB.getSupportVertex(inverseRotationB * -face.normal, hint);
+        if (i == 0) hints.vertex[0] = hint;
+        float separation = glm::dot(face.normal, toA(hullB.getVertex(hint))) - face.offset;
+        if (separation > 0.0f) return false;
+        if (separation > bestFaceA) { bestFaceA = separation; faceA = i; }
+    }
+
+    // Face axes of B (normals brought into A's space)
+    float bestFaceB = -FLT_MAX;
+    uint32_t faceB = 0;
+    hint = hints.vertex[1];
+    for (uint32_t i = 0; i < hullB.getFaceCount(); ++i) {
+        const auto& face = hullB.getFace(i);
+        glm::vec3 normal = rotationB * face.normal;
+        hint = hullA.getSupportVertex(-normal, hint);
+        if (i == 0) hints.vertex[1] = hint;
+        float separation = glm::dot(normal, hullA.getVertex(hint) - positionB) - face.offset;
+        if (separation > 0.0f) return false;
+        if (separation > bestFaceB) { bestFaceB = separation; faceB = i; }
+    }
+
+    // Edge pair axes
+    float bestEdge = -FLT_MAX;
+    glm::vec3 edgeAxis(0.0f);
+    const ConvexHullShape::Edge* edgeA = nullptr;
+    const ConvexHullShape::Edge* edgeB = nullptr;
+    const glm::vec3 centerA = hullA.getCenterOfMass();
+    const glm::vec3 centerOffset = toA(hullB.getCenterOfMass()) - centerA;
+    uint32_t hintA = hints.vertex[2], hintB = hints.vertex[3];
+    bool firstEdgeAxis = true;
+    for (const auto& ea : hullA.getEdges()) {
+        glm::vec3 a0 = hullA.getVertex(ea.a);
+        glm::vec3 dirA = hullA.getVertex(ea.b) - a0;
+        for (const auto& eb : hullB.getEdges()) {
+            glm::vec3 dirB = rotationB * (hullB.getVertex(eb.b) - hullB.getVertex(eb.a));
+            glm::vec3 axis = glm::cross(dirA, dirB);
+            float lengthSq = glm::dot(axis, axis);
+            if (lengthSq < 1e-10f) continue;   // Parallel edges are covered by the face axes
+            axis /= std::sqrt(lengthSq);
+            if (glm::dot(axis, centerOffset) < 0.0f) axis = -axis;   // Point from A toward B
+
+            hintA = hullA.getSupportVertex(axis, hintA);
+            hintB = hullB.getSupportVertex(inverseRotationB * -axis, hintB);
+            if (firstEdgeAxis) {
+                hints.vertex[2] = hintA;
+                hints.vertex[3] = hintB;
+                firstEdgeAxis = false;
+            }
+            float separation = glm::dot(axis, toA(hullB.getVertex(hintB))) - glm::dot(axis, hullA.getVertex(hintA));
+            if (separation > 0.0f) return false;
+            if (separation > bestEdge) {
+                bestEdge = separation;
+                edgeAxis = axis;
+                edgeA = &ea;
+                edgeB = &eb;
+            }
+        }
+    }
+
+    // Prefer face contacts unless an edge axis is clearly shallower
+    constexpr float EdgeTolerance = 0.005f;
+    const float bestFace = std::max(bestFaceA, bestFaceB);
+    if (edgeA && bestEdge > bestFace + EdgeTolerance) {
+        glm::vec3 onA, onB;
+        geometry::closestPointsSegmentSegment(
+            hullA.getVertex(edgeA->a), hullA.getVertex(edgeA->b),
+            toA(hullB.getVertex(edgeB->a)), toA(hullB.getVertex(edgeB->b)), onA, onB);
+
+        manifold.setNormal(transformA.rotation * edgeAxis);
+        manifold.addContact(transformA.position + transformA.rotation * onA,
+                            transformA.position + transformA.rotation * onB, -bestEdge);
+        return true;
+    }
+
+    // Reference face on whichever hull gave the shallowest face axis (small bias toward A)
+    const bool referenceIsA = bestFaceA + 0.001f >= bestFaceB;
+    const ConvexHullShape& reference = referenceIsA ? hullA : hullB;
+    const ConvexHullShape& incident = referenceIsA ? hullB : hullA;
+    const auto& referenceFace = reference.getFace(referenceIsA ? faceA : faceB);
+
+    // Everything below is in the reference hull's local space
+    auto incidentToReference = [&](const glm::vec3& v) {
+        return referenceIsA ? toA(v) : inverseRotationB * (v - positionB);
+    };
+    const glm::quat incidentRotation = referenceIsA ? rotationB : inverseRotationB;
+
+    glm::vec3 incidentNormal = glm::inverse(incidentRotation) * -referenceFace.normal;
+    const auto& incidentFace = incident.getFace(incident.getSupportFace(incidentNormal));
+
+    core::memory::FrameVector<glm::vec3> polygon, clipped;
+    polygon.reserve(incidentFace.indexCount);
+    for (uint32_t i = 0; i < incidentFace.indexCount; ++i) {
+        polygon.push_back(incidentToReference(
+            incident.getVertex(incident.getFaceIndices()[incidentFace.firstIndex + i])));
+    }
+
+    // Clip against the side planes of the reference face
+    const auto& indices = reference.getFaceIndices();
+    for (uint32_t i = 0; i < referenceFace.indexCount && !polygon.empty(); ++i) {
+        glm::vec3 v0 = reference.getVertex(indices[referenceFace.firstIndex + i]);
+        glm::vec3 v1 = reference.getVertex(indices[referenceFace.firstIndex + (i + 1) % referenceFace.indexCount]);
+        glm::vec3 sideNormal = glm::cross(v1 - v0, referenceFace.normal);
+        float lengthSq = glm::dot(sideNormal, sideNormal);
+        if (lengthSq < 1e-12f) continue;
+        sideNormal /= std::sqrt(lengthSq);
+        clipPolygon(polygon, sideNormal, glm::dot(sideNormal, v0), clipped);
+        polygon.swap(clipped);
+    }
+
+    const Transform& referenceTransform = referenceIsA ? transformA : transformB;
+    auto toWorld = [&](const glm::vec3& v) {
+        return referenceTransform.position + referenceTransform.rotation * v;
+    };
+    glm::vec3 worldNormal = referenceTransform.rotation * referenceFace.normal;
+    manifold.setNormal(referenceIsA ? worldNormal : -worldNormal);
+
+    bool touching = false;
+    for (const glm::vec3& point : polygon) {
+        float depth = referenceFace.offset - glm::dot(referenceFace.normal, point);
+        if (depth < 0.0f) continue;
+
+        glm::vec3 onReference = toWorld(point + referenceFace.normal * depth);
+        glm::vec3 onIncident = toWorld(point);
+        if (referenceIsA) {
+            manifold.addContact(onReference, onIncident, depth);
+        } else {
+            manifold.addContact(onIncident, onReference, depth);
+        }
+        touching = true;
+    }
+    return touching;
+}
+
+// Boxes meet hulls as 8-vertex hulls through hullVsHull. Each size is built
+// once and kept per thread, so the narrow phase needs no lock and, once a
+// scene's box sizes have been seen, no allocation.
+const ConvexHullShape& boxHull(const glm::vec3& halfExtents) {
+    struct Entry {
+        glm::vec3 halfExtents;
+        std::unique_ptr<ConvexHullShape> hull;
+    };
+    constexpr size_t MaxBoxHulls = 64;
+    thread_local std::vector<Entry> cache;
+
+    for (const Entry& entry : cache) {
+        if (entry.halfExtents == halfExtents) return *entry.hull;
+    }
+    if (cache.size() == MaxBoxHulls) {
+        cache.erase(cache.begin());
+    }
+
+    std::vector<glm::vec3> corners;
+    corners.reserve(8);
+    for (int i = 0; i < 8; ++i) {
+        corners.emplace_back((i & 1) ? halfExtents.x : -halfExtents.x,
+                             (i & 2) ? halfExtents.y : -halfExtents.y,
+                             (i & 4) ? halfExtents.z : -halfExtents.z);
+    }
+    cache.push_back(Entry{halfExtents, std::make_unique<ConvexHullShape>(corners)});
+    return *cache.back().hull;
+}
+
+// Convex hull vs capsule: face planes against the segment when its axis is
+// inside the hull, else the closest points between the segment and the faces
+bool hullVsCapsule(const ConvexHullShape& hull, const Transform& hullTransform,
+                   const CapsuleShape& capsule, const Transform& capsuleTransform,
+                   bool hullIsA, ContactManifold& manifold) {
+    // Work in the hull's local space
+    const glm::quat inverse = glm::inverse(hullTransform.rotation);
+    glm::vec3 top, bottom;
+    capsule.getEndpoints(capsuleTransform, top, bottom);
+    const glm::vec3 p = inverse * (bottom - hullTransform.position);
+    const glm::vec3 q = inverse * (top - hullTransform.position);
+    const glm::vec3 d = q - p;
+    const float radius = capsule.getRadius();
+
+    auto toWorld = [&](const glm::vec3& v) { return hullTransform.position + hullTransform.rotation * v; };
+
+    // Any face the whole segment is farther than the radius in front of separates
+    float maxSeparation = -FLT_MAX;
+    uint32_t maxFace = 0;
+    for (uint32_t i = 0; i < hull.getFaceCount(); ++i) {
+        const auto& face = hull.getFace(i);
+        float separation = std::min(glm::dot(face.normal, p), glm::dot(face.normal, q)) - face.offset;
+        if (separation > radius) return false;
+        if (separation > maxSeparation) { maxSeparation = separation; maxFace = i; }
+    }
+
+    // Contacts of the segment's ends against one face, after keeping only the
+    // part of the segment over it. The deeper end always makes a contact when
+    // required, even when its depth rounds to zero.
+    const auto& indices = hull.getFaceIndices();
+    auto faceContacts = [&](uint32_t faceIndex, bool requireContact) {
+        const auto& face = hull.getFace(faceIndex);
+        float tStart = 0.0f, tEnd = 1.0f;
+        for (uint32_t i = 0; i < face.indexCount; ++i) {
+            glm::vec3 v0 = hull.getVertex(indices[face.firstIndex + i]);
+            glm::vec3 v1 = hull.getVertex(indices[face.firstIndex + (i + 1) % face.indexCount]);
+            glm::vec3 sideNormal = glm::cross(v1 - v0, face.normal);
+            float along = glm::dot(sideNormal, d);
+            float outside = glm::dot(sideNormal, p - v0);    // > 0 beyond this side at t = 0
+            if (std::abs(along) < 1e-8f) {
+                if (outside > 0.0f) tStart = 2.0f;
+                continue;
+            }
+            float t = -outside / along;
+            if (along > 0.0f) tEnd = std::min(tEnd, t);
+            else tStart = std::max(tStart, t);
+        }
+        glm::vec3 ends[2];
+        int endCount;
+        if (tStart <= tEnd) {
+            ends[0] = p + d * tStart;
+            ends[1] = p + d * tEnd;
+            endCount = tEnd - tStart > 1e-6f ? 2 : 1;
+        } else {
+            // Not over the face at all: fall back to the nearer end
+            ends[0] = glm::dot(face.normal, p) <= glm::dot(face.normal, q) ? p : q;
+            endCount = 1;
+        }
+
+        const glm::vec3 worldNormal = hullTransform.rotation * face.normal;   // Hull -> capsule
+        const int deeper = endCount == 2 && glm::dot(ends[1], face.normal) < glm::dot(ends[0], face.normal) ? 1 : 0;
+        bool touching = false;
+        for (int k = 0; k < endCount; ++k) {
+            glm::vec3 surface = ends[k] - face.normal * radius;
+            float depth = face.offset - glm::dot(surface, face.normal);
+            if (depth <= 0.0f && !(requireContact && k == deeper)) continue;
+            addOrientedContact(manifold, hullIsA, worldNormal,
+                               toWorld(surface + face.normal * depth), toWorld(surface), depth);
+            touching = true;
+        }
+        return touching;
+    };
+
+    if (maxSeparation <= 0.0f) {
+        // Axis inside the hull: push out through the face needing the least travel
+        return faceContacts(maxFace, true);
+    }
+
+    // Outside: closest points between the segment and the faces it is in front of
+    float bestSq = FLT_MAX;
+    glm::vec3 onSegment(0.0f), onHull(0.0f);
+    for (uint32_t i = 0; i < hull.getFaceCount(); ++i) {
+        const auto& face = hull.getFace(i);
+        if (std::max(glm::dot(face.normal, p), glm::dot(face.normal, q)) - face.offset <= 0.0f) continue;
+        glm::vec3 a = hull.getVertex(indices[face.firstIndex]);
+        for (uint32_t k = 1; k + 1 < face.indexCount; ++k) {
+            glm::vec3 s, h;
+            float distSq = geometry::closestPointsSegmentTriangle(p, q, a,
+                hull.getVertex(indices[face.firstIndex + k]), hull.getVertex(indices[face.firstIndex + k + 1]), s, h);
+            if (distSq < bestSq) { bestSq = distSq; onSegment = s; onHull = h; }
+        }
+    }
+    if (bestSq >= radius * radius) return false;
+
+    float distance = std::sqrt(bestSq);
+    glm::vec3 normal = distance > 0.0001f ? (onSegment - onHull) / distance : hull.getFace(maxFace).normal;
+
+    // Capsule lying on a face: both caps from that face, for a two-point manifold
+    const uint32_t restingFace = hull.getSupportFace(normal);
+    if (glm::dot(hull.getFace(restingFace).normal, normal) > 0.999f && faceContacts(restingFace, false)) {
+        return true;
+    }
+
+    addOrientedContact(manifold, hullIsA, hullTransform.rotation * normal,
+                       toWorld(onHull), toWorld(onSegment - normal * radius), radius - distance);
+    return true;
+}
+
+// Convex hull vs sphere: deepest face plane when the center is inside, else closest surface point
+bool hullVsSphere(const ConvexHullShape& hull, const Transform& hullTransform,
+                  const SphereShape& sphere, const Transform& sphereTransform,
+                  bool hullIsA, ContactManifold& manifold) {
+    const glm::quat inverse = glm::inverse(hullTransform.rotation);
+    const glm::vec3 center = inverse * (sphereTransform.position - hullTransform.position);
+    const float radius = sphere.getRadius();
+
+    float maxSeparation = -FLT_MAX;
+    uint32_t maxFace = 0;
+    for (uint32_t i = 0; i < hull.getFaceCount(); ++i) {
+        const auto& face = hull.getFace(i);
+        float separation = glm::dot(face.normal, center) - face.offset;
+        if (separation > radius) return false;
+        if (separation > maxSeparation) { maxSeparation = separation; maxFace = i; }
+    }
+
+    glm::vec3 normal, onHull;
+    float depth;
+    if (maxSeparation <= 0.0f) {
+        const auto& face = hull.getFace(maxFace);
+        normal = face.normal;
+        onHull = center - normal * maxSeparation;
+        depth = radius - maxSeparation;
+    } else {
+        // Closest point over the faces the center is in front of
+        float bestSq = FLT_MAX;
+        const auto& indices = hull.getFaceIndices();
+        for (uint32_t i = 0; i < hull.getFaceCount(); ++i) {
+            const auto& face = hull.getFace(i);
+            if (glm::dot(face.normal, center) - face.offset <= 0.0f) continue;
+            glm::vec3 a = hull.getVertex(indices[face.firstIndex]);
+            for (uint32_t k = 1; k + 1 < face.indexCount; ++k) {
+                glm::vec3 closest = geometry::closestPointOnTriangle(center, a,
+                    hull.getVertex(indices[face.firstIndex + k]), hull.getVertex(indices[face.firstIndex + k + 1]));
+                float distSq = glm::dot(center - closest, center - closest);
+                if (distSq < bestSq) { bestSq = distSq; onHull = closest; }
+            }
+        }
+        if (bestSq >= radius * radius) return false;
+        float dist = std::sqrt(bestSq);
+        normal = dist > 0.0001f ? (center - onHull) / dist : hull.getFace(maxFace).normal;
+        depth = radius - dist;
+    }
+
+    glm::vec3 worldNormal = hullTransform.rotation * normal;
+    glm::vec3 worldOnHull = hullTransform.position + hullTransform.rotation * onHull;
+    glm::vec3 worldOnSphere = sphereTransform.position - worldNormal * radius;
+
+    if (hullIsA) {
+        manifold.setNormal(worldNormal);
+        manifold.addContact(worldOnHull, worldOnSphere, depth);
+    } else {
+        manifold.setNormal(-worldNormal);
+        manifold.addContact(worldOnSphere, worldOnHull, depth);
+    }
+    return true;
+}
+
+// Compound vs any shape: recurse into the children whose local AABBs overlap the other shape
+bool compoundVsShape(const CompoundShape& compound, const Transform& compoundTransform,
+                     const CollisionShape& other, const Transform& otherTransform,
+                     bool compoundIsA, ContactManifold& manifold) {
+    Transform inverse;
+    inverse.rotation = glm::inverse(compoundTransform.rotation);
+    inverse.position = inverse.rotation * -compoundTransform.position;
+    BoundingBox otherLocal = other.getAABB(inverse * otherTransform);
+
+    ContactManifold childManifold(manifold.getBodyA(), manifold.getBodyB());
+    float deepest = -FLT_MAX;
+    glm::vec3 normal(0.0f);
+    bool touching = false;
+
+    compound.queryOverlap(otherLocal, [&](uint32_t index) {
+        const CompoundShape::Child& child = compound.getChild(index);
+        Transform childTransform = compoundTransform * child.localTransform;
+
+        childManifold.clearContacts();
+        bool hit = compoundIsA
+            ? CollisionDetector::detectShapes(*child.shape, childTransform, other, otherTransform, childManifold)
+            : CollisionDetector::detectShapes(other, otherTransform, *child.shape, childTransform, childManifold);
+        if (!hit) return;
+
+        // The manifold carries one normal; keep the one from the deepest child pair
+        for (const ContactPoint& contact : childManifold.getContacts()) {
+            manifold.addContact(contact);
+            if (contact.penetrationDepth > deepest) {
+                deepest = contact.penetrationDepth;
+                normal = childManifold.getNormal();
+            }
+        }
+        touching = true;
+    });
+
+    if (touching) {
+        manifold.setNormal(normal);
+    }
+    return touching;
+}
+
+} // namespace
+
 float CollisionDetector::contactTolerance = 0.01f;
 int CollisionDetector::maxContactPoints = 4;
 
@@ -36,37 +557,118 @@ bool CollisionDetector::detectCollision(RigidBody* bodyA, RigidBody* bodyB, Cont
     transformB.rotation = bodyB->getOrientation();
     transformB.scale = glm::vec3(1.0f);
     
+    return detectShapes(*shapeA, transformA, *shapeB, transformB, manifold);
+}
+
+bool CollisionDetector::detectShapes(const CollisionShape& shapeA, const Transform& transformA,
+                                     const CollisionShape& shapeB, const Transform& transformB,
+                                     ContactManifold& manifold) {
     // Dispatch to specific collision detection functions
-    auto typeA = shapeA->getType();
-    auto typeB = shapeB->getType();
+    auto typeA = shapeA.getType();
+    auto typeB = shapeB.getType();
     
-    if (typeA == CollisionShape::ShapeType::Sphere && typeB == CollisionShape::ShapeType::Sphere) {
-        return sphereVsSphere(*static_cast<SphereShape*>(shapeA.get()), transformA,
-                             *static_cast<SphereShape*>(shapeB.get()), transformB,
+    if (typeA == CollisionShape::ShapeType::Compound) {
+        return compoundVsShape(static_cast<const CompoundShape&>(shapeA), transformA,
+                               shapeB, transformB, true, manifold);
+    }
+    else if (typeB == CollisionShape::ShapeType::Compound) {
+        return compoundVsShape(static_cast<const CompoundShape&>(shapeB), transformB,
+                               shapeA, transformA, false, manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::Sphere && typeB == CollisionShape::ShapeType::Sphere) {
+        return sphereVsSphere(static_cast<const SphereShape&>(shapeA), transformA,
+                             static_cast<const SphereShape&>(shapeB), transformB,
                              manifold);
     }
     else if (typeA == CollisionShape::ShapeType::Box && typeB == CollisionShape::ShapeType::Box) {
-        return boxVsBox(*static_cast<BoxShape*>(shapeA.get()), transformA,
-                       *static_cast<BoxShape*>(shapeB.get()), transformB,
+        return boxVsBox(static_cast<const BoxShape&>(shapeA), transformA,
+                       static_cast<const BoxShape&>(shapeB), transformB,
                        manifold);
     }
     else if (typeA == CollisionShape::ShapeType::Sphere && typeB == CollisionShape::ShapeType::Box) {
-        return sphereVsBox(*static_cast<SphereShape*>(shapeA.get()), transformA,
-                          *static_cast<BoxShape*>(shapeB.get()), transformB,
-                          manifold);
+        return sphereVsBox(static_cast<const SphereShape&>(shapeA), transformA,
+                          static_cast<const BoxShape&>(shapeB), transformB,
+                          true, manifold);
     }
     else if (typeA == CollisionShape::ShapeType::Box && typeB == CollisionShape::ShapeType::Sphere) {
-        // Swap parameters for sphere vs box
-        bool collision = sphereVsBox(*static_cast<SphereShape*>(shapeB.get()), transformB,
-                                    *static_cast<BoxShape*>(shapeA.get()), transformA,
-                                    manifold);
-        if (collision) {
-            // Flip normal direction since we swapped bodies
-            manifold.setNormal(-manifold.getNormal());
-        }
-        return collision;
+        return sphereVsBox(static_cast<const SphereShape&>(shapeB), transformB,
+                          static_cast<const BoxShape&>(shapeA), transformA,
+                          false, manifold);
     }
-    
+    else if (typeA == CollisionShape::ShapeType::Capsule && typeB == CollisionShape::ShapeType::Capsule) {
+        return capsuleVsCapsule(static_cast<const CapsuleShape&>(shapeA), transformA,
+                                static_cast<const CapsuleShape&>(shapeB), transformB,
+                                manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::Capsule && typeB == CollisionShape::ShapeType::Sphere) {
+        return capsuleVsSphere(static_cast<const CapsuleShape&>(shapeA), transformA,
+                               static_cast<const SphereShape&>(shapeB), transformB,
+                               true, manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::Sphere && typeB == CollisionShape::ShapeType::Capsule) {
+        return capsuleVsSphere(static_cast<const CapsuleShape&>(shapeB), transformB,
+                               static_cast<const SphereShape&>(shapeA), transformA,
+                               false, manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::Capsule && typeB == CollisionShape::ShapeType::Box) {
+        return capsuleVsBox(static_cast<const CapsuleShape&>(shapeA), transformA,
+                            static_cast<const BoxShape&>(shapeB), transformB,
+                            true, manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::Box && typeB == CollisionShape::ShapeType::Capsule) {
+        return capsuleVsBox(static_cast<const CapsuleShape&>(shapeB), transformB,
+                            static_cast<const BoxShape&>(shapeA), transformA,
+                            false, manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::ConvexMesh && typeB == CollisionShape::ShapeType::ConvexMesh) {
+        return hullVsHull(static_cast<const ConvexHullShape&>(shapeA), transformA,
+                          static_cast<const ConvexHullShape&>(shapeB), transformB,
+                          manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::ConvexMesh && typeB == CollisionShape::ShapeType::Sphere) {
+        return hullVsSphere(static_cast<const ConvexHullShape&>(shapeA), transformA,
+                            static_cast<const SphereShape&>(shapeB), transformB, true, manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::Sphere && typeB == CollisionShape::ShapeType::ConvexMesh) {
+        return hullVsSphere(static_cast<const ConvexHullShape&>(shapeB), transformB,
+                            static_cast<const SphereShape&>(shapeA), transformA, false, manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::ConvexMesh && typeB == CollisionShape::ShapeType::Box) {
+        return hullVsHull(static_cast<const ConvexHullShape&>(shapeA), transformA,
+                          boxHull(static_cast<const BoxShape&>(shapeB).getHalfExtents()), transformB,
+                          manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::Box && typeB == CollisionShape::ShapeType::ConvexMesh) {
+        return hullVsHull(boxHull(static_cast<const BoxShape&>(shapeA).getHalfExtents()), transformA,
+                          static_cast<const ConvexHullShape&>(shapeB), transformB,
+                          manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::ConvexMesh && typeB == CollisionShape::ShapeType::Capsule) {
+        return hullVsCapsule(static_cast<const ConvexHullShape&>(shapeA), transformA,
+                             static_cast<const CapsuleShape&>(shapeB), transformB, true, manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::Capsule && typeB == CollisionShape::ShapeType::ConvexMesh) {
+        return hullVsCapsule(static_cast<const ConvexHullShape&>(shapeB), transformB,
+                             static_cast<const CapsuleShape&>(shapeA), transformA, false, manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::ConcaveMesh) {
+        return meshVsConvex(static_cast<const TriangleMeshShape&>(shapeA), transformA,
+                            shapeB, transformB, true, manifold);
+    }
+    else if (typeB == CollisionShape::ShapeType::ConcaveMesh) {
+        return meshVsConvex(static_cast<const TriangleMeshShape&>(shapeB), transformB,
+                            shapeA, transformA, false, manifold);
+    }
+    else if (typeA == CollisionShape::ShapeType::Heightfield) {
+        return meshVsConvex(static_cast<const HeightfieldShape&>(shapeA), transformA,
+                            shapeB, transformB, true, manifold);
+    }
+    else if (typeB == CollisionShape::ShapeType::Heightfield) {
+        return meshVsConvex(static_cast<const HeightfieldShape&>(shapeB), transformB,
+                            shapeA, transformA, false, manifold);
+    }
+
+    reportUnsupportedPair(typeA, typeB);
     return false;
 }
 
@@ -110,20 +712,21 @@ bool CollisionDetector::boxVsBox(const BoxShape& boxA, const Transform& transfor
                                 const BoxShape& boxB, const Transform& transformB,
                                 ContactManifold& manifold) {
     // Get box vertices
-    std::vector<glm::vec3> verticesA, verticesB;
+    core::memory::FrameVector<glm::vec3> verticesA, verticesB;
     getBoxVertices(boxA, transformA, verticesA);
     getBoxVertices(boxB, transformB, verticesB);
     
     // Get potential separating axes
-    std::vector<glm::vec3> axes;
+    core::memory::FrameVector<glm::vec3> axes;
+    axes.reserve(15);
     getBoxAxes(transformA, axes);
     
-    std::vector<glm::vec3> axesB;
+    core::memory::FrameVector<glm::vec3> axesB;
     getBoxAxes(transformB, axesB);
     axes.insert(axes.end(), axesB.begin(), axesB.end());
     
     // Add cross product axes
-    std::vector<glm::vec3> axesACross;
+    core::memory::FrameVector<glm::vec3> axesACross;
     getBoxAxes(transformA, axesACross);
     for (const glm::vec3& axisA : axesACross) {
         for (const glm::vec3& axisB : axesB) {
@@ -170,25 +773,28 @@ bool CollisionDetector::boxVsBox(const BoxShape& boxA, const Transform& transfor
 
 bool CollisionDetector::sphereVsBox(const SphereShape& sphere, const Transform& sphereTransform,
                                    const BoxShape& box, const Transform& boxTransform,
-                                   ContactManifold& manifold) {
+                                   bool sphereIsA, ContactManifold& manifold) {
     glm::vec3 sphereCenter = sphereTransform.position;
     float sphereRadius = sphere.getRadius();
     
     // Find closest point on box to sphere center
     glm::vec3 closestPoint = closestPointOnBox(sphereCenter, box, boxTransform);
     
-    glm::vec3 direction = sphereCenter - closestPoint;
+    glm::vec3 direction = closestPoint - sphereCenter;
     float distance = glm::length(direction);
     
     if (distance > sphereRadius) {
         return false; // No collision
     }
     
+    // Normal points from the sphere to the box
     glm::vec3 normal;
+    float penetration;
     if (distance > 0.0001f) {
         normal = direction / distance;
+        penetration = sphereRadius - distance;
     } else {
-        // Sphere center is inside box, find best normal
+        // Sphere center is inside box, push out through the nearest face
         glm::vec3 localCenter = glm::inverse(boxTransform.rotation) * (sphereCenter - boxTransform.position);
         glm::vec3 halfExtents = box.getHalfExtents();
         
@@ -197,24 +803,23 @@ bool CollisionDetector::sphereVsBox(const SphereShape& sphere, const Transform&
         int bestAxis = 0;
         
         for (int i = 0; i < 3; ++i) {
-            float penetration = halfExtents[i] - std::abs(localCenter[i]);
-            if (penetration < minPenetration) {
-                minPenetration = penetration;
+            float axisPenetration = halfExtents[i] - std::abs(localCenter[i]);
+            if (axisPenetration < minPenetration) {
+                minPenetration = axisPenetration;
                 bestAxis = i;
             }
         }
         
         glm::vec3 localNormal(0.0f);
         localNormal[bestAxis] = (localCenter[bestAxis] > 0) ? 1.0f : -1.0f;
-        normal = boxTransform.rotation * localNormal;
+        glm::vec3 faceNormal = boxTransform.rotation * localNormal;
+        normal = -faceNormal;
+        closestPoint = sphereCenter + faceNormal * minPenetration;
+        penetration = sphereRadius + minPenetration;
     }
     
-    float penetration = sphereRadius - distance;
-    glm::vec3 contactPointA = sphereCenter - normal * sphereRadius;
-    glm::vec3 contactPointB = closestPoint;
-    
-    manifold.setNormal(normal);
-    manifold.addContact(contactPointA, contactPointB, penetration);
+    addOrientedContact(manifold, sphereIsA, normal,
+                       sphereCenter + normal * sphereRadius, closestPoint, penetration);
     
     return true;
 }
@@ -222,9 +827,217 @@ bool CollisionDetector::sphereVsBox(const SphereShape& sphere, const Transform&
 // ... (Continue with remaining methods in next part)
 // ... (Continuation of CollisionDetector.cpp)
 
+bool CollisionDetector::capsuleVsSphere(const CapsuleShape& capsule, const Transform& capsuleTransform,
+                                        const SphereShape& sphere, const Transform& sphereTransform,
+                                        bool capsuleIsA, ContactManifold& manifold) {
+    glm::vec3 top, bottom;
+    capsule.getEndpoints(capsuleTransform, top, bottom);
+    float capsuleRadius = capsule.getRadius();
+    float sphereRadius = sphere.getRadius();
+    glm::vec3 center = sphereTransform.position;
+
+    glm::vec3 onSegment = geometry::closestPointOnSegment(center, bottom, top);
+    glm::vec3 direction = center - onSegment;
+    float distance = glm::length(direction);
+    float combinedRadius = capsuleRadius + sphereRadius;
+    if (distance >= combinedRadius) {
+        return false;
+    }
+
+    // Normal from capsule to sphere; any direction off the axis works when the center is on it
+    glm::vec3 normal = distance > 0.0001f ? direction / distance
+                                          : capsuleTransform.rotation * glm::vec3(1.0f, 0.0f, 0.0f);
+
+    addOrientedContact(manifold, capsuleIsA, normal,
+                       onSegment + normal * capsuleRadius, center - normal * sphereRadius,
+                       combinedRadius - distance);
+    return true;
+}
+
+bool CollisionDetector::capsuleVsCapsule(const CapsuleShape& capsuleA, const Transform& transformA,
+                                         const CapsuleShape& capsuleB, const Transform& transformB,
+                                         ContactManifold& manifold) {
+    glm::vec3 topA, bottomA, topB, bottomB;
+    capsuleA.getEndpoints(transformA, topA, bottomA);
+    capsuleB.getEndpoints(transformB, topB, bottomB);
+    float radiusA = capsuleA.getRadius();
+    float radiusB = capsuleB.getRadius();
+    float combinedRadius = radiusA + radiusB;
+
+    glm::vec3 closestA, closestB;
+    float distanceSq = geometry::closestPointsSegmentSegment(bottomA, topA, bottomB, topB, closestA, closestB);
+    if (distanceSq >= combinedRadius * combinedRadius) {
+        return false;
+    }
+
+    float distance = std::sqrt(distanceSq);
+    glm::vec3 axisA = topA - bottomA;
+    glm::vec3 axisB = topB - bottomB;
+    glm::vec3 normal;
+    if (distance > 0.0001f) {
+        normal = (closestB - closestA) / distance;
+    } else {
+        // Axes cross: separate along their common perpendicular
+        glm::vec3 perpendicular = glm::cross(axisA, axisB);
+        normal = glm::dot(perpendicular, perpendicular) > 1e-8f
+            ? glm::normalize(perpendicular)
+            : transformA.rotation * glm::vec3(1.0f, 0.0f, 0.0f);
+        if (glm::dot(normal, transformB.position - transformA.position) < 0.0f) normal = -normal;
+    }
+    manifold.setNormal(normal);
+
+    // Near-parallel overlapping capsules rest on a line: use the ends of the overlap
+    float lengthSqA = glm::dot(axisA, axisA);
+    float lengthSqB = glm::dot(axisB, axisB);
+    if (lengthSqA > 1e-8f && lengthSqB > 1e-8f) {
+        glm::vec3 crossAxes = glm::cross(axisA, axisB);
+        const float parallelSinSq = 0.0025f;   // ~3 degrees
+        if (glm::dot(crossAxes, crossAxes) < parallelSinSq * lengthSqA * lengthSqB) {
+            float t0 = glm::dot(bottomB - bottomA, axisA) / lengthSqA;
+            float t1 = glm::dot(topB - bottomA, axisA) / lengthSqA;
+            float begin = glm::clamp(std::min(t0, t1), 0.0f, 1.0f);
+            float end = glm::clamp(std::max(t0, t1), 0.0f, 1.0f);
+
+            if (end - begin > 0.01f) {
+                bool touching = false;
+                for (float t : {begin, end}) {
+                    glm::vec3 onA = bottomA + axisA * t;
+                    glm::vec3 onB = geometry::closestPointOnSegment(onA, bottomB, topB);
+                    float separation = glm::dot(onB - onA, normal);
+                    if (separation >= combinedRadius) continue;
+                    manifold.addContact(onA + normal * radiusA, onB - normal * radiusB, combinedRadius - separation);
+                    touching = true;
+                }
+                if (touching) return true;
+            }
+        }
+    }
+
+    manifold.addContact(closestA + normal * radiusA, closestB - normal * radiusB, combinedRadius - distance);
+    return true;
+}
+
+bool CollisionDetector::capsuleVsBox(const CapsuleShape& capsule, const Transform& capsuleTransform,
+                                     const BoxShape& box, const Transform& boxTransform,
+                                     bool capsuleIsA, ContactManifold& manifold) {
+    // Work in the box's local space
+    glm::quat inverseRotation = glm::inverse(boxTransform.rotation);
+    glm::vec3 top, bottom;
+    capsule.getEndpoints(capsuleTransform, top, bottom);
+    const glm::vec3 p = inverseRotation * (bottom - boxTransform.position);
+    const glm::vec3 q = inverseRotation * (top - boxTransform.position);
+    const glm::vec3 h = box.getHalfExtents();
+    const float radius = capsule.getRadius();
+
+    auto toWorld = [&](const glm::vec3& v) { return boxTransform.position + boxTransform.rotation * v; };
+
+    // Does the segment pass through the box? (slab test)
+    glm::vec3 d = q - p;
+    float tEnter = 0.0f, tExit = 1.0f;
+    for (int i = 0; i < 3 && tEnter <= tExit; ++i) {
+        if (std::abs(d[i]) < 1e-8f) {
+            if (p[i] < -h[i] || p[i] > h[i]) tEnter = 2.0f;
+            continue;
+        }
+        float t0 = (-h[i] - p[i]) / d[i];
+        float t1 = (h[i] - p[i]) / d[i];
+        tEnter = std::max(tEnter, std::min(t0, t1));
+        tExit = std::min(tExit, std::max(t0, t1));
+    }
+
+    if (tEnter <= tExit) {
+        // Axis inside the box: push out through the face needing the least travel
+        float bestDepth = FLT_MAX;
+        int faceAxis = 0;
+        glm::vec3 faceNormal(0.0f);     // Box -> capsule
+        for (int i = 0; i < 3; ++i) {
+            float lo = std::min(p[i], q[i]) - radius;
+            float hi = std::max(p[i], q[i]) + radius;
+            if (h[i] - lo < bestDepth) { bestDepth = h[i] - lo; faceAxis = i; faceNormal = glm::vec3(0.0f); faceNormal[i] = 1.0f; }
+            if (hi + h[i] < bestDepth) { bestDepth = hi + h[i]; faceAxis = i; faceNormal = glm::vec3(0.0f); faceNormal[i] = -1.0f; }
+        }
+        float faceOffset = h[faceAxis];
+        glm::vec3 worldNormal = boxTransform.rotation * -faceNormal;   // Capsule -> box
+
+        // Keep only the part of the segment over the face, so contacts land on it
+        float tStart = 0.0f, tEnd = 1.0f;
+        for (int i = 0; i < 3; ++i) {
+            if (i == faceAxis || std::abs(d[i]) < 1e-8f) continue;
+            float t0 = (-h[i] - p[i]) / d[i];
+            float t1 = (h[i] - p[i]) / d[i];
+            tStart = std::max(tStart, std::min(t0, t1));
+            tEnd = std::min(tEnd, std::max(t0, t1));
+        }
+        const glm::vec3 ends[2] = {p + d * tStart, p + d * tEnd};
+        const int endCount = tEnd - tStart > 1e-6f ? 2 : 1;
+
+        // The deeper end always makes a contact, even when its depth rounds to zero
+        bool touching = false;
+        const int deeper = endCount == 2 && glm::dot(ends[1], faceNormal) < glm::dot(ends[0], faceNormal) ? 1 : 0;
+        for (int k = 0; k < endCount; ++k) {
+            glm::vec3 surface = ends[k] - faceNormal * radius;
+            float depth = faceOffset - glm::dot(surface, faceNormal);
+            if (depth <= 0.0f && k != deeper) continue;
+            addOrientedContact(manifold, capsuleIsA, worldNormal,
+                               toWorld(surface), toWorld(surface + faceNormal * depth), depth);
+            touching = true;
+        }
+        return touching;
+    }
+
+    // Outside: the closest pair is either a segment endpoint vs the box or the segment vs a box edge
+    glm::vec3 onSegment = p;
+    glm::vec3 onBox = glm::clamp(p, -h, h);
+    float bestSq = glm::dot(p - onBox, p - onBox);
+    {
+        glm::vec3 clamped = glm::clamp(q, -h, h);
+        float distSq = glm::dot(q - clamped, q - clamped);
+        if (distSq < bestSq) { bestSq = distSq; onSegment = q; onBox = clamped; }
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        int u = (axis + 1) % 3;
+        int v = (axis + 2) % 3;
+        for (int corner = 0; corner < 4; ++corner) {
+            glm::vec3 e0, e1;
+            e0[u] = e1[u] = (corner & 1) ? h[u] : -h[u];
+            e0[v] = e1[v] = (corner & 2) ? h[v] : -h[v];
+            e0[axis] = -h[axis];
+            e1[axis] = h[axis];
+
+            glm::vec3 c1, c2;
+            float distSq = geometry::closestPointsSegmentSegment(p, q, e0, e1, c1, c2);
+            if (distSq < bestSq) { bestSq = distSq; onSegment = c1; onBox = c2; }
+        }
+    }
+
+    if (bestSq >= radius * radius) {
+        return false;
+    }
+
+    float distance = std::sqrt(bestSq);
+    glm::vec3 normal = (onBox - onSegment) / std::max(distance, 1e-6f);   // Capsule -> box
+    glm::vec3 worldNormal = boxTransform.rotation * normal;
+
+    // Both caps within reach of the box (capsule lying on a face): two-point manifold
+    bool touching = false;
+    for (const glm::vec3& end : {p, q}) {
+        glm::vec3 clamped = glm::clamp(end, -h, h);
+        float depth = radius - glm::dot(clamped - end, normal);
+        if (depth <= 0.0f || glm::dot(clamped - end, clamped - end) >= radius * radius) continue;
+        addOrientedContact(manifold, capsuleIsA, worldNormal,
+                           toWorld(end + normal * radius), toWorld(clamped), depth);
+        touching = true;
+    }
+    if (!touching) {
+        addOrientedContact(manifold, capsuleIsA, worldNormal,
+                           toWorld(onSegment + normal * radius), toWorld(onBox), radius - distance);
+    }
+    return true;
+}
+
 bool CollisionDetector::testSeparatingAxis(const glm::vec3& axis,
-                                          const std::vector<glm::vec3>& verticesA,
-                                          const std::vector<glm::vec3>& verticesB,
+                                          const core::memory::FrameVector<glm::vec3>& verticesA,
+                                          const core::memory::FrameVector<glm::vec3>& verticesB,
                                           float& separation) {
     float minA = FLT_MAX, maxA = -FLT_MAX;
     float minB = FLT_MAX, maxB = -FLT_MAX;
@@ -254,7 +1067,7 @@ bool CollisionDetector::testSeparatingAxis(const glm::vec3& axis,
 }
 
 void CollisionDetector::getBoxVertices(const BoxShape& box, const Transform& transform,
-                                      std::vector<glm::vec3>& vertices) {
+                                      core::memory::FrameVector<glm::vec3>& vertices) {
     vertices.clear();
     vertices.reserve(8);
     
@@ -276,7 +1089,7 @@ void CollisionDetector::getBoxVertices(const BoxShape& box, const Transform& tra
     }
 }
 
-void CollisionDetector::getBoxAxes(const Transform& transform, std::vector<glm::vec3>& axes) {
+void CollisionDetector::getBoxAxes(const Transform& transform, core::memory::FrameVector<glm::vec3>& axes) {
     axes.clear();
     axes.reserve(3);
     
@@ -293,11 +1106,12 @@ void CollisionDetector::calculateBoxBoxContacts(const BoxShape& boxA, const Tran
     // Simplified contact generation for box-box collision
     // This is a complex algorithm, so we'll use a basic approach
     
-    std::vector<glm::vec3> verticesA, verticesB;
+    core::memory::FrameVector<glm::vec3> verticesA, verticesB;
     getBoxVertices(boxA, transformA, verticesA);
     getBoxVertices(boxB, transformB, verticesB);
     
-    std::vector<glm::vec3> contactPoints;
+    core::memory::FrameVector<glm::vec3> contactPoints;
+    contactPoints.reserve(16);
     
     // Find vertices of B that are inside A
     for (const glm::vec3& vertex : verticesB) {
@@ -318,9 +1132,9 @@ void CollisionDetector::calculateBoxBoxContacts(const BoxShape& boxA, const Tran
     generateContactPoints(contactPoints, normal, separation, manifold);
 }
 
-void CollisionDetector::clipFaceAgainstPlane(const std::vector<glm::vec3>& inputVertices,
+void CollisionDetector::clipFaceAgainstPlane(const core::memory::FrameVector<glm::vec3>& inputVertices,
                                             const glm::vec3& planeNormal, float planeDistance,
-                                            std::vector<glm::vec3>& outputVertices) {
+                                            core::memory::FrameVector<glm::vec3>& outputVertices) {
     outputVertices.clear();
     
     if (inputVertices.empty()) return;
@@ -364,19 +1178,23 @@ float CollisionDetector::pointToPlaneDistance(const glm::vec3& point, const glm:
     return glm::dot(point - planePoint, planeNormal);
 }
 
-void CollisionDetector::generateContactPoints(const std::vector<glm::vec3>& points,
+void CollisionDetector::generateContactPoints(const core::memory::FrameVector<glm::vec3>& points,
                                              const glm::vec3& normal, float separation,
                                              ContactManifold& manifold) {
     if (points.empty()) return;
     
     // Sort points by distance to manifold normal
-    std::vector<std::pair<float, glm::vec3>> sortedPoints;
+    core::memory::FrameVector<std::pair<float, glm::vec3>> sortedPoints;
+    sortedPoints.reserve(points.size());
     for (const glm::vec3& point : points) {
         float distance = glm::dot(point, normal);
         sortedPoints.emplace_back(distance, point);
     }
     
-    std::sort(sortedPoints.begin(), sortedPoints.end());
+    // glm vectors have no ordering, so compare on the distance only; stable
+    // so equal distances keep generation order on every platform
+    std::stable_sort(sortedPoints.begin(), sortedPoints.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
     
     // Take up to maxContactPoints deepest points
     int numContacts = glm::min(static_cast<int>(sortedPoints.size()), maxContactPoints);
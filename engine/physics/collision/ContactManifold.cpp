@@ -9,13 +9,11 @@ namespace engine::physics {
 ContactManifold::ContactManifold() 
     : bodyA(nullptr), bodyB(nullptr), normal(0, 1, 0), 
       friction(0.5f), restitution(0.3f), solverDataValid(false) {
-    contacts.reserve(4);  // Maximum 4 contacts for stability
 }
 
 ContactManifold::ContactManifold(RigidBody* a, RigidBody* b)
     : bodyA(a), bodyB(b), normal(0, 1, 0), 
       friction(0.5f), restitution(0.3f), solverDataValid(false) {
-    contacts.reserve(4);
     if (a && b) {
         calculateMaterialProperties();
     }
@@ -40,7 +38,7 @@ void ContactManifold::addContact(const ContactPoint& contact) {
         }
     }
     
-    if (contacts.size() < 4) {
+    if (contacts.size() < MaxContacts) {
         contacts.push_back(contact);
     } else {
         // Replace the contact with least penetration
@@ -1,5 +1,6 @@
 #pragma once
 #include <glm/glm.hpp>
+#include "../../core/SmallVector.hpp"
 #include <vector>
 #include <memory>
 
@@ -30,11 +31,25 @@ struct ContactPoint {
                     featureA(0), featureB(0) {}
 };
 
+/**
+ * @brief Start vertices for a pair's convex hull support searches
+ *
+ * Carried from one step to the next so each hill climb starts beside last
+ * step's answer. Any value is safe: out-of-range starts fall back to vertex 0.
+ */
+struct SupportHints {
+    uint32_t vertex[4] = {};
+};
+
 /**
  * @brief Represents a collection of contact points between two bodies
  */
 class ContactManifold {
 public:
+    // At most four points, stored inline so manifolds copy without allocating
+    static constexpr size_t MaxContacts = 4;
+    using ContactList = core::memory::SmallVector<ContactPoint, MaxContacts>;
+    
     ContactManifold();
     ContactManifold(RigidBody* bodyA, RigidBody* bodyB);
     
@@ -58,12 +73,16 @@ public:
     void addContact(const glm::vec3& worldPointA, const glm::vec3& worldPointB, 
                    float penetration);
     
-    const std::vector<ContactPoint>& getContacts() const { return contacts; }
+    const ContactList& getContacts() const { return contacts; }
     size_t getContactCount() const { return contacts.size(); }
     bool hasContacts() const { return !contacts.empty(); }
     
     void clearContacts() { contacts.clear(); }
     
+    // Hull support-search hints, seeded by the world before detection
+    SupportHints& getSupportHints() { return supportHints; }
+    const SupportHints& getSupportHints() const { return supportHints; }
+    
     // Contact processing
     void removeDeepestContact();
     void removeDuplicateContacts(float tolerance = 0.01f);
@@ -88,7 +107,8 @@ private:
     RigidBody* bodyB;
     
     glm::vec3 normal;             // Contact normal (from A to B)
-    std::vector<ContactPoint> contacts;
+    ContactList contacts;
+    SupportHints supportHints;
     
     float friction;               // Combined friction
     float restitution;            // Combined restitution
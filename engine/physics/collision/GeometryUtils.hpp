@@ -0,0 +1,174 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cfloat>
+
+// Closest-point and intersection primitives shared by the narrow phase
+// and the mesh/heightfield shapes. Formulations follow Ericson,
+// "Real-Time Collision Detection", chapter 5.
+namespace engine::physics::geometry {
+
+    // Closest point to p on segment [a, b]
+    inline glm::vec3 closestPointOnSegment(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b) {
+        glm::vec3 ab = b - a;
+        float denom = glm::dot(ab, ab);
+        if (denom <= FLT_EPSILON) return a;
+        float t = glm::clamp(glm::dot(p - a, ab) / denom, 0.0f, 1.0f);
+        return a + ab * t;
+    }
+
+    // Closest point to p on triangle (a, b, c) using Voronoi regions
+    inline glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a,
+                                            const glm::vec3& b, const glm::vec3& c) {
+        glm::vec3 ab = b - a;
+        glm::vec3 ac = c - a;
+        glm::vec3 ap = p - a;
+        float d1 = glm::dot(ab, ap);
+        float d2 = glm::dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+        glm::vec3 bp = p - b;
+        float d3 = glm::dot(ab, bp);
+        float d4 = glm::dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3) return b;
+
+        float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+            return a + ab * (d1 / (d1 - d3));
+        }
+
+        glm::vec3 cp = p - c;
+        float d5 = glm::dot(ab, cp);
+        float d6 = glm::dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6) return c;
+
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+            return a + ac * (d2 / (d2 - d6));
+        }
+
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+            return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        }
+
+        float denom = 1.0f / (va + vb + vc);
+        return a + ab * (vb * denom) + ac * (vc * denom);
+    }
+
+    // Closest points c1 on [p1, q1] and c2 on [p2, q2]; returns squared distance
+    inline float closestPointsSegmentSegment(const glm::vec3& p1, const glm::vec3& q1,
+                                             const glm::vec3& p2, const glm::vec3& q2,
+                                             glm::vec3& c1, glm::vec3& c2) {
+        glm::vec3 d1 = q1 - p1;
+        glm::vec3 d2 = q2 - p2;
+        glm::vec3 r = p1 - p2;
+        float a = glm::dot(d1, d1);
+        float e = glm::dot(d2, d2);
+        float f = glm::dot(d2, r);
+        float s = 0.0f, t = 0.0f;
+
+        if (a <= FLT_EPSILON && e <= FLT_EPSILON) {
+            c1 = p1;
+            c2 = p2;
+            return glm::dot(c1 - c2, c1 - c2);
+        }
+
+        if (a <= FLT_EPSILON) {
+            t = glm::clamp(f / e, 0.0f, 1.0f);
+        } else {
+            float c = glm::dot(d1, r);
+            if (e <= FLT_EPSILON) {
+                s = glm::clamp(-c / a, 0.0f, 1.0f);
+            } else {
+                float b = glm::dot(d1, d2);
+                float denom = a * e - b * b;
+                s = (denom != 0.0f) ? glm::clamp((b * f - c * e) / denom, 0.0f, 1.0f) : 0.0f;
+                t = (b * s + f) / e;
+                if (t < 0.0f) {
+                    t = 0.0f;
+                    s = glm::clamp(-c / a, 0.0f, 1.0f);
+                } else if (t > 1.0f) {
+                    t = 1.0f;
+                    s = glm::clamp((b - c) / a, 0.0f, 1.0f);
+                }
+            }
+        }
+
+        c1 = p1 + d1 * s;
+        c2 = p2 + d2 * t;
+        return glm::dot(c1 - c2, c1 - c2);
+    }
+
+    // Ray/triangle intersection (Moller-Trumbore); t is along dir
+    inline bool rayTriangle(const glm::vec3& origin, const glm::vec3& dir,
+                            const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                            float maxT, float& t) {
+        glm::vec3 e1 = b - a;
+        glm::vec3 e2 = c - a;
+        glm::vec3 p = glm::cross(dir, e2);
+        float det = glm::dot(e1, p);
+        if (std::abs(det) < 1e-8f) return false;
+
+        float invDet = 1.0f / det;
+        glm::vec3 s = origin - a;
+        float u = glm::dot(s, p) * invDet;
+        if (u < 0.0f || u > 1.0f) return false;
+
+        glm::vec3 q = glm::cross(s, e1);
+        float v = glm::dot(dir, q) * invDet;
+        if (v < 0.0f || u + v > 1.0f) return false;
+
+        t = glm::dot(e2, q) * invDet;
+        return t >= 0.0f && t <= maxT;
+    }
+
+    // Closest points between segment [p, q] and triangle; returns squared distance
+    inline float closestPointsSegmentTriangle(const glm::vec3& p, const glm::vec3& q,
+                                              const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                                              glm::vec3& onSegment, glm::vec3& onTriangle) {
+        // Segment piercing the triangle gives distance zero
+        float t;
+        glm::vec3 dir = q - p;
+        if (rayTriangle(p, dir, a, b, c, 1.0f, t)) {
+            onSegment = onTriangle = p + dir * t;
+            return 0.0f;
+        }
+
+        float best = FLT_MAX;
+        auto consider = [&](const glm::vec3& s, const glm::vec3& tri) {
+            float d = glm::dot(s - tri, s - tri);
+            if (d < best) {
+                best = d;
+                onSegment = s;
+                onTriangle = tri;
+            }
+        };
+
+        consider(p, closestPointOnTriangle(p, a, b, c));
+        consider(q, closestPointOnTriangle(q, a, b, c));
+
+        const glm::vec3 edges[3][2] = { {a, b}, {b, c}, {c, a} };
+        for (const auto& edge : edges) {
+            glm::vec3 s, e;
+            closestPointsSegmentSegment(p, q, edge[0], edge[1], s, e);
+            consider(s, e);
+        }
+
+        return best;
+    }
+
+    // Slab test against an AABB; returns entry distance in tEnter
+    inline bool rayAabb(const glm::vec3& origin, const glm::vec3& invDir,
+                        const glm::vec3& boxMin, const glm::vec3& boxMax,
+                        float maxT, float& tEnter) {
+        glm::vec3 t1 = (boxMin - origin) * invDir;
+        glm::vec3 t2 = (boxMax - origin) * invDir;
+        glm::vec3 tMin = glm::min(t1, t2);
+        glm::vec3 tMax = glm::max(t1, t2);
+        tEnter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+        float tExit = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxT));
+        return tEnter <= tExit;
+    }
+
+} // namespace engine::physics::geometry
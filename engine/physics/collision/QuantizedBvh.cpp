@@ -0,0 +1,120 @@
+#include "QuantizedBvh.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace engine::physics {
+
+namespace {
+constexpr float QuantizedRange = 65535.0f;
+}
+
+void QuantizedBvh::build(const glm::vec3* vertices, const uint32_t* indices, size_t triangleCount) {
+    ownedNodes.clear();
+    nodes = nullptr;
+    nodeCount = 0;
+
+    if (triangleCount == 0) {
+        setBounds(glm::vec3(0.0f), glm::vec3(0.0f));
+        return;
+    }
+
+    std::vector<BuildTriangle> triangles(triangleCount);
+    BoundingBox meshBounds;
+
+    for (size_t i = 0; i < triangleCount; ++i) {
+        BuildTriangle& tri = triangles[i];
+        for (int k = 0; k < 3; ++k) {
+            tri.bounds.expand(vertices[indices[i * 3 + k]]);
+        }
+        tri.centroid = tri.bounds.getCenter();
+        tri.index = static_cast<uint32_t>(i);
+        meshBounds = meshBounds.merge(tri.bounds);
+    }
+
+    setBounds(meshBounds.min, meshBounds.max);
+
+    // A binary tree with one triangle per leaf has exactly 2n - 1 nodes
+    ownedNodes.reserve(triangleCount * 2 - 1);
+    buildRecursive(triangles, 0, triangleCount);
+
+    nodes = ownedNodes.data();
+    nodeCount = ownedNodes.size();
+}
+
+void QuantizedBvh::attach(const QuantizedBvhNode* externalNodes, size_t count,
+                          const glm::vec3& minimum, const glm::vec3& maximum) {
+    ownedNodes.clear();
+    nodes = externalNodes;
+    nodeCount = count;
+    setBounds(minimum, maximum);
+}
+
+BoundingBox QuantizedBvh::dequantize(const QuantizedBvhNode& node) const {
+    glm::vec3 minimum(node.quantizedMin[0], node.quantizedMin[1], node.quantizedMin[2]);
+    glm::vec3 maximum(node.quantizedMax[0], node.quantizedMax[1], node.quantizedMax[2]);
+    return BoundingBox(boundsMin + minimum / quantization, boundsMin + maximum / quantization);
+}
+
+void QuantizedBvh::setBounds(const glm::vec3& minimum, const glm::vec3& maximum) {
+    boundsMin = minimum;
+    boundsMax = maximum;
+
+    glm::vec3 extent = glm::max(maximum - minimum, glm::vec3(1e-6f));
+    quantization = glm::vec3(QuantizedRange) / extent;
+}
+
+void QuantizedBvh::quantize(const BoundingBox& box, uint16_t outMin[3], uint16_t outMax[3]) const {
+    // Round outward so quantized boxes always contain the original
+    glm::vec3 lo = glm::floor((box.min - boundsMin) * quantization);
+    glm::vec3 hi = glm::ceil((box.max - boundsMin) * quantization);
+
+    for (int i = 0; i < 3; ++i) {
+        outMin[i] = static_cast<uint16_t>(glm::clamp(lo[i], 0.0f, QuantizedRange));
+        outMax[i] = static_cast<uint16_t>(glm::clamp(hi[i], 0.0f, QuantizedRange));
+    }
+}
+
+void QuantizedBvh::buildRecursive(std::vector<BuildTriangle>& triangles, size_t begin, size_t end) {
+    size_t nodeIndex = ownedNodes.size();
+    ownedNodes.emplace_back();
+
+    BoundingBox bounds;
+    BoundingBox centroidBounds;
+    for (size_t i = begin; i < end; ++i) {
+        bounds = bounds.merge(triangles[i].bounds);
+        centroidBounds.expand(triangles[i].centroid);
+    }
+    quantize(bounds, ownedNodes[nodeIndex].quantizedMin, ownedNodes[nodeIndex].quantizedMax);
+
+    if (end - begin == 1) {
+        ownedNodes[nodeIndex].escapeIndexOrTriangleIndex = static_cast<int32_t>(triangles[begin].index);
+        return;
+    }
+
+    // Split at the centroid mean on the widest axis, falling back to the median
+    glm::vec3 extent = centroidBounds.getSize();
+    int axis = (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+
+    float mean = 0.0f;
+    for (size_t i = begin; i < end; ++i) {
+        mean += triangles[i].centroid[axis];
+    }
+    mean /= static_cast<float>(end - begin);
+
+    auto middle = std::partition(triangles.begin() + begin, triangles.begin() + end,
+        [axis, mean](const BuildTriangle& tri) { return tri.centroid[axis] < mean; });
+    size_t split = static_cast<size_t>(middle - triangles.begin());
+
+    if (split == begin || split == end) {
+        split = begin + (end - begin) / 2;
+        std::nth_element(triangles.begin() + begin, triangles.begin() + split, triangles.begin() + end,
+            [axis](const BuildTriangle& a, const BuildTriangle& b) { return a.centroid[axis] < b.centroid[axis]; });
+    }
+
+    buildRecursive(triangles, begin, split);
+    buildRecursive(triangles, split, end);
+
+    ownedNodes[nodeIndex].escapeIndexOrTriangleIndex = -static_cast<int32_t>(ownedNodes.size() - nodeIndex);
+}
+
+} // namespace engine::physics
@@ -0,0 +1,125 @@
+#pragma once
+#include "../CollisionShape.hpp"
+#include "GeometryUtils.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+/**
+ * @brief 16-byte BVH node with 16-bit quantized bounds
+ * Leaves store a triangle index; internal nodes store the negated size of
+ * their subtree so traversal can skip it without a stack.
+ */
+struct QuantizedBvhNode {
+    uint16_t quantizedMin[3];
+    uint16_t quantizedMax[3];
+    int32_t escapeIndexOrTriangleIndex;
+
+    bool isLeaf() const { return escapeIndexOrTriangleIndex >= 0; }
+    uint32_t getTriangleIndex() const { return static_cast<uint32_t>(escapeIndexOrTriangleIndex); }
+    uint32_t getEscapeIndex() const { return static_cast<uint32_t>(-escapeIndexOrTriangleIndex); }
+};
+
+static_assert(sizeof(QuantizedBvhNode) == 16, "QuantizedBvhNode must stay 16 bytes");
+
+/**
+ * @brief Static bounding volume hierarchy over a triangle list
+ * Nodes are stored depth-first in a flat array; they can either be owned
+ * (built at runtime) or point into externally owned memory such as a
+ * memory-mapped file.
+ */
+class QuantizedBvh {
+public:
+    QuantizedBvh() = default;
+    QuantizedBvh(const QuantizedBvh&) = delete;
+    QuantizedBvh& operator=(const QuantizedBvh&) = delete;
+    QuantizedBvh(QuantizedBvh&&) = default;
+    QuantizedBvh& operator=(QuantizedBvh&&) = default;
+
+    // Construction
+    void build(const glm::vec3* vertices, const uint32_t* indices, size_t triangleCount);
+    void attach(const QuantizedBvhNode* externalNodes, size_t count,
+                const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+    // Queries (local space of the mesh)
+    template <typename Callback>
+    void queryAabb(const BoundingBox& box, Callback&& callback) const;
+
+    template <typename Callback>
+    void queryRay(const glm::vec3& origin, const glm::vec3& direction, float maxT, Callback&& callback) const;
+
+    // Accessors
+    const QuantizedBvhNode* getNodes() const { return nodes; }
+    size_t getNodeCount() const { return nodeCount; }
+    const glm::vec3& getBoundsMin() const { return boundsMin; }
+    const glm::vec3& getBoundsMax() const { return boundsMax; }
+    BoundingBox getBounds() const { return BoundingBox(boundsMin, boundsMax); }
+
+    BoundingBox dequantize(const QuantizedBvhNode& node) const;
+
+private:
+    std::vector<QuantizedBvhNode> ownedNodes;
+    const QuantizedBvhNode* nodes = nullptr;
+    size_t nodeCount = 0;
+
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+    glm::vec3 quantization{1.0f};   // Quantized units per world unit
+
+    void setBounds(const glm::vec3& minimum, const glm::vec3& maximum);
+    void quantize(const BoundingBox& box, uint16_t outMin[3], uint16_t outMax[3]) const;
+
+    struct BuildTriangle {
+        BoundingBox bounds;
+        glm::vec3 centroid;
+        uint32_t index;
+    };
+    void buildRecursive(std::vector<BuildTriangle>& triangles, size_t begin, size_t end);
+};
+
+template <typename Callback>
+void QuantizedBvh::queryAabb(const BoundingBox& box, Callback&& callback) const {
+    uint16_t qMin[3], qMax[3];
+    quantize(box, qMin, qMax);
+
+    size_t index = 0;
+    while (index < nodeCount) {
+        const QuantizedBvhNode& node = nodes[index];
+        const bool overlap =
+            (qMin[0] <= node.quantizedMax[0]) & (qMax[0] >= node.quantizedMin[0]) &
+            (qMin[1] <= node.quantizedMax[1]) & (qMax[1] >= node.quantizedMin[1]) &
+            (qMin[2] <= node.quantizedMax[2]) & (qMax[2] >= node.quantizedMin[2]);
+
+        if (node.isLeaf()) {
+            if (overlap) callback(node.getTriangleIndex());
+            ++index;
+        } else {
+            index += overlap ? 1 : node.getEscapeIndex();
+        }
+    }
+}
+
+template <typename Callback>
+void QuantizedBvh::queryRay(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                            Callback&& callback) const {
+    glm::vec3 invDir = 1.0f / direction;
+
+    size_t index = 0;
+    while (index < nodeCount) {
+        const QuantizedBvhNode& node = nodes[index];
+        BoundingBox box = dequantize(node);
+        float tEnter;
+        const bool overlap = geometry::rayAabb(origin, invDir, box.min, box.max, maxT, tEnter);
+
+        if (node.isLeaf()) {
+            // Callback returns the new max distance so later nodes are culled
+            if (overlap) maxT = callback(node.getTriangleIndex(), maxT);
+            ++index;
+        } else {
+            index += overlap ? 1 : node.getEscapeIndex();
+        }
+    }
+}
+
+} // namespace engine::physics
@@ -2,6 +2,8 @@
 #include "../RigidBody.hpp"
 #include "../../core/Logger.hpp"
 #include <algorithm>
+#include <climits>
+#include <iterator>
 #include <sstream>
 #include <unordered_set>
 
@@ -15,6 +17,7 @@ SpatialHashBroadPhase::SpatialHashBroadPhase(float cellSize)
         this->cellSize = 5.0f;
         this->invCellSize = 0.2f;
     }
+    spareCells.reserve(spareCellLimit);
 }
 
 void SpatialHashBroadPhase::insertBody(RigidBody* body) {
@@ -34,6 +37,96 @@ void SpatialHashBroadPhase::removeBody(RigidBody* body) {
     removeBodyFromGrid(body);
     trackedBodies.erase(body);
     bodyToCells.erase(body);
+    proxies.erase(body);
+}
+
+void SpatialHashBroadPhase::insertBodies(const std::vector<RigidBody*>& bodies) {
+    trackedBodies.reserve(trackedBodies.size() + bodies.size());
+    proxies.reserve(proxies.size() + bodies.size());
+    bodyToCells.reserve(bodyToCells.size() + bodies.size());
+    
+    // Gather every (cell, body) assignment of the batch, then group by cell
+    // so each cell is looked up once and its list grows once. New bodies
+    // cannot already be in a cell, so the per-insert duplicate scan is skipped.
+    struct Assignment {
+        HashKey key;
+        CellEntry entry;
+    };
+    core::memory::FrameVector<Assignment> assignments;
+    core::memory::FrameVector<HashKey> cells;
+    
+    for (RigidBody* body : bodies) {
+        if (!body || !trackedBodies.insert(body).second) {
+            continue;
+        }
+        const Proxy& proxy = refreshProxy(body);
+        getAABBCells(proxy.aabb, cells);
+        bodyToCells[body].assign(cells.begin(), cells.end());
+        for (const HashKey& key : cells) {
+            assignments.push_back({key, {body, &proxy}});
+        }
+    }
+    
+    std::sort(assignments.begin(), assignments.end(),
+        [](const Assignment& a, const Assignment& b) { return a.key < b.key; });
+    
+    spatialGrid.reserve(spatialGrid.size() + assignments.size() / 2);
+    for (size_t begin = 0; begin < assignments.size();) {
+        size_t end = begin + 1;
+        while (end < assignments.size() && assignments[end].key == assignments[begin].key) {
+            ++end;
+        }
+        
+        CellData& cell = acquireCell(assignments[begin].key);
+        cell.entries.reserve(cell.entries.size() + (end - begin));
+        for (size_t i = begin; i < end; ++i) {
+            cell.entries.push_back(assignments[i].entry);
+        }
+        cell.lastUpdateFrame = currentFrame;
+        begin = end;
+    }
+    
+    updateStatistics();
+}
+
+void SpatialHashBroadPhase::removeBodies(const std::vector<RigidBody*>& bodies) {
+    // Sorted set of removed bodies plus the cells they touch; each touched
+    // cell is then filtered in a single pass
+    core::memory::FrameVector<RigidBody*> removed;
+    core::memory::FrameVector<HashKey> touched;
+    removed.reserve(bodies.size());
+    
+    for (RigidBody* body : bodies) {
+        auto it = bodyToCells.find(body);
+        if (!body || it == bodyToCells.end()) {
+            continue;
+        }
+        removed.push_back(body);
+        touched.insert(touched.end(), it->second.begin(), it->second.end());
+    }
+    
+    std::sort(removed.begin(), removed.end());
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    
+    for (const HashKey& key : touched) {
+        auto cellIt = spatialGrid.find(key);
+        if (cellIt == spatialGrid.end()) continue;
+        
+        auto& entries = cellIt->second.entries;
+        entries.erase(
+            std::remove_if(entries.begin(), entries.end(),
+                [&removed](const CellEntry& entry) {
+                    return std::binary_search(removed.begin(), removed.end(), entry.body);
+                }),
+            entries.end());
+    }
+    
+    for (RigidBody* body : removed) {
+        trackedBodies.erase(body);
+        bodyToCells.erase(body);
+        proxies.erase(body);
+    }
 }
 
 void SpatialHashBroadPhase::updateBody(RigidBody* body) {
@@ -56,7 +149,7 @@ void SpatialHashBroadPhase::updateAllBodies() {
     
     // Cleanup empty cells periodically
     if (currentFrame % 60 == 0) {
-        cleanupEmptyCells();
+        cleanupEmptyCells(EmptyCellLifetime);
     }
     
     auto end = std::chrono::high_resolution_clock::now();
@@ -65,22 +158,24 @@ void SpatialHashBroadPhase::updateAllBodies() {
     updateStatistics();
 }
 
-std::vector<CollisionPair> SpatialHashBroadPhase::findPotentialCollisions() {
-    std::unordered_set<CollisionPair> uniquePairs;
-    uniquePairs.reserve(trackedBodies.size() * 2); // Rough estimate
+void SpatialHashBroadPhase::findPotentialCollisions(std::vector<CollisionPair>& pairs) {
+    pairs.clear();
+    
+    // Gather candidates from every cell into frame scratch; bodies spanning
+    // several cells produce duplicates that sort + unique removes
+    core::memory::FrameVector<CollisionPair> candidates;
+    candidates.reserve(trackedBodies.size() * 2); // Rough estimate
     
-    // Process each cell
     for (auto& [key, cell] : spatialGrid) {
-        if (cell.bodies.size() >= 2) {
-            findPairsInCell(cell, uniquePairs);
+        if (cell.entries.size() >= 2) {
+            findPairsInCell(cell, candidates);
         }
     }
     
-    // Convert to vector
-    std::vector<CollisionPair> pairs;
-    pairs.reserve(uniquePairs.size());
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
     
-    for (const auto& pair : uniquePairs) {
+    for (const auto& pair : candidates) {
         if (shouldTestPair(pair.bodyA, pair.bodyB)) {
             pairs.push_back(pair);
             incrementPairCount();
@@ -88,61 +183,187 @@ std::vector<CollisionPair> SpatialHashBroadPhase::findPotentialCollisions() {
             incrementFilteredCount();
         }
     }
-    
-    return pairs;
 }
 
-std::vector<RigidBody*> SpatialHashBroadPhase::queryRegion(const glm::vec3& min, const glm::vec3& max) {
-    BoundingBox aabb(min, max);
-    std::vector<HashKey> cells = getAABBCells(aabb);
+void SpatialHashBroadPhase::queryRegion(const glm::vec3& min, const glm::vec3& max, BodyVisitor visitor,
+                                        const QueryFilter& filter) {
+    stats.totalQueries.fetch_add(1, std::memory_order_relaxed);
+    const BoundingBox aabb(min, max);
+    const HashKey minKey = getHashKey(min);
+    const HashKey maxKey = getHashKey(max);
+    
+    // Bodies spanning several cells are reported once, from the lowest cell
+    // they share with the query range. Nothing is written, so queries may run
+    // concurrently and nest inside visitors.
+    auto visitCell = [&](const HashKey& key, const CellData& cell) {
+        for (const CellEntry& entry : cell.entries) {
+            const Proxy& proxy = *entry.proxy;
+            if (!(key == HashKey(std::max(proxy.minCell.x, minKey.x), std::max(proxy.minCell.y, minKey.y),
+                                 std::max(proxy.minCell.z, minKey.z)))) {
+                continue;
+            }
+            
+            if (filter.accepts(proxy.filter) && aabb.intersects(proxy.aabb) && !visitor(entry.body)) {
+                return false;
+            }
+        }
+        return true;
+    };
     
-    std::unordered_set<RigidBody*> uniqueBodies;
+    const double rangeCells = (double(maxKey.x) - minKey.x + 1) * (double(maxKey.y) - minKey.y + 1) *
+                              (double(maxKey.z) - minKey.z + 1);
     
-    for (const HashKey& key : cells) {
-        auto it = spatialGrid.find(key);
-        if (it != spatialGrid.end()) {
-            for (RigidBody* body : it->second.bodies) {
-                BoundingBox bodyAABB = getBodyAABB(body);
-                if (aabb.intersects(bodyAABB)) {
-                    uniqueBodies.insert(body);
-                }
+    // Large regions walk the occupied cells instead of every cell in range
+    if (rangeCells > static_cast<double>(spatialGrid.size())) {
+        for (const auto& [key, cell] : spatialGrid) {
+            if (key.x < minKey.x || key.x > maxKey.x || key.y < minKey.y || key.y > maxKey.y ||
+                key.z < minKey.z || key.z > maxKey.z) {
+                continue;
             }
+            if (!visitCell(key, cell)) return;
         }
+        return;
     }
     
-    stats.totalQueries++;
-    return std::vector<RigidBody*>(uniqueBodies.begin(), uniqueBodies.end());
+    for (int x = minKey.x; x <= maxKey.x; ++x) {
+        for (int y = minKey.y; y <= maxKey.y; ++y) {
+            for (int z = minKey.z; z <= maxKey.z; ++z) {
+                auto it = spatialGrid.find(HashKey(x, y, z));
+                if (it != spatialGrid.end() && !visitCell(it->first, it->second)) {
+                    return;
+                }
+            }
+        }
+    }
 }
 
-std::vector<RigidBody*> SpatialHashBroadPhase::queryPoint(const glm::vec3& point) {
-    HashKey key = getHashKey(point);
-    std::vector<RigidBody*> result;
+void SpatialHashBroadPhase::queryPoint(const glm::vec3& point, BodyVisitor visitor, const QueryFilter& filter) {
+    stats.totalQueries.fetch_add(1, std::memory_order_relaxed);
     
-    auto it = spatialGrid.find(key);
-    if (it != spatialGrid.end()) {
-        for (RigidBody* body : it->second.bodies) {
-            BoundingBox bodyAABB = getBodyAABB(body);
-            if (point.x >= bodyAABB.min.x && point.x <= bodyAABB.max.x &&
-                point.y >= bodyAABB.min.y && point.y <= bodyAABB.max.y &&
-                point.z >= bodyAABB.min.z && point.z <= bodyAABB.max.z) {
-                result.push_back(body);
+    auto it = spatialGrid.find(getHashKey(point));
+    if (it == spatialGrid.end()) {
+        return;
+    }
+    
+    for (const CellEntry& entry : it->second.entries) {
+        const Proxy& proxy = *entry.proxy;
+        if (filter.accepts(proxy.filter) && proxy.aabb.contains(point) && !visitor(entry.body)) {
+            return;
+        }
+    }
+}
+
+void SpatialHashBroadPhase::queryRadius(const glm::vec3& center, float radius, BodyVisitor visitor,
+                                        const QueryFilter& filter) {
+    const glm::vec3 extent(radius);
+    const float radiusSq = radius * radius;
+    queryRegion(center - extent, center + extent, [&](RigidBody* body) {
+        // Sphere vs AABB: distance from the center to the box
+        const BoundingBox& box = proxies.find(body)->second.aabb;
+        const glm::vec3 offset = center - glm::clamp(center, box.min, box.max);
+        return glm::dot(offset, offset) > radiusSq || visitor(body);
+    }, filter);
+}
+
+size_t SpatialHashBroadPhase::queryNearest(const glm::vec3& point, size_t k, NearestHit* results,
+                                           const QueryFilter& filter) {
+    stats.totalQueries.fetch_add(1, std::memory_order_relaxed);
+    if (k == 0) return 0;
+    
+    // results doubles as a max-heap on squared distance, so the worst of the
+    // current k is always at the front and can be replaced in O(log k)
+    const auto farther = [](const NearestHit& a, const NearestHit& b) { return a.distance < b.distance; };
+    size_t count = 0;
+    const HashKey center = getHashKey(point);
+    
+    // Bodies spanning several cells are seen once, from their cell nearest the
+    // center: whole rings are visited in order, so it is always reached first
+    auto visitCell = [&](const HashKey& key, const CellData& cell) {
+        for (const CellEntry& entry : cell.entries) {
+            const Proxy& proxy = *entry.proxy;
+            if (!(key == HashKey(std::clamp(center.x, proxy.minCell.x, proxy.maxCell.x),
+                                 std::clamp(center.y, proxy.minCell.y, proxy.maxCell.y),
+                                 std::clamp(center.z, proxy.minCell.z, proxy.maxCell.z)))) {
+                continue;
+            }
+            if (!filter.accepts(proxy.filter)) continue;
+            
+            const glm::vec3 offset = point - glm::clamp(point, proxy.aabb.min, proxy.aabb.max);
+            const float distanceSq = glm::dot(offset, offset);
+            
+            if (count < k) {
+                results[count++] = {entry.body, distanceSq};
+                std::push_heap(results, results + count, farther);
+            } else if (distanceSq < results[0].distance) {
+                std::pop_heap(results, results + count, farther);
+                results[count - 1] = {entry.body, distanceSq};
+                std::push_heap(results, results + count, farther);
+            }
+        }
+    };
+    
+    // Cells in ring r+1 are at least r cells plus the point's distance to the
+    // nearest face of its own cell away
+    const glm::vec3 local = point * invCellSize - glm::vec3(center.x, center.y, center.z);
+    const glm::vec3 toFace = glm::min(local, glm::vec3(1.0f) - local);
+    const float faceDistance = std::min(toFace.x, std::min(toFace.y, toFace.z)) * cellSize;
+    
+    for (int ring = 0;; ++ring) {
+        // Once the cube of visited cells outgrows the grid, finish with one
+        // pass over the occupied cells; this also ends queries on sparse grids
+        const double side = 2.0 * ring + 1.0;
+        if (side * side * side > static_cast<double>(spatialGrid.size())) {
+            for (const auto& [key, cell] : spatialGrid) {
+                const int ringOfKey = std::max({std::abs(key.x - center.x), std::abs(key.y - center.y),
+                                                std::abs(key.z - center.z)});
+                if (ringOfKey >= ring) {
+                    visitCell(key, cell);
+                }
+            }
+            break;
+        }
+        
+        for (int x = center.x - ring; x <= center.x + ring; ++x) {
+            for (int y = center.y - ring; y <= center.y + ring; ++y) {
+                const bool onShell = std::abs(x - center.x) == ring || std::abs(y - center.y) == ring;
+                // Interior columns only touch the two z caps of the shell
+                const int zStep = onShell ? 1 : std::max(2 * ring, 1);
+                for (int z = center.z - ring; z <= center.z + ring; z += zStep) {
+                    auto it = spatialGrid.find(HashKey(x, y, z));
+                    if (it != spatialGrid.end()) {
+                        visitCell(it->first, it->second);
+                    }
+                }
             }
         }
+        
+        const float nextRingDistance = ring * cellSize + faceDistance;
+        if (count == k && results[0].distance <= nextRingDistance * nextRingDistance) {
+            break;
+        }
     }
     
-    stats.totalQueries++;
-    return result;
+    std::sort_heap(results, results + count, farther);
+    for (size_t i = 0; i < count; ++i) {
+        results[i].distance = std::sqrt(results[i].distance);
+    }
+    return count;
 }
 
 std::vector<RigidBody*> SpatialHashBroadPhase::queryRadius(const glm::vec3& center, float radius) {
-    glm::vec3 extent(radius);
-    return queryRegion(center - extent, center + extent);
+    std::vector<RigidBody*> result;
+    queryRadius(center, radius, [&](RigidBody* body) {
+        result.push_back(body);
+        return true;
+    });
+    return result;
 }
 
 void SpatialHashBroadPhase::clear() {
     spatialGrid.clear();
     trackedBodies.clear();
     bodyToCells.clear();
+    proxies.clear();
     currentFrame = 0;
     maxBodiesPerCell = 0;
     totalCellCount = 0;
@@ -150,27 +371,30 @@ void SpatialHashBroadPhase::clear() {
 }
 
 void SpatialHashBroadPhase::optimize() {
-    // Remove empty cells
-    cleanupEmptyCells();
+    // Remove empty cells, spares included
+    cleanupEmptyCells(0);
+    spareCells.clear();
     
     // Shrink containers
     for (auto& [key, cell] : spatialGrid) {
-        cell.bodies.shrink_to_fit();
+        cell.entries.shrink_to_fit();
     }
 }
 
 size_t SpatialHashBroadPhase::getMemoryUsage() const {
     size_t memory = sizeof(*this);
-    memory += spatialGrid.size() * (sizeof(HashKey) + sizeof(CellData));
+    memory += (spatialGrid.size() + spareCells.size()) * (sizeof(HashKey) + sizeof(CellData));
     memory += trackedBodies.size() * sizeof(RigidBody*);
-    memory += bodyToCells.size() * sizeof(std::pair<RigidBody*, std::vector<HashKey>>);
+    memory += bodyToCells.size() * sizeof(std::pair<RigidBody*, CellKeyList>);
+    memory += proxies.size() * sizeof(std::pair<RigidBody*, Proxy>);
     
+    // Lists count only once they spill out of their inline storage
     for (const auto& [body, cells] : bodyToCells) {
-        memory += cells.size() * sizeof(HashKey);
+        if (!cells.isInline()) memory += cells.capacity() * sizeof(HashKey);
     }
     
     for (const auto& [key, cell] : spatialGrid) {
-        memory += cell.bodies.size() * sizeof(RigidBody*);
+        if (!cell.entries.isInline()) memory += cell.entries.capacity() * sizeof(CellEntry);
     }
     
     return memory;
@@ -192,7 +416,7 @@ std::string SpatialHashBroadPhase::getDebugInfo() const {
     if (!spatialGrid.empty()) {
         size_t totalBodies = 0;
         for (const auto& [key, cell] : spatialGrid) {
-            totalBodies += cell.bodies.size();
+            totalBodies += cell.entries.size();
         }
         float avgBodiesPerCell = static_cast<float>(totalBodies) / spatialGrid.size();
         oss << "  Average Bodies per Cell: " << avgBodiesPerCell << "\n";
@@ -224,11 +448,14 @@ SpatialHashBroadPhase::HashKey SpatialHashBroadPhase::getHashKey(const glm::vec3
     );
 }
 
-std::vector<SpatialHashBroadPhase::HashKey> SpatialHashBroadPhase::getAABBCells(const BoundingBox& aabb) const {
+void SpatialHashBroadPhase::getAABBCells(const BoundingBox& aabb, core::memory::FrameVector<HashKey>& cells) const {
     HashKey minKey = getHashKey(aabb.min);
     HashKey maxKey = getHashKey(aabb.max);
     
-    std::vector<HashKey> cells;
+    cells.clear();
+    cells.reserve(static_cast<size_t>(maxKey.x - minKey.x + 1) *
+                  static_cast<size_t>(maxKey.y - minKey.y + 1) *
+                  static_cast<size_t>(maxKey.z - minKey.z + 1));
     
     for (int x = minKey.x; x <= maxKey.x; ++x) {
         for (int y = minKey.y; y <= maxKey.y; ++y) {
@@ -237,24 +464,66 @@ std::vector<SpatialHashBroadPhase::HashKey> SpatialHashBroadPhase::getAABBCells(
             }
         }
     }
-    
-    return cells;
 }
 
-std::vector<SpatialHashBroadPhase::HashKey> SpatialHashBroadPhase::getBodyCells(RigidBody* body) const {
+void SpatialHashBroadPhase::getBodyCells(RigidBody* body, core::memory::FrameVector<HashKey>& cells) const {
     BoundingBox aabb = getBodyAABB(body);
-    return getAABBCells(aabb);
+    getAABBCells(aabb, cells);
+}
+
+const SpatialHashBroadPhase::Proxy& SpatialHashBroadPhase::refreshProxy(RigidBody* body) {
+    Proxy& proxy = proxies[body];
+    proxy.aabb = getBodyAABB(body);
+    proxy.filter = body->getCollisionFilter();
+    proxy.minCell = getHashKey(proxy.aabb.min);
+    proxy.maxCell = getHashKey(proxy.aabb.max);
+    return proxy;
+}
+
+SpatialHashBroadPhase::CellData& SpatialHashBroadPhase::acquireCell(const HashKey& key) {
+    auto it = spatialGrid.find(key);
+    if (it != spatialGrid.end()) {
+        return it->second;
+    }
+    if (spareCells.empty()) {
+        return spatialGrid[key];
+    }
+    
+    // Spare cells are empty and keep their entry capacity
+    CellMap::node_type node = std::move(spareCells.back());
+    spareCells.pop_back();
+    node.key() = key;
+    node.mapped().lastUpdateFrame = currentFrame;
+    return spatialGrid.insert(std::move(node)).position->second;
+}
+
+void SpatialHashBroadPhase::reserveCells(size_t count) {
+    spareCellLimit = std::max(spareCellLimit, count);
+    spareCells.reserve(spareCellLimit);
+    spatialGrid.reserve(spatialGrid.size() + count);
+    
+    // Nodes can only come out of the map, so each spare is made under a key
+    // no body reaches and taken straight back out
+    for (int i = 0; spareCells.size() < count; ++i) {
+        auto [it, inserted] = spatialGrid.try_emplace(HashKey(INT_MIN, INT_MIN, i));
+        if (inserted) {
+            spareCells.push_back(spatialGrid.extract(it));
+        }
+    }
 }
 
 void SpatialHashBroadPhase::insertBodyIntoGrid(RigidBody* body) {
     if (!body) return;
     
-    std::vector<HashKey> cells = getBodyCells(body);
-    bodyToCells[body] = cells;
+    const Proxy& proxy = refreshProxy(body);
+    core::memory::FrameVector<HashKey> cells;
+    getAABBCells(proxy.aabb, cells);
+    bodyToCells[body].assign(cells.begin(), cells.end());
     
     for (const HashKey& key : cells) {
-        spatialGrid[key].addBody(body);
-        spatialGrid[key].lastUpdateFrame = currentFrame;
+        CellData& cell = acquireCell(key);
+        cell.addBody(body, &proxy);
+        cell.lastUpdateFrame = currentFrame;
     }
 }
 
@@ -275,52 +544,76 @@ void SpatialHashBroadPhase::removeBodyFromGrid(RigidBody* body) {
 void SpatialHashBroadPhase::updateBodyInGrid(RigidBody* body) {
     if (!body) return;
     
-    std::vector<HashKey> newCells = getBodyCells(body);
-    
     auto it = bodyToCells.find(body);
-    if (it != bodyToCells.end()) {
-        const std::vector<HashKey>& oldCells = it->second;
-        
-        // Check if cells have changed
-        if (oldCells != newCells) {
-            // Remove from old cells
-            for (const HashKey& key : oldCells) {
-                auto cellIt = spatialGrid.find(key);
-                if (cellIt != spatialGrid.end()) {
-                    cellIt->second.removeBody(body);
-                }
-            }
-            
-            // Add to new cells
-            for (const HashKey& key : newCells) {
-                spatialGrid[key].addBody(body);
-                spatialGrid[key].lastUpdateFrame = currentFrame;
+    if (it == bodyToCells.end()) {
+        insertBodyIntoGrid(body);
+        return;
+    }
+    
+    // Refresh AABB and filter in place; cell entries point at this proxy
+    const Proxy& proxy = refreshProxy(body);
+    core::memory::FrameVector<HashKey> newCells;
+    getAABBCells(proxy.aabb, newCells);
+    const CellKeyList& oldCells = it->second;
+    
+    // Check if cells have changed
+    if (!std::equal(oldCells.begin(), oldCells.end(), newCells.begin(), newCells.end())) {
+        // Remove from old cells
+        for (const HashKey& key : oldCells) {
+            auto cellIt = spatialGrid.find(key);
+            if (cellIt != spatialGrid.end()) {
+                cellIt->second.removeBody(body);
             }
-            
-            // Update mapping
-            it->second = newCells;
         }
-    } else {
-        insertBodyIntoGrid(body);
+        
+        // Add to new cells
+        for (const HashKey& key : newCells) {
+            CellData& cell = acquireCell(key);
+            cell.addBody(body, &proxy);
+            cell.lastUpdateFrame = currentFrame;
+        }
+        
+        // Update mapping
+        it->second.assign(newCells.begin(), newCells.end());
     }
 }
 
-void SpatialHashBroadPhase::findPairsInCell(const CellData& cell, std::unordered_set<CollisionPair>& pairs) {
-    const std::vector<RigidBody*>& bodies = cell.bodies;
+void SpatialHashBroadPhase::findPairsInCell(const CellData& cell, core::memory::FrameVector<CollisionPair>& pairs) {
+    const CellEntryList& entries = cell.entries;
     
-    for (size_t i = 0; i < bodies.size(); ++i) {
-        for (size_t j = i + 1; j < bodies.size(); ++j) {
-            CollisionPair pair(bodies[i], bodies[j]);
-            pairs.insert(pair);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const Proxy& proxyA = *entries[i].proxy;
+        
+        for (size_t j = i + 1; j < entries.size(); ++j) {
+            const Proxy& proxyB = *entries[j].proxy;
+            
+            // Reject on filter bits and AABB overlap before the pair is hashed
+            const bool keep = proxyA.filter.canCollide(proxyB.filter) &
+                              proxyA.aabb.intersects(proxyB.aabb);
+            if (!keep) {
+                incrementFilteredCount();
+                continue;
+            }
+            
+            pairs.emplace_back(entries[i].body, entries[j].body);
         }
     }
 }
 
-void SpatialHashBroadPhase::cleanupEmptyCells() {
+void SpatialHashBroadPhase::cleanupEmptyCells(uint32_t minIdleFrames) {
+    // Cells a body entered recently are kept even when empty: a body resting
+    // on a cell boundary keeps moving in and out, and erasing the cell would
+    // free and reallocate its node and entry list every cleanup
     auto it = spatialGrid.begin();
     while (it != spatialGrid.end()) {
-        if (it->second.isEmpty()) {
-            it = spatialGrid.erase(it);
+        if (it->second.isEmpty() && currentFrame - it->second.lastUpdateFrame >= minIdleFrames) {
+            if (spareCells.size() < spareCellLimit) {
+                auto next = std::next(it);
+                spareCells.push_back(spatialGrid.extract(it));
+                it = next;
+            } else {
+                it = spatialGrid.erase(it);
+            }
         } else {
             ++it;
         }
@@ -349,7 +642,7 @@ void SpatialHashBroadPhase::updateStatistics() {
     totalCellCount = spatialGrid.size();
     
     for (const auto& [key, cell] : spatialGrid) {
-        maxBodiesPerCell = std::max(maxBodiesPerCell, cell.bodies.size());
+        maxBodiesPerCell = std::max(maxBodiesPerCell, cell.entries.size());
     }
 }
 
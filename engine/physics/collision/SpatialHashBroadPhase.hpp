@@ -1,6 +1,10 @@
 #pragma once
 #include "BroadPhase.hpp"
 #include "../CollisionShape.hpp"
+#include "CollisionFilter.hpp"
+#include "../../core/FrameArena.hpp"
+#include "../../core/SmallVector.hpp"
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <chrono>
@@ -21,10 +25,19 @@ public:
     void removeBody(RigidBody* body) override;
     void updateBody(RigidBody* body) override;
     void updateAllBodies() override;
-    
-    std::vector<CollisionPair> findPotentialCollisions() override;
-    std::vector<RigidBody*> queryRegion(const glm::vec3& min, const glm::vec3& max) override;
-    std::vector<RigidBody*> queryPoint(const glm::vec3& point) override;
+    void insertBodies(const std::vector<RigidBody*>& bodies) override;
+    void removeBodies(const std::vector<RigidBody*>& bodies) override;
+    
+    void findPotentialCollisions(std::vector<CollisionPair>& pairs) override;
+    void queryRegion(const glm::vec3& min, const glm::vec3& max, BodyVisitor visitor,
+                     const QueryFilter& filter = QueryFilter{}) override;
+    void queryPoint(const glm::vec3& point, BodyVisitor visitor,
+                    const QueryFilter& filter = QueryFilter{}) override;
+    size_t queryNearest(const glm::vec3& point, size_t k, NearestHit* results,
+                        const QueryFilter& filter = QueryFilter{}) override;
+    using BroadPhase::queryRegion;
+    using BroadPhase::queryPoint;
+    using BroadPhase::queryNearest;
     
     void clear() override;
     void optimize() override;
@@ -38,7 +51,13 @@ public:
     void setCellSize(float size);
     float getCellSize() const { return cellSize; }
     
-    // Advanced queries
+    // Keeps at least count spare cells, so bodies moving into that many new
+    // cells (beyond the ones cleanup recycles) do not allocate
+    void reserveCells(size_t count);
+    
+    // Advanced queries; the sphere is tested against each proxy AABB exactly
+    void queryRadius(const glm::vec3& center, float radius, BodyVisitor visitor,
+                     const QueryFilter& filter = QueryFilter{});
     std::vector<RigidBody*> queryRadius(const glm::vec3& center, float radius);
     
 private:
@@ -69,32 +88,62 @@ private:
         }
     };
     
+    // Per-body broad phase data; the filter sits next to the AABB so the
+    // pair loop rejects filtered pairs without touching the RigidBody
+    struct Proxy {
+        BoundingBox aabb;
+        CollisionFilter filter;
+        HashKey minCell, maxCell;          // Cells the AABB spans
+    };
+    
+    struct CellEntry {
+        RigidBody* body;
+        const Proxy* proxy;
+    };
+    
+    // Inline sizes cover the common case of a few bodies per cell and a
+    // body spanning at most a 2x2x2 block of cells
+    using CellEntryList = core::memory::SmallVector<CellEntry, 8>;
+    using CellKeyList = core::memory::SmallVector<HashKey, 8>;
+    
     struct CellData {
-        std::vector<RigidBody*> bodies;
+        CellEntryList entries;
         uint32_t lastUpdateFrame = 0;
         
-        void addBody(RigidBody* body) {
-            if (std::find(bodies.begin(), bodies.end(), body) == bodies.end()) {
-                bodies.push_back(body);
+        void addBody(RigidBody* body, const Proxy* proxy) {
+            auto it = std::find_if(entries.begin(), entries.end(),
+                [body](const CellEntry& entry) { return entry.body == body; });
+            if (it == entries.end()) {
+                entries.push_back({body, proxy});
             }
         }
         
         void removeBody(RigidBody* body) {
-            bodies.erase(
-                std::remove(bodies.begin(), bodies.end(), body),
-                bodies.end()
+            entries.erase(
+                std::remove_if(entries.begin(), entries.end(),
+                    [body](const CellEntry& entry) { return entry.body == body; }),
+                entries.end()
             );
         }
         
-        bool isEmpty() const { return bodies.empty(); }
+        bool isEmpty() const { return entries.empty(); }
     };
     
     float cellSize;
     float invCellSize;  // 1.0f / cellSize for faster division
     
-    std::unordered_map<HashKey, CellData, HashKeyHash> spatialGrid;
+    using CellMap = std::unordered_map<HashKey, CellData, HashKeyHash>;
+    CellMap spatialGrid;
+    
+    // Cells taken out by cleanup, kept as map nodes for the next new cell so
+    // bodies moving into fresh space reuse them instead of allocating
+    std::vector<CellMap::node_type> spareCells;
+    size_t spareCellLimit = 1024;
     std::unordered_set<RigidBody*> trackedBodies;
-    std::unordered_map<RigidBody*, std::vector<HashKey>> bodyToCells;
+    std::unordered_map<RigidBody*, CellKeyList> bodyToCells;
+    std::unordered_map<RigidBody*, Proxy> proxies;  // Node-based, so Proxy addresses stay stable
+    
+    static constexpr uint32_t EmptyCellLifetime = 120;   // Frames an empty cell survives cleanup
     
     uint32_t currentFrame = 0;
     size_t maxBodiesPerCell = 0;
@@ -102,17 +151,19 @@ private:
     
     // Hash computation
     HashKey getHashKey(const glm::vec3& position) const;
-    std::vector<HashKey> getAABBCells(const BoundingBox& aabb) const;
-    std::vector<HashKey> getBodyCells(RigidBody* body) const;
+    void getAABBCells(const BoundingBox& aabb, core::memory::FrameVector<HashKey>& cells) const;
+    void getBodyCells(RigidBody* body, core::memory::FrameVector<HashKey>& cells) const;
+    const Proxy& refreshProxy(RigidBody* body);
     
     // Grid management
+    CellData& acquireCell(const HashKey& key);
     void insertBodyIntoGrid(RigidBody* body);
     void removeBodyFromGrid(RigidBody* body);
     void updateBodyInGrid(RigidBody* body);
     
     // Collision detection helpers
-    void findPairsInCell(const CellData& cell, std::unordered_set<CollisionPair>& pairs);
-    void cleanupEmptyCells();
+    void findPairsInCell(const CellData& cell, core::memory::FrameVector<CollisionPair>& pairs);
+    void cleanupEmptyCells(uint32_t minIdleFrames);
     
     // Transform helpers
     Transform getRigidBodyTransform(RigidBody* body) const;
@@ -0,0 +1,291 @@
+#include "TriangleCollision.hpp"
+#include "GeometryUtils.hpp"
+#include "../shapes/ConvexHullShape.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace engine::physics::geometry {
+
+size_t collideSphereTriangle(const glm::vec3& center, float radius,
+                             const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                             MeshContact* out) {
+    glm::vec3 closest = closestPointOnTriangle(center, a, b, c);
+    glm::vec3 delta = center - closest;
+    float distSq = glm::dot(delta, delta);
+    if (distSq >= radius * radius) return 0;
+
+    float dist = std::sqrt(distSq);
+    glm::vec3 normal = dist > 0.0001f ? delta / dist : glm::normalize(glm::cross(b - a, c - a));
+
+    out[0].normal = normal;
+    out[0].pointOnMesh = closest;
+    out[0].pointOnOther = center - normal * radius;
+    out[0].depth = radius - dist;
+    return 1;
+}
+
+size_t collideCapsuleTriangle(const glm::vec3& p, const glm::vec3& q, float radius,
+                              const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                              MeshContact* out) {
+    glm::vec3 faceNormal = glm::normalize(glm::cross(b - a, c - a));
+    size_t count = 0;
+
+    auto emit = [&](const glm::vec3& onSegment, const glm::vec3& onTriangle, float distSq) {
+        float dist = std::sqrt(distSq);
+        glm::vec3 normal = dist > 0.0001f ? (onSegment - onTriangle) / dist : faceNormal;
+
+        out[count].normal = normal;
+        out[count].pointOnMesh = onTriangle;
+        out[count].pointOnOther = onSegment - normal * radius;
+        out[count].depth = radius - dist;
+        ++count;
+    };
+
+    // Cap contacts give a two-point manifold when the capsule lies on a face
+    for (const glm::vec3& end : {p, q}) {
+        glm::vec3 closest = closestPointOnTriangle(end, a, b, c);
+        float distSq = glm::dot(end - closest, end - closest);
+        if (distSq < radius * radius) {
+            emit(end, closest, distSq);
+        }
+    }
+    if (count > 0) return count;
+
+    glm::vec3 onSegment, onTriangle;
+    float distSq = closestPointsSegmentTriangle(p, q, a, b, c, onSegment, onTriangle);
+    if (distSq < radius * radius) {
+        emit(onSegment, onTriangle, distSq);
+    }
+    return count;
+}
+
+size_t collideBoxTriangle(const glm::vec3& center, const glm::vec3 axes[3], const glm::vec3& halfExtents,
+                          const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                          MeshContact* out) {
+    const glm::vec3 v[3] = { a, b, c };
+    const glm::vec3 edges[3] = { b - a, c - b, a - c };
+    glm::vec3 faceNormal = glm::cross(edges[0], -edges[2]);
+    if (glm::dot(faceNormal, faceNormal) < 1e-12f) return 0;  // Degenerate triangle
+    faceNormal = glm::normalize(faceNormal);
+
+    // SAT over face normal, box axes and the nine edge cross products
+    glm::vec3 testAxes[13];
+    int axisCount = 0;
+    testAxes[axisCount++] = faceNormal;
+    for (int i = 0; i < 3; ++i) testAxes[axisCount++] = axes[i];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            glm::vec3 axis = glm::cross(axes[i], edges[j]);
+            float lenSq = glm::dot(axis, axis);
+            if (lenSq > 1e-8f) testAxes[axisCount++] = axis / std::sqrt(lenSq);
+        }
+    }
+
+    float bestDepth = FLT_MAX;
+    float bestScore = FLT_MAX;
+    glm::vec3 bestAxis = faceNormal;
+    for (int k = 0; k < axisCount; ++k) {
+        const glm::vec3& axis = testAxes[k];
+        float boxRadius = halfExtents.x * std::abs(glm::dot(axes[0], axis)) +
+                          halfExtents.y * std::abs(glm::dot(axes[1], axis)) +
+                          halfExtents.z * std::abs(glm::dot(axes[2], axis));
+        float p0 = glm::dot(v[0] - center, axis);
+        float p1 = glm::dot(v[1] - center, axis);
+        float p2 = glm::dot(v[2] - center, axis);
+        float triMin = std::min(p0, std::min(p1, p2));
+        float triMax = std::max(p0, std::max(p1, p2));
+
+        if (triMin > boxRadius || triMax < -boxRadius) return 0;  // Separated
+
+        // Overlap if pushed one way or the other; keep the smaller push
+        float pushPositive = boxRadius - triMin;   // Box moves along -axis
+        float pushNegative = triMax + boxRadius;   // Box moves along +axis
+        float depth = std::min(pushPositive, pushNegative);
+        // Bias selection slightly toward the face normal for stable resting contacts
+        float score = k == 0 ? depth * 0.95f : depth;
+        if (score < bestScore) {
+            bestScore = score;
+            bestDepth = depth;
+            bestAxis = pushNegative < pushPositive ? axis : -axis;
+        }
+    }
+
+    // bestAxis now points from the triangle toward the box
+    const bool faceAxis = std::abs(glm::dot(bestAxis, faceNormal)) > 0.999f;
+    glm::vec3 triCenter = (v[0] + v[1] + v[2]) / 3.0f;
+    if (glm::dot(bestAxis, center - triCenter) < 0.0f && !faceAxis) {
+        bestAxis = -bestAxis;
+    }
+
+    size_t count = 0;
+    auto emit = [&](const glm::vec3& boxPoint, float depth) {
+        out[count].normal = bestAxis;
+        out[count].pointOnOther = boxPoint;
+        out[count].pointOnMesh = boxPoint + bestAxis * depth;
+        out[count].depth = depth;
+        ++count;
+    };
+
+    if (faceAxis) {
+        // Face contact: every box corner below the plane that projects inside the triangle
+        float planeOffset = glm::dot(bestAxis, v[0]);
+        for (int i = 0; i < 8; ++i) {
+            glm::vec3 corner = center +
+                axes[0] * ((i & 1) ? halfExtents.x : -halfExtents.x) +
+                axes[1] * ((i & 2) ? halfExtents.y : -halfExtents.y) +
+                axes[2] * ((i & 4) ? halfExtents.z : -halfExtents.z);
+            float depth = planeOffset - glm::dot(bestAxis, corner);
+            if (depth <= 0.0f) continue;
+
+            glm::vec3 projected = corner + bestAxis * depth;
+            glm::vec3 closest = closestPointOnTriangle(projected, v[0], v[1], v[2]);
+            if (glm::dot(projected - closest, projected - closest) < 1e-6f) {
+                emit(corner, depth);
+            }
+        }
+        if (count > 0) return count;
+    }
+
+    // Edge or vertex contact: deepest box point along the separating axis
+    glm::vec3 deepest = center;
+    for (int i = 0; i < 3; ++i) {
+        deepest -= axes[i] * (glm::dot(axes[i], bestAxis) > 0.0f ? halfExtents[i] : -halfExtents[i]);
+    }
+    emit(deepest, bestDepth);
+    return count;
+}
+
+size_t collideHullTriangle(const ConvexHullShape& hull, const glm::quat& rotation, const glm::vec3& position,
+                           const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                           uint32_t supportHints[2], MeshContact* out) {
+    // Work in the hull's local space: three points move instead of the hull
+    const glm::quat inverse = glm::inverse(rotation);
+    const glm::vec3 v[3] = { inverse * (a - position), inverse * (b - position), inverse * (c - position) };
+    const glm::vec3 edges[3] = { v[1] - v[0], v[2] - v[1], v[0] - v[2] };
+    glm::vec3 faceNormal = glm::cross(edges[0], -edges[2]);
+    if (glm::dot(faceNormal, faceNormal) < 1e-12f) return 0;  // Degenerate triangle
+    faceNormal = glm::normalize(faceNormal);
+
+    float bestDepth = FLT_MAX;
+    float bestScore = FLT_MAX;
+    glm::vec3 bestAxis = faceNormal;
+
+    // False when the axis separates; otherwise keeps it if it needs the smallest push
+    auto testAxis = [&](const glm::vec3& axis, float hullMin, float hullMax, float bias) {
+        float p0 = glm::dot(v[0], axis);
+        float p1 = glm::dot(v[1], axis);
+        float p2 = glm::dot(v[2], axis);
+        float triMin = std::min(p0, std::min(p1, p2));
+        float triMax = std::max(p0, std::max(p1, p2));
+        if (triMin > hullMax || triMax < hullMin) return false;
+
+        float pushPositive = hullMax - triMin;   // Hull moves along -axis
+        float pushNegative = triMax - hullMin;   // Hull moves along +axis
+        float depth = std::min(pushPositive, pushNegative);
+        if (depth * bias < bestScore) {
+            bestScore = depth * bias;
+            bestDepth = depth;
+            bestAxis = pushNegative < pushPositive ? axis : -axis;
+        }
+        return true;
+    };
+    auto hullRange = [&](const glm::vec3& axis, float& hullMin, float& hullMax) {
+        supportHints[0] = hull.getSupportVertex(-axis, supportHints[0]);
+        supportHints[1] = hull.getSupportVertex(axis, supportHints[1]);
+        hullMin = glm::dot(hull.getVertex(supportHints[0]), axis);
+        hullMax = glm::dot(hull.getVertex(supportHints[1]), axis);
+    };
+
+    // SAT over the triangle normal, the hull's faces and the edge cross products.
+    // The triangle normal is slightly favoured for stable resting contacts.
+    float hullMin, hullMax;
+    hullRange(faceNormal, hullMin, hullMax);
+    if (!testAxis(faceNormal, hullMin, hullMax, 0.95f)) return 0;
+
+    for (uint32_t i = 0; i < hull.getFaceCount(); ++i) {
+        const auto& face = hull.getFace(i);
+        supportHints[0] = hull.getSupportVertex(-face.normal, supportHints[0]);
+        if (!testAxis(face.normal, glm::dot(hull.getVertex(supportHints[0]), face.normal), face.offset, 1.0f)) {
+            return 0;
+        }
+    }
+
+    for (const auto& edge : hull.getEdges()) {
+        glm::vec3 direction = hull.getVertex(edge.b) - hull.getVertex(edge.a);
+        for (const glm::vec3& triangleEdge : edges) {
+            glm::vec3 axis = glm::cross(direction, triangleEdge);
+            float lengthSq = glm::dot(axis, axis);
+            if (lengthSq <= 1e-8f * glm::dot(direction, direction) * glm::dot(triangleEdge, triangleEdge)) continue;
+            axis /= std::sqrt(lengthSq);
+            hullRange(axis, hullMin, hullMax);
+            if (!testAxis(axis, hullMin, hullMax, 1.0f)) return 0;
+        }
+    }
+
+    // bestAxis now points from the triangle toward the hull
+    const bool faceAxis = std::abs(glm::dot(bestAxis, faceNormal)) > 0.999f;
+    glm::vec3 triCenter = (v[0] + v[1] + v[2]) / 3.0f;
+    if (glm::dot(bestAxis, hull.getCenterOfMass() - triCenter) < 0.0f && !faceAxis) {
+        bestAxis = -bestAxis;
+    }
+
+    size_t count = 0;
+    const glm::vec3 normal = rotation * bestAxis;
+    auto emit = [&](const glm::vec3& hullPoint, float depth) {
+        out[count].normal = normal;
+        out[count].pointOnOther = position + rotation * hullPoint;
+        out[count].pointOnMesh = position + rotation * (hullPoint + bestAxis * depth);
+        out[count].depth = depth;
+        ++count;
+    };
+
+    if (faceAxis) {
+        // Face contact: hull vertices below the plane that project inside the triangle
+        float planeOffset = glm::dot(bestAxis, v[0]);
+        for (const glm::vec3& vertex : hull.getVertices()) {
+            float depth = planeOffset - glm::dot(bestAxis, vertex);
+            if (depth <= 0.0f) continue;
+
+            glm::vec3 projected = vertex + bestAxis * depth;
+            glm::vec3 closest = closestPointOnTriangle(projected, v[0], v[1], v[2]);
+            if (glm::dot(projected - closest, projected - closest) < 1e-6f) {
+                emit(vertex, depth);
+                if (count == MaxHullTriangleContacts) break;
+            }
+        }
+        if (count > 0) return count;
+    }
+
+    // Edge or vertex contact: deepest hull point along the separating axis
+    supportHints[0] = hull.getSupportVertex(-bestAxis, supportHints[0]);
+    emit(hull.getVertex(supportHints[0]), bestDepth);
+    return count;
+}
+
+void appendMeshContacts(const MeshContact* local, size_t localCount, uint32_t triangle,
+                        const Transform& transform, MeshContact* contacts,
+                        size_t& count, size_t maxContacts) {
+    for (size_t i = 0; i < localCount; ++i) {
+        MeshContact contact;
+        contact.pointOnMesh = transform.position + transform.rotation * local[i].pointOnMesh;
+        contact.pointOnOther = transform.position + transform.rotation * local[i].pointOnOther;
+        contact.normal = transform.rotation * local[i].normal;
+        contact.depth = local[i].depth;
+        contact.triangle = triangle;
+
+        if (count < maxContacts) {
+            contacts[count++] = contact;
+            continue;
+        }
+
+        // Full: replace the shallowest contact if this one is deeper
+        MeshContact* shallowest = std::min_element(contacts, contacts + count,
+            [](const MeshContact& x, const MeshContact& y) { return x.depth < y.depth; });
+        if (contact.depth > shallowest->depth) {
+            *shallowest = contact;
+        }
+    }
+}
+
+} // namespace engine::physics::geometry
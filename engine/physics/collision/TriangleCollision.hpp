@@ -0,0 +1,59 @@
+#pragma once
+#include "../CollisionShape.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::physics {
+
+class ConvexHullShape;
+
+// Contact against a single triangle of a concave shape, normal points from the triangle to the other shape
+struct MeshContact {
+    glm::vec3 pointOnMesh;
+    glm::vec3 pointOnOther;
+    glm::vec3 normal;
+    float depth;
+    uint32_t triangle;
+};
+
+/**
+ * @brief Convex vs single triangle contact kernels
+ * Shared by the concave shapes (triangle meshes, heightfields) which only
+ * differ in how they find candidate triangles. All inputs and outputs are in
+ * the concave shape's local space; the triangle id is left for the caller.
+ */
+namespace geometry {
+
+constexpr size_t MaxSphereTriangleContacts = 1;
+constexpr size_t MaxCapsuleTriangleContacts = 2;
+constexpr size_t MaxBoxTriangleContacts = 8;
+constexpr size_t MaxHullTriangleContacts = 8;
+
+size_t collideSphereTriangle(const glm::vec3& center, float radius,
+                             const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                             MeshContact* out);
+
+size_t collideCapsuleTriangle(const glm::vec3& p, const glm::vec3& q, float radius,
+                              const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                              MeshContact* out);
+
+size_t collideBoxTriangle(const glm::vec3& center, const glm::vec3 axes[3], const glm::vec3& halfExtents,
+                          const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                          MeshContact* out);
+
+// The hull is placed in the concave shape's space by rotation and position.
+// supportHints are start vertices for the searches toward -axis and +axis;
+// they are updated, so passing them along from triangle to triangle keeps
+// each climb short.
+size_t collideHullTriangle(const ConvexHullShape& hull, const glm::quat& rotation, const glm::vec3& position,
+                           const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                           uint32_t supportHints[2], MeshContact* out);
+
+// Move local contacts to world space and append them, keeping the deepest when full
+void appendMeshContacts(const MeshContact* local, size_t localCount, uint32_t triangle,
+                        const Transform& transform, MeshContact* contacts,
+                        size_t& count, size_t maxContacts);
+
+} // namespace geometry
+
+} // namespace engine::physics
@@ -374,7 +374,7 @@ void ConstraintSolver::storeContactImpulses(std::vector<ContactManifold>& contac
        auto& manifold = contacts[i];
        auto& solverContact = solverContacts[i];
        
-       auto& contactPoints = const_cast<std::vector<ContactPoint>&>(manifold.getContacts());
+       auto& contactPoints = const_cast<ContactManifold::ContactList&>(manifold.getContacts());
        
        for (size_t j = 0; j < contactPoints.size() && j < solverContact.points.size(); ++j) {
            contactPoints[j].normalImpulse = solverContact.points[j].normalImpulse;
@@ -0,0 +1,172 @@
+#include "CompoundShape.hpp"
+#include "../collision/GeometryUtils.hpp"
+#include <algorithm>
+
+namespace engine::physics {
+
+CompoundShape::CompoundShape(std::vector<Child> initialChildren)
+    : children(std::move(initialChildren)) {
+    children.erase(std::remove_if(children.begin(), children.end(),
+                                  [](const Child& child) { return !child.shape; }),
+                   children.end());
+    rebuild();
+}
+
+void CompoundShape::addChild(std::shared_ptr<CollisionShape> shape, const Transform& localTransform) {
+    if (!shape) return;
+    Transform recentered = localTransform;
+    recentered.position -= centerOfMass;
+    children.push_back({std::move(shape), recentered});
+    rebuild();
+}
+
+void CompoundShape::removeChild(size_t index) {
+    if (index >= children.size()) return;
+    children.erase(children.begin() + static_cast<std::ptrdiff_t>(index));
+    rebuild();
+}
+
+void CompoundShape::rebuild() {
+    // Back to the authoring frame, then onto the new center of mass
+    for (Child& child : children) {
+        child.localTransform.position += centerOfMass;
+    }
+    computeMassProperties();
+    for (Child& child : children) {
+        child.localTransform.position -= centerOfMass;
+    }
+
+    childBounds.clear();
+    nodes.clear();
+    for (const Child& child : children) {
+        childBounds.push_back(child.shape->getAABB(child.localTransform));
+    }
+
+    if (!children.empty()) {
+        std::vector<uint32_t> order(children.size());
+        for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+        nodes.reserve(children.size() * 2 - 1);
+        buildNode(order, 0, order.size());
+    }
+}
+
+void CompoundShape::buildNode(std::vector<uint32_t>& order, size_t begin, size_t end) {
+    size_t nodeIndex = nodes.size();
+    nodes.emplace_back();
+
+    BoundingBox bounds;
+    for (size_t i = begin; i < end; ++i) {
+        bounds = bounds.merge(childBounds[order[i]]);
+    }
+    nodes[nodeIndex].bounds = bounds;
+
+    if (end - begin == 1) {
+        nodes[nodeIndex].escapeIndexOrChild = static_cast<int32_t>(order[begin]);
+        return;
+    }
+
+    // Median split on the widest axis of the node bounds
+    glm::vec3 extent = bounds.getSize();
+    int axis = (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+    size_t split = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + split, order.begin() + end,
+        [this, axis](uint32_t a, uint32_t b) {
+            return childBounds[a].getCenter()[axis] < childBounds[b].getCenter()[axis];
+        });
+
+    buildNode(order, begin, split);
+    buildNode(order, split, end);
+
+    nodes[nodeIndex].escapeIndexOrChild = -static_cast<int32_t>(nodes.size() - nodeIndex);
+}
+
+void CompoundShape::computeMassProperties() {
+    volume = 0.0f;
+    glm::vec3 weightedCenter(0.0f);
+    for (const Child& child : children) {
+        float childVolume = child.shape->calculateVolume();
+        volume += childVolume;
+        weightedCenter += childVolume * child.localTransform.position;
+    }
+
+    if (volume <= FLT_EPSILON) {
+        centerOfMass = glm::vec3(0.0f);
+        unitInertia = glm::mat3(1.0f);
+        return;
+    }
+    centerOfMass = weightedCenter / volume;
+
+    // Rotate each child's tensor into the compound frame and shift it to the center of mass
+    unitInertia = glm::mat3(0.0f);
+    for (const Child& child : children) {
+        float fraction = child.shape->calculateVolume() / volume;
+        if (fraction <= 0.0f) continue;
+
+        glm::mat3 rotation = glm::mat3_cast(child.localTransform.rotation);
+        glm::mat3 local = rotation * child.shape->calculateInertiaTensor(fraction) * glm::transpose(rotation);
+        glm::vec3 d = child.localTransform.position - centerOfMass;
+        unitInertia += local + fraction * (glm::mat3(glm::dot(d, d)) - glm::outerProduct(d, d));
+    }
+}
+
+BoundingBox CompoundShape::getAABB(const Transform& transform) const {
+    BoundingBox bounds;
+    for (const Child& child : children) {
+        bounds = bounds.merge(child.shape->getAABB(transform * child.localTransform));
+    }
+    if (children.empty()) {
+        bounds = BoundingBox(transform.position, transform.position);
+    }
+    return bounds;
+}
+
+bool CompoundShape::raycast(const Ray& ray, const Transform& transform, RaycastHit& hit) const {
+    glm::quat inverseRotation = glm::inverse(transform.rotation);
+    glm::vec3 origin = inverseRotation * (ray.origin - transform.position);
+    glm::vec3 invDir = 1.0f / (inverseRotation * ray.direction);
+
+    float closest = ray.maxDistance;
+    bool found = false;
+
+    size_t index = 0;
+    while (index < nodes.size()) {
+        const Node& node = nodes[index];
+        float tEnter;
+        const bool overlap = geometry::rayAabb(origin, invDir, node.bounds.min, node.bounds.max, closest, tEnter);
+
+        if (node.escapeIndexOrChild >= 0) {
+            if (overlap) {
+                const Child& child = children[static_cast<size_t>(node.escapeIndexOrChild)];
+                RaycastHit childHit;
+                Ray clipped(ray.origin, ray.direction, closest);
+                if (child.shape->raycast(clipped, transform * child.localTransform, childHit) &&
+                    childHit.distance <= closest) {
+                    closest = childHit.distance;
+                    hit = childHit;
+                    found = true;
+                }
+            }
+            ++index;
+        } else {
+            index += overlap ? 1 : static_cast<size_t>(-node.escapeIndexOrChild);
+        }
+    }
+
+    return found;
+}
+
+glm::vec3 CompoundShape::support(const glm::vec3& direction, const Transform& transform) const {
+    glm::vec3 best = transform.position;
+    float bestDot = -FLT_MAX;
+    for (const Child& child : children) {
+        glm::vec3 point = child.shape->support(direction, transform * child.localTransform);
+        float d = glm::dot(point, direction);
+        if (d > bestDot) {
+            bestDot = d;
+            best = point;
+        }
+    }
+    return best;
+}
+
+} // namespace engine::physics
@@ -0,0 +1,89 @@
+#pragma once
+#include "../CollisionShape.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+/**
+ * @brief Rigid assembly of child shapes at fixed local transforms
+ * Presents one broad phase proxy and one set of mass properties for the
+ * whole body. A small BVH over the children's local AABBs lets the narrow
+ * phase visit only the children near the other shape. Children are
+ * treated as centered on their local origin when computing mass
+ * properties, and density is assumed uniform across them.
+ *
+ * Children are given in an authoring frame and stored recentered on the
+ * compound's center of mass, since the body rotates about its position.
+ * getCenterOfMass() is where that center lies in the authoring frame: a
+ * body meant to put the authoring origin at P goes at P + R * offset.
+ */
+class CompoundShape : public CollisionShape {
+public:
+    struct Child {
+        std::shared_ptr<CollisionShape> shape;
+        Transform localTransform;
+    };
+
+    CompoundShape() = default;
+    explicit CompoundShape(std::vector<Child> children);
+
+    // Children; every edit rebuilds the BVH and mass properties and recenters.
+    // addChild takes the authoring frame; getChild returns the recentered transform
+    void addChild(std::shared_ptr<CollisionShape> shape, const Transform& localTransform);
+    void removeChild(size_t index);
+    size_t getChildCount() const { return children.size(); }
+    const Child& getChild(size_t index) const { return children[index]; }
+
+    // CollisionShape interface
+    ShapeType getType() const override { return ShapeType::Compound; }
+    BoundingBox getAABB(const Transform& transform) const override;
+    bool raycast(const Ray& ray, const Transform& transform, RaycastHit& hit) const override;
+    glm::vec3 support(const glm::vec3& direction, const Transform& transform) const override;
+    float calculateVolume() const override { return volume; }
+    glm::mat3 calculateInertiaTensor(float mass) const override { return unitInertia * mass; }
+
+    // Center of mass in the authoring frame, i.e. the offset removed from every child
+    const glm::vec3& getCenterOfMass() const { return centerOfMass; }
+
+    // Calls callback(childIndex) for every child whose local AABB overlaps a local-space box
+    template <typename Callback>
+    void queryOverlap(const BoundingBox& localBox, Callback&& callback) const;
+
+private:
+    // Depth-first nodes; leaves store a child index, internal nodes the negated subtree size
+    struct Node {
+        BoundingBox bounds;
+        int32_t escapeIndexOrChild;
+    };
+
+    std::vector<Child> children;
+    std::vector<BoundingBox> childBounds;   // Local space
+    std::vector<Node> nodes;
+
+    float volume = 0.0f;
+    glm::vec3 centerOfMass{0.0f};
+    glm::mat3 unitInertia{1.0f};      // About the center of mass for unit mass
+
+    void rebuild();
+    void buildNode(std::vector<uint32_t>& order, size_t begin, size_t end);
+    void computeMassProperties();
+};
+
+template <typename Callback>
+void CompoundShape::queryOverlap(const BoundingBox& localBox, Callback&& callback) const {
+    size_t index = 0;
+    while (index < nodes.size()) {
+        const Node& node = nodes[index];
+        const bool overlap = node.bounds.intersects(localBox);
+
+        if (node.escapeIndexOrChild >= 0) {
+            if (overlap) callback(static_cast<uint32_t>(node.escapeIndexOrChild));
+            ++index;
+        } else {
+            index += overlap ? 1 : static_cast<size_t>(-node.escapeIndexOrChild);
+        }
+    }
+}
+
+} // namespace engine::physics
@@ -0,0 +1,495 @@
+#include "ConvexHullShape.hpp"
+#include "../../core/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+
+namespace engine::physics {
+
+namespace {
+
+uint64_t edgeKey(uint32_t a, uint32_t b) {
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+// Quickhull over a point cloud; returns outward-wound triangles indexing into points,
+// or an empty list when the points are degenerate (coplanar, collinear or too few)
+std::vector<uint32_t> quickhull(const std::vector<glm::vec3>& points) {
+    struct HullFace {
+        uint32_t v[3];
+        glm::vec3 normal;
+        float offset;
+        std::vector<uint32_t> outside;
+        bool alive;
+    };
+
+    const uint32_t count = static_cast<uint32_t>(points.size());
+    if (count < 4) return {};
+
+    // Tolerance scaled to the cloud's extent
+    glm::vec3 maxAbs(0.0f);
+    for (const glm::vec3& p : points) maxAbs = glm::max(maxAbs, glm::abs(p));
+    const float epsilon = 3.0f * FLT_EPSILON * (maxAbs.x + maxAbs.y + maxAbs.z) * 16.0f;
+
+    // Initial simplex: widest axis extremes, farthest from their line, farthest from their plane
+    uint32_t extremes[6] = {0, 0, 0, 0, 0, 0};
+    for (uint32_t i = 0; i < count; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            if (points[i][axis] < points[extremes[axis * 2]][axis]) extremes[axis * 2] = i;
+            if (points[i][axis] > points[extremes[axis * 2 + 1]][axis]) extremes[axis * 2 + 1] = i;
+        }
+    }
+    uint32_t i0 = 0, i1 = 0;
+    float widest = -1.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        glm::vec3 d = points[extremes[axis * 2 + 1]] - points[extremes[axis * 2]];
+        if (glm::dot(d, d) > widest) {
+            widest = glm::dot(d, d);
+            i0 = extremes[axis * 2];
+            i1 = extremes[axis * 2 + 1];
+        }
+    }
+    if (widest <= epsilon * epsilon) return {};
+
+    uint32_t i2 = i0;
+    float farthest = 0.0f;
+    glm::vec3 lineDir = glm::normalize(points[i1] - points[i0]);
+    for (uint32_t i = 0; i < count; ++i) {
+        glm::vec3 d = points[i] - points[i0];
+        float distSq = glm::dot(d, d) - glm::dot(d, lineDir) * glm::dot(d, lineDir);
+        if (distSq > farthest) { farthest = distSq; i2 = i; }
+    }
+    if (farthest <= epsilon * epsilon) return {};
+
+    uint32_t i3 = i0;
+    farthest = 0.0f;
+    glm::vec3 planeNormal = glm::normalize(glm::cross(points[i1] - points[i0], points[i2] - points[i0]));
+    for (uint32_t i = 0; i < count; ++i) {
+        float dist = std::abs(glm::dot(points[i] - points[i0], planeNormal));
+        if (dist > farthest) { farthest = dist; i3 = i; }
+    }
+    if (farthest <= epsilon) return {};
+
+    std::vector<HullFace> faces;
+    std::unordered_map<uint64_t, uint32_t> edgeOwner;   // Directed edge -> face
+
+    auto addFace = [&](uint32_t a, uint32_t b, uint32_t c) {
+        HullFace face;
+        face.v[0] = a; face.v[1] = b; face.v[2] = c;
+        face.normal = glm::normalize(glm::cross(points[b] - points[a], points[c] - points[a]));
+        face.offset = glm::dot(face.normal, points[a]);
+        face.alive = true;
+        uint32_t index = static_cast<uint32_t>(faces.size());
+        edgeOwner[edgeKey(a, b)] = index;
+        edgeOwner[edgeKey(b, c)] = index;
+        edgeOwner[edgeKey(c, a)] = index;
+        faces.push_back(std::move(face));
+        return index;
+    };
+
+    // Wind the tetrahedron outward relative to its centroid
+    glm::vec3 interior = (points[i0] + points[i1] + points[i2] + points[i3]) * 0.25f;
+    if (glm::dot(glm::cross(points[i1] - points[i0], points[i2] - points[i0]), interior - points[i0]) > 0.0f) {
+        std::swap(i1, i2);
+    }
+    addFace(i0, i1, i2);
+    addFace(i0, i3, i1);
+    addFace(i1, i3, i2);
+    addFace(i2, i3, i0);
+
+    auto distance = [&](const HullFace& face, uint32_t point) {
+        return glm::dot(face.normal, points[point]) - face.offset;
+    };
+
+    auto assign = [&](uint32_t point, const std::vector<uint32_t>& candidates) {
+        float best = epsilon;
+        uint32_t bestFace = UINT32_MAX;
+        for (uint32_t f : candidates) {
+            float d = distance(faces[f], point);
+            if (d > best) { best = d; bestFace = f; }
+        }
+        if (bestFace != UINT32_MAX) faces[bestFace].outside.push_back(point);
+    };
+
+    std::vector<uint32_t> initial = {0, 1, 2, 3};
+    for (uint32_t i = 0; i < count; ++i) {
+        if (i != i0 && i != i1 && i != i2 && i != i3) assign(i, initial);
+    }
+
+    std::vector<uint32_t> pending = initial;
+    std::vector<uint32_t> visible, horizon, created, orphans;
+    std::vector<uint32_t> visitMark;
+
+    while (!pending.empty()) {
+        uint32_t start = pending.back();
+        pending.pop_back();
+        if (!faces[start].alive || faces[start].outside.empty()) continue;
+
+        // Eye point: farthest outside point of this face
+        const std::vector<uint32_t>& outside = faces[start].outside;
+        uint32_t eye = *std::max_element(outside.begin(), outside.end(),
+            [&](uint32_t a, uint32_t b) { return distance(faces[start], a) < distance(faces[start], b); });
+
+        // Flood the faces the eye can see and record the horizon as directed edges
+        visitMark.assign(faces.size(), 0);
+        visible.assign(1, start);
+        visitMark[start] = 1;
+        horizon.clear();
+        for (size_t i = 0; i < visible.size(); ++i) {
+            const HullFace& face = faces[visible[i]];
+            for (int e = 0; e < 3; ++e) {
+                uint32_t a = face.v[e];
+                uint32_t b = face.v[(e + 1) % 3];
+                uint32_t neighbour = edgeOwner[edgeKey(b, a)];
+                if (visitMark[neighbour] == 1) continue;
+                if (visitMark[neighbour] == 0 && distance(faces[neighbour], eye) > epsilon) {
+                    visitMark[neighbour] = 1;
+                    visible.push_back(neighbour);
+                } else {
+                    visitMark[neighbour] = 2;
+                    horizon.push_back(a);
+                    horizon.push_back(b);
+                }
+            }
+        }
+
+        orphans.clear();
+        for (uint32_t f : visible) {
+            HullFace& face = faces[f];
+            for (uint32_t p : face.outside) {
+                if (p != eye) orphans.push_back(p);
+            }
+            face.outside.clear();
+            face.outside.shrink_to_fit();
+            face.alive = false;
+            for (int e = 0; e < 3; ++e) {
+                edgeOwner.erase(edgeKey(face.v[e], face.v[(e + 1) % 3]));
+            }
+        }
+
+        // Cone from the horizon to the eye
+        created.clear();
+        for (size_t i = 0; i < horizon.size(); i += 2) {
+            created.push_back(addFace(horizon[i], horizon[i + 1], eye));
+        }
+        for (uint32_t p : orphans) {
+            assign(p, created);
+        }
+        pending.insert(pending.end(), created.begin(), created.end());
+    }
+
+    std::vector<uint32_t> triangles;
+    for (const HullFace& face : faces) {
+        if (face.alive) triangles.insert(triangles.end(), face.v, face.v + 3);
+    }
+    return triangles;
+}
+
+} // namespace
+
+ConvexHullShape::ConvexHullShape(const std::vector<glm::vec3>& points) {
+    build(points);
+}
+
+void ConvexHullShape::build(const std::vector<glm::vec3>& points) {
+    std::vector<glm::vec3> source = points;
+    std::vector<uint32_t> triangles = quickhull(source);
+
+    if (triangles.empty()) {
+        // Degenerate input: fall back to its (slightly thickened) bounding box
+        engine::core::log::Logger::log("Degenerate point cloud for ConvexHullShape, using its bounding box",
+                                      engine::core::log::LogLevel::Warning);
+        BoundingBox bounds;
+        for (const glm::vec3& p : points) bounds.expand(p);
+        if (points.empty()) bounds = BoundingBox(glm::vec3(0.0f), glm::vec3(0.0f));
+        glm::vec3 center = bounds.getCenter();
+        glm::vec3 half = glm::max(bounds.getSize() * 0.5f, glm::vec3(0.005f));
+
+        source.clear();
+        for (int i = 0; i < 8; ++i) {
+            source.push_back(center + glm::vec3((i & 1) ? half.x : -half.x,
+                                                (i & 2) ? half.y : -half.y,
+                                                (i & 4) ? half.z : -half.z));
+        }
+        triangles = quickhull(source);
+    }
+
+    // Keep only the hull's vertices
+    std::vector<uint32_t> remap(source.size(), UINT32_MAX);
+    vertices.clear();
+    for (uint32_t& index : triangles) {
+        if (remap[index] == UINT32_MAX) {
+            remap[index] = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(source[index]);
+        }
+        index = remap[index];
+    }
+
+    buildTopology(triangles);
+    computeMassProperties();
+
+    for (int axis = 0; axis < 3; ++axis) {
+        glm::vec3 direction(0.0f);
+        direction[axis] = 1.0f;
+        axisExtremes[axis * 2] = getSupportVertex(direction, 0);
+        axisExtremes[axis * 2 + 1] = getSupportVertex(-direction, axisExtremes[axis * 2]);
+    }
+}
+
+void ConvexHullShape::buildTopology(const std::vector<uint32_t>& triangles) {
+    const uint32_t triangleCount = static_cast<uint32_t>(triangles.size() / 3);
+
+    // Vertex adjacency from the triangulation
+    std::vector<std::vector<uint32_t>> neighbours(vertices.size());
+    std::unordered_map<uint64_t, uint32_t> edgeTriangle;
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        for (int e = 0; e < 3; ++e) {
+            uint32_t a = triangles[t * 3 + e];
+            uint32_t b = triangles[t * 3 + (e + 1) % 3];
+            edgeTriangle[edgeKey(a, b)] = t;
+            neighbours[a].push_back(b);   // Each undirected edge appears once per direction
+        }
+    }
+
+    adjacencyOffsets.assign(1, 0);
+    adjacency.clear();
+    for (const auto& list : neighbours) {
+        adjacency.insert(adjacency.end(), list.begin(), list.end());
+        adjacencyOffsets.push_back(static_cast<uint32_t>(adjacency.size()));
+    }
+
+    // Merge coplanar neighbouring triangles into polygons (union-find)
+    std::vector<glm::vec3> normals(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3& a = vertices[triangles[t * 3]];
+        normals[t] = glm::normalize(glm::cross(vertices[triangles[t * 3 + 1]] - a, vertices[triangles[t * 3 + 2]] - a));
+    }
+
+    std::vector<uint32_t> parent(triangleCount);
+    std::iota(parent.begin(), parent.end(), 0u);
+    auto find = [&parent](uint32_t x) {
+        while (parent[x] != x) x = parent[x] = parent[parent[x]];
+        return x;
+    };
+
+    constexpr float CoplanarCosine = 0.99999f;
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        for (int e = 0; e < 3; ++e) {
+            uint32_t a = triangles[t * 3 + e];
+            uint32_t b = triangles[t * 3 + (e + 1) % 3];
+            uint32_t other = edgeTriangle[edgeKey(b, a)];
+            if (glm::dot(normals[t], normals[other]) > CoplanarCosine) {
+                parent[find(t)] = find(other);
+            }
+        }
+    }
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> groups;
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        groups[find(t)].push_back(t);
+    }
+
+    faces.clear();
+    faceIndices.clear();
+    edges.clear();
+    std::unordered_map<uint32_t, uint32_t> next;
+    for (auto& [root, members] : groups) {
+        // Boundary = directed edges whose twin lies outside the group
+        next.clear();
+        glm::vec3 normal(0.0f);
+        for (uint32_t t : members) {
+            const glm::vec3& a = vertices[triangles[t * 3]];
+            normal += glm::cross(vertices[triangles[t * 3 + 1]] - a, vertices[triangles[t * 3 + 2]] - a);
+            for (int e = 0; e < 3; ++e) {
+                uint32_t from = triangles[t * 3 + e];
+                uint32_t to = triangles[t * 3 + (e + 1) % 3];
+                if (find(edgeTriangle[edgeKey(to, from)]) != root) {
+                    next[from] = to;
+                }
+            }
+        }
+
+        Face face;
+        face.normal = glm::normalize(normal);
+        face.firstIndex = static_cast<uint32_t>(faceIndices.size());
+        face.offset = -FLT_MAX;
+
+        uint32_t first = next.begin()->first;
+        uint32_t current = first;
+        do {
+            uint32_t to = next[current];
+            faceIndices.push_back(current);
+            face.offset = std::max(face.offset, glm::dot(face.normal, vertices[current]));
+            if (current < to) edges.push_back({current, to});   // Shared edges are seen once per side
+            current = to;
+        } while (current != first && faceIndices.size() - face.firstIndex <= next.size());
+
+        face.indexCount = static_cast<uint32_t>(faceIndices.size()) - face.firstIndex;
+        faces.push_back(face);
+    }
+}
+
+void ConvexHullShape::computeMassProperties() {
+    // Sum signed tetrahedra from an interior reference point to each face fan
+    glm::vec3 reference(0.0f);
+    for (const glm::vec3& v : vertices) reference += v;
+    reference /= static_cast<float>(vertices.size());
+
+    float totalVolume = 0.0f;
+    glm::vec3 weightedCenter(0.0f);
+    glm::mat3 covariance(0.0f);     // Second moment about the reference point
+
+    for (const Face& face : faces) {
+        glm::vec3 a = vertices[faceIndices[face.firstIndex]] - reference;
+        for (uint32_t i = 1; i + 1 < face.indexCount; ++i) {
+            glm::vec3 b = vertices[faceIndices[face.firstIndex + i]] - reference;
+            glm::vec3 c = vertices[faceIndices[face.firstIndex + i + 1]] - reference;
+
+            float det = glm::dot(a, glm::cross(b, c));
+            float tetVolume = det / 6.0f;
+            totalVolume += tetVolume;
+            weightedCenter += tetVolume * (a + b + c) * 0.25f;
+
+            // Integral of x x^T over the tetrahedron (0, a, b, c)
+            glm::vec3 sum = a + b + c;
+            glm::mat3 moment = glm::outerProduct(a, a) + glm::outerProduct(b, b) +
+                               glm::outerProduct(c, c) + glm::outerProduct(sum, sum);
+            covariance += moment * (det / 120.0f);
+        }
+    }
+
+    if (totalVolume <= FLT_EPSILON) {
+        volume = 0.0f;
+        centerOfMass = reference;
+        unitInertia = glm::mat3(1.0f);
+        return;
+    }
+
+    glm::vec3 offset = weightedCenter / totalVolume;
+    volume = totalVolume;
+    centerOfMass = reference + offset;
+
+    // Shift the second moment to the center of mass, then I = tr(C) * 1 - C
+    covariance -= totalVolume * glm::outerProduct(offset, offset);
+    float trace = covariance[0][0] + covariance[1][1] + covariance[2][2];
+    unitInertia = (glm::mat3(trace) - covariance) / totalVolume;
+}
+
+uint32_t ConvexHullShape::getSupportVertex(const glm::vec3& localDirection, uint32_t startVertex) const {
+    uint32_t current = startVertex < vertices.size() ? startVertex : 0;
+    float best = glm::dot(vertices[current], localDirection);
+
+    // Steepest ascent over the vertex graph; on a convex hull any local maximum is global
+    for (;;) {
+        uint32_t candidate = current;
+        for (uint32_t i = adjacencyOffsets[current]; i < adjacencyOffsets[current + 1]; ++i) {
+            float d = glm::dot(vertices[adjacency[i]], localDirection);
+            if (d > best) {
+                best = d;
+                candidate = adjacency[i];
+            }
+        }
+        if (candidate == current) return current;
+        current = candidate;
+    }
+}
+
+uint32_t ConvexHullShape::getStartVertex(const glm::vec3& localDirection) const {
+    const int axis = std::abs(localDirection.x) >= std::abs(localDirection.y)
+        ? (std::abs(localDirection.x) >= std::abs(localDirection.z) ? 0 : 2)
+        : (std::abs(localDirection.y) >= std::abs(localDirection.z) ? 1 : 2);
+    return axisExtremes[axis * 2 + (localDirection[axis] < 0.0f ? 1 : 0)];
+}
+
+uint32_t ConvexHullShape::getSupportFace(const glm::vec3& localDirection) const {
+    uint32_t bestFace = 0;
+    float best = -FLT_MAX;
+    for (uint32_t i = 0; i < faces.size(); ++i) {
+        float d = glm::dot(faces[i].normal, localDirection);
+        if (d > best) {
+            best = d;
+            bestFace = i;
+        }
+    }
+    return bestFace;
+}
+
+glm::vec3 ConvexHullShape::support(const glm::vec3& direction, const Transform& transform) const {
+    glm::vec3 localDir = glm::inverse(transform.rotation) * direction;
+    uint32_t vertex = getSupportVertex(localDir, getStartVertex(localDir));
+    return transform.position + transform.rotation * vertices[vertex];
+}
+
+glm::vec3 ConvexHullShape::support(const glm::vec3& direction, const Transform& transform,
+                                   uint32_t& vertexHint) const {
+    glm::vec3 localDir = glm::inverse(transform.rotation) * direction;
+    vertexHint = getSupportVertex(localDir, vertexHint);
+    return transform.position + transform.rotation * vertices[vertexHint];
+}
+
+BoundingBox ConvexHullShape::getAABB(const Transform& transform) const {
+    // World axis i in local space is row i of the rotation, i.e. column i of its inverse
+    glm::mat3 inverseRotation = glm::mat3_cast(glm::inverse(transform.rotation));
+
+    // Six hill climbs, each starting where the previous one ended
+    glm::vec3 minimum, maximum;
+    uint32_t vertex = getStartVertex(inverseRotation[0]);
+    for (int axis = 0; axis < 3; ++axis) {
+        const glm::vec3 localAxis = inverseRotation[axis];
+        vertex = getSupportVertex(localAxis, vertex);
+        maximum[axis] = glm::dot(vertices[vertex], localAxis);
+        vertex = getSupportVertex(-localAxis, vertex);
+        minimum[axis] = glm::dot(vertices[vertex], localAxis);
+    }
+
+    glm::vec3 marginVec(margin);
+    return BoundingBox(transform.position + minimum - marginVec, transform.position + maximum + marginVec);
+}
+
+bool ConvexHullShape::raycast(const Ray& ray, const Transform& transform, RaycastHit& hit) const {
+    glm::quat inverseRotation = glm::inverse(transform.rotation);
+    glm::vec3 origin = inverseRotation * (ray.origin - transform.position);
+    glm::vec3 direction = inverseRotation * ray.direction;
+
+    // Clip the ray against every face plane
+    float tNear = -FLT_MAX;
+    float tFar = FLT_MAX;
+    glm::vec3 nearNormal(0.0f), farNormal(0.0f);
+
+    for (const Face& face : faces) {
+        float denom = glm::dot(face.normal, direction);
+        float dist = face.offset - glm::dot(face.normal, origin);
+
+        if (std::abs(denom) < 1e-8f) {
+            if (dist < 0.0f) return false;   // Parallel and outside
+            continue;
+        }
+
+        float t = dist / denom;
+        if (denom < 0.0f) {
+            if (t > tNear) { tNear = t; nearNormal = face.normal; }
+        } else {
+            if (t < tFar) { tFar = t; farNormal = face.normal; }
+        }
+        if (tNear > tFar) return false;
+    }
+
+    if (tFar < 0.0f) {
+        return false;
+    }
+
+    // Starting inside reports the exit face, matching BoxShape
+    float t = tNear >= 0.0f ? tNear : tFar;
+    if (t > ray.maxDistance) {
+        return false;
+    }
+
+    hit.hit = true;
+    hit.distance = t;
+    hit.point = ray.getPoint(t);
+    hit.normal = transform.rotation * (tNear >= 0.0f ? nearNormal : farNormal);
+    return true;
+}
+
+} // namespace engine::physics
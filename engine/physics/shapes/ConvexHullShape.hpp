@@ -0,0 +1,89 @@
+#pragma once
+#include "../CollisionShape.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+/**
+ * @brief Convex polyhedron collision shape built with quickhull
+ * Stores the vertex adjacency graph so support queries hill-climb instead
+ * of scanning every vertex, merged coplanar faces for clipping-based
+ * manifolds, and mass properties computed once at build time. The shape is
+ * immutable after construction and safe to query from several threads;
+ * callers that query it repeatedly keep their own start vertex and pass it
+ * to the hinted support().
+ * Vertices stay in the caller's frame; mass properties are about the
+ * center of mass, so hulls should be authored around their centroid.
+ */
+class ConvexHullShape : public CollisionShape {
+public:
+    // Planar polygon, vertices wound counter-clockwise around the outward normal
+    struct Face {
+        glm::vec3 normal;
+        float offset;            // dot(normal, x) == offset on the plane
+        uint32_t firstIndex;     // Into getFaceIndices()
+        uint32_t indexCount;
+    };
+
+    struct Edge {
+        uint32_t a, b;
+    };
+
+    explicit ConvexHullShape(const std::vector<glm::vec3>& points);
+
+    // CollisionShape interface
+    ShapeType getType() const override { return ShapeType::ConvexMesh; }
+    BoundingBox getAABB(const Transform& transform) const override;
+    bool raycast(const Ray& ray, const Transform& transform, RaycastHit& hit) const override;
+    glm::vec3 support(const glm::vec3& direction, const Transform& transform) const override;
+    float calculateVolume() const override { return volume; }
+    glm::mat3 calculateInertiaTensor(float mass) const override { return unitInertia * mass; }
+
+    // Support starting from vertexHint, which is updated to the result for the next query
+    glm::vec3 support(const glm::vec3& direction, const Transform& transform, uint32_t& vertexHint) const;
+
+    // Hill-climbing support in local space, starting from startVertex
+    uint32_t getSupportVertex(const glm::vec3& localDirection, uint32_t startVertex) const;
+
+    // Start vertex for a climb without a hint: the nearest of the six axis extremes
+    uint32_t getStartVertex(const glm::vec3& localDirection) const;
+
+    // Face whose normal is most aligned with a local direction
+    uint32_t getSupportFace(const glm::vec3& localDirection) const;
+
+    // Hull data (local space)
+    size_t getVertexCount() const { return vertices.size(); }
+    const glm::vec3& getVertex(uint32_t index) const { return vertices[index]; }
+    const std::vector<glm::vec3>& getVertices() const { return vertices; }
+    size_t getFaceCount() const { return faces.size(); }
+    const Face& getFace(uint32_t index) const { return faces[index]; }
+    const std::vector<uint32_t>& getFaceIndices() const { return faceIndices; }
+    const std::vector<Edge>& getEdges() const { return edges; }
+    const glm::vec3& getCenterOfMass() const { return centerOfMass; }
+
+private:
+    std::vector<glm::vec3> vertices;
+
+    // Vertex adjacency in compressed rows: neighbours of v are
+    // adjacency[adjacencyOffsets[v] .. adjacencyOffsets[v + 1])
+    std::vector<uint32_t> adjacencyOffsets;
+    std::vector<uint32_t> adjacency;
+
+    std::vector<Face> faces;
+    std::vector<uint32_t> faceIndices;
+    std::vector<Edge> edges;
+
+    float volume = 0.0f;
+    glm::vec3 centerOfMass{0.0f};
+    glm::mat3 unitInertia{1.0f};      // Inertia about the center of mass for unit mass
+
+    // Support vertices along +X, -X, +Y, -Y, +Z, -Z
+    uint32_t axisExtremes[6] = {};
+
+    void build(const std::vector<glm::vec3>& points);
+    void buildTopology(const std::vector<uint32_t>& triangles);
+    void computeMassProperties();
+};
+
+} // namespace engine::physics
@@ -0,0 +1,408 @@
+#include "HeightfieldShape.hpp"
+#include "../collision/GeometryUtils.hpp"
+#include "ConvexHullShape.hpp"
+#include "../../core/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace engine::physics {
+
+namespace {
+
+constexpr float QuantizedRange = 65535.0f;
+constexpr uint32_t TileShift = 4;
+constexpr uint32_t TileSize = 1u << TileShift;
+constexpr uint32_t TileMask = TileSize - 1;
+constexpr uint32_t TileSamples = TileSize * TileSize;
+
+constexpr uint8_t MaxTileBits = 8;
+constexpr uint32_t MaxTileValue = (1u << MaxTileBits) - 1;
+
+// Narrowest width that divides 32, so no offset straddles two words
+uint8_t bitsFor(uint32_t range) {
+    uint8_t bits = 0;
+    while (bits < MaxTileBits && (range >> bits) != 0) {
+        bits = bits ? static_cast<uint8_t>(bits * 2) : 1;
+    }
+    return bits;
+}
+
+Transform inverseRigid(const Transform& transform) {
+    Transform inverse;
+    inverse.rotation = glm::inverse(transform.rotation);
+    inverse.position = inverse.rotation * -transform.position;
+    return inverse;
+}
+
+glm::vec3 toLocal(const Transform& inverse, const glm::vec3& point) {
+    return inverse.position + inverse.rotation * point;
+}
+
+} // namespace
+
+HeightfieldShape::HeightfieldShape(uint32_t columns, uint32_t rows, const std::vector<float>& heights,
+                                   float cellSize)
+    : columns(columns), rows(rows), cellSize(cellSize) {
+    if (cellSize <= 0.0f) {
+        engine::core::log::Logger::log("Invalid cell size for HeightfieldShape, using 1.0f",
+                                      engine::core::log::LogLevel::Warning);
+        this->cellSize = 1.0f;
+    }
+    if (columns < 2 || rows < 2 || heights.size() != static_cast<size_t>(columns) * rows) {
+        engine::core::log::Logger::log("Heightfield sample count does not match its dimensions, using a flat 2x2 grid",
+                                      engine::core::log::LogLevel::Error);
+        this->columns = 2;
+        this->rows = 2;
+    }
+
+    invCellSize = 1.0f / this->cellSize;
+    origin = -0.5f * this->cellSize * glm::vec2(this->columns - 1, this->rows - 1);
+
+    const size_t sampleCount = static_cast<size_t>(this->columns) * this->rows;
+    const bool useInput = heights.size() == sampleCount;
+
+    if (useInput) {
+        auto [lo, hi] = std::minmax_element(heights.begin(), heights.end());
+        minHeight = *lo;
+        maxHeight = *hi;
+    }
+    heightStep = (maxHeight - minHeight) / QuantizedRange;
+    const float invStep = heightStep > 0.0f ? 1.0f / heightStep : 0.0f;
+
+    tileColumns = (this->columns + TileMask) >> TileShift;
+    const uint32_t tileRows = (this->rows + TileMask) >> TileShift;
+    tiles.resize(static_cast<size_t>(tileColumns) * tileRows);
+
+    // Samples past the last column or row are padding and pack as the tile base
+    uint16_t quantized[TileSamples];
+    for (uint32_t tileRow = 0; tileRow < tileRows; ++tileRow) {
+        for (uint32_t tileColumn = 0; tileColumn < tileColumns; ++tileColumn) {
+            uint16_t low = 0xFFFF, high = 0;
+            for (uint32_t i = 0; i < TileSamples; ++i) {
+                const uint32_t column = (tileColumn << TileShift) + (i & TileMask);
+                const uint32_t row = (tileRow << TileShift) + (i >> TileShift);
+                const size_t index = static_cast<size_t>(row) * this->columns + column;
+                const bool inside = column < this->columns && row < this->rows;
+                quantized[i] = inside && useInput
+                    ? static_cast<uint16_t>(std::lround((heights[index] - minHeight) * invStep)) : 0;
+                if (inside) {
+                    low = std::min(low, quantized[i]);
+                    high = std::max(high, quantized[i]);
+                }
+            }
+
+            // Ranges over 8 bits are rescaled so the tile maximum is 255
+            const uint32_t range = static_cast<uint32_t>(high - low);
+            const float scale = range > MaxTileValue ? static_cast<float>(MaxTileValue) / range : 1.0f;
+            Tile& tile = tiles[static_cast<size_t>(tileRow) * tileColumns + tileColumn];
+            tile.offset = static_cast<uint32_t>(words.size());
+            tile.base = minHeight + low * heightStep;
+            tile.step = heightStep / scale;
+            tile.bits = bitsFor(range);
+            if (tile.bits == 0) continue;
+
+            words.resize(words.size() + TileSamples * tile.bits / 32, 0);
+            for (uint32_t i = 0; i < TileSamples; ++i) {
+                const uint32_t offset = quantized[i] < low ? 0u : static_cast<uint32_t>(quantized[i] - low);
+                const uint32_t value = static_cast<uint32_t>(std::lround(offset * scale));
+                const uint32_t bit = i * tile.bits;
+                words[tile.offset + (bit >> 5)] |= value << (bit & 31);
+            }
+        }
+    }
+    words.shrink_to_fit();
+}
+
+float HeightfieldShape::getHeight(uint32_t column, uint32_t row) const {
+    const Tile& tile = tiles[static_cast<size_t>(row >> TileShift) * tileColumns + (column >> TileShift)];
+    if (tile.bits == 0) return tile.base;
+    const uint32_t bit = (((row & TileMask) << TileShift) + (column & TileMask)) * tile.bits;
+    const uint32_t value = (words[tile.offset + (bit >> 5)] >> (bit & 31)) & ((1u << tile.bits) - 1);
+    return tile.base + value * tile.step;
+}
+
+float HeightfieldShape::getHeightAt(float x, float z) const {
+    float gx = glm::clamp((x - origin.x) * invCellSize, 0.0f, static_cast<float>(columns - 1));
+    float gz = glm::clamp((z - origin.y) * invCellSize, 0.0f, static_cast<float>(rows - 1));
+    uint32_t column = std::min(static_cast<uint32_t>(gx), columns - 2);
+    uint32_t row = std::min(static_cast<uint32_t>(gz), rows - 2);
+    float fx = gx - column;
+    float fz = gz - row;
+
+    // Same diagonal split as getCellTriangles
+    if (fx + fz <= 1.0f) {
+        float h00 = getHeight(column, row);
+        return h00 + fx * (getHeight(column + 1, row) - h00) + fz * (getHeight(column, row + 1) - h00);
+    }
+    float h11 = getHeight(column + 1, row + 1);
+    return h11 + (1.0f - fx) * (getHeight(column, row + 1) - h11) + (1.0f - fz) * (getHeight(column + 1, row) - h11);
+}
+
+glm::vec3 HeightfieldShape::getVertex(uint32_t column, uint32_t row) const {
+    return glm::vec3(origin.x + column * cellSize, getHeight(column, row), origin.y + row * cellSize);
+}
+
+void HeightfieldShape::getCellTriangles(uint32_t column, uint32_t row, glm::vec3 tri[2][3]) const {
+    glm::vec3 v00 = getVertex(column, row);
+    glm::vec3 v10 = getVertex(column + 1, row);
+    glm::vec3 v01 = getVertex(column, row + 1);
+    glm::vec3 v11 = getVertex(column + 1, row + 1);
+
+    // Wound so face normals point up (+Y)
+    tri[0][0] = v00; tri[0][1] = v01; tri[0][2] = v10;
+    tri[1][0] = v10; tri[1][1] = v01; tri[1][2] = v11;
+}
+
+uint32_t HeightfieldShape::getTriangleId(uint32_t column, uint32_t row, int half) const {
+    return (row * (columns - 1) + column) * 2 + static_cast<uint32_t>(half);
+}
+
+BoundingBox HeightfieldShape::getLocalBounds() const {
+    return BoundingBox(glm::vec3(origin.x, minHeight, origin.y),
+                       glm::vec3(-origin.x, maxHeight, -origin.y));
+}
+
+template <typename Callback>
+void HeightfieldShape::forEachCell(const BoundingBox& localBox, Callback&& callback) const {
+    if (localBox.min.y > maxHeight || localBox.max.y < minHeight) {
+        return;
+    }
+
+    float x0 = std::floor((localBox.min.x - origin.x) * invCellSize);
+    float x1 = std::floor((localBox.max.x - origin.x) * invCellSize);
+    float z0 = std::floor((localBox.min.z - origin.y) * invCellSize);
+    float z1 = std::floor((localBox.max.z - origin.y) * invCellSize);
+
+    const float lastColumn = static_cast<float>(columns - 2);
+    const float lastRow = static_cast<float>(rows - 2);
+    if (x1 < 0.0f || z1 < 0.0f || x0 > lastColumn || z0 > lastRow) {
+        return;
+    }
+
+    uint32_t columnBegin = static_cast<uint32_t>(std::max(x0, 0.0f));
+    uint32_t columnEnd = static_cast<uint32_t>(std::min(x1, lastColumn));
+    uint32_t rowBegin = static_cast<uint32_t>(std::max(z0, 0.0f));
+    uint32_t rowEnd = static_cast<uint32_t>(std::min(z1, lastRow));
+
+    for (uint32_t row = rowBegin; row <= rowEnd; ++row) {
+        for (uint32_t column = columnBegin; column <= columnEnd; ++column) {
+            callback(column, row);
+        }
+    }
+}
+
+BoundingBox HeightfieldShape::getAABB(const Transform& transform) const {
+    BoundingBox local = getLocalBounds();
+    glm::vec3 center = local.getCenter();
+    glm::vec3 extent = local.getSize() * 0.5f;
+
+    glm::mat3 rotation = glm::mat3_cast(transform.rotation);
+    glm::vec3 worldExtent(0.0f);
+    for (int i = 0; i < 3; ++i) {
+        worldExtent += glm::abs(rotation[i]) * extent[i];
+    }
+    glm::vec3 worldCenter = transform.position + transform.rotation * center;
+    glm::vec3 marginVec(margin);
+
+    return BoundingBox(worldCenter - worldExtent - marginVec, worldCenter + worldExtent + marginVec);
+}
+
+bool HeightfieldShape::raycast(const Ray& ray, const Transform& transform, RaycastHit& hit) const {
+    Transform inverse = inverseRigid(transform);
+    glm::vec3 o = toLocal(inverse, ray.origin);
+    glm::vec3 d = inverse.rotation * ray.direction;
+
+    BoundingBox bounds = getLocalBounds();
+    float t;
+    if (!geometry::rayAabb(o, 1.0f / d, bounds.min, bounds.max, ray.maxDistance, t)) {
+        return false;
+    }
+
+    // 2D DDA over the X/Z grid starting where the ray enters the bounds
+    glm::vec3 start = o + d * t;
+    int column = glm::clamp(static_cast<int>(std::floor((start.x - origin.x) * invCellSize)), 0, static_cast<int>(columns) - 2);
+    int row = glm::clamp(static_cast<int>(std::floor((start.z - origin.y) * invCellSize)), 0, static_cast<int>(rows) - 2);
+
+    const int stepX = d.x > 0.0f ? 1 : -1;
+    const int stepZ = d.z > 0.0f ? 1 : -1;
+    const float tDeltaX = d.x != 0.0f ? cellSize / std::abs(d.x) : FLT_MAX;
+    const float tDeltaZ = d.z != 0.0f ? cellSize / std::abs(d.z) : FLT_MAX;
+
+    auto boundaryT = [&](float originCoord, float gridOrigin, float dir, int cell) {
+        if (dir == 0.0f) return FLT_MAX;
+        float boundary = gridOrigin + (dir > 0.0f ? cell + 1 : cell) * cellSize;
+        return (boundary - originCoord) / dir;
+    };
+    float tMaxX = boundaryT(o.x, origin.x, d.x, column);
+    float tMaxZ = boundaryT(o.z, origin.y, d.z, row);
+
+    while (t <= ray.maxDistance) {
+        const float tExit = std::min(std::min(tMaxX, tMaxZ), ray.maxDistance);
+
+        // Skip cells whose height range the ray segment cannot reach
+        uint32_t c = static_cast<uint32_t>(column);
+        uint32_t r = static_cast<uint32_t>(row);
+        float h00 = getHeight(c, r), h10 = getHeight(c + 1, r);
+        float h01 = getHeight(c, r + 1), h11 = getHeight(c + 1, r + 1);
+        float cellMin = std::min(std::min(h00, h10), std::min(h01, h11));
+        float cellMax = std::max(std::max(h00, h10), std::max(h01, h11));
+        float yEnter = o.y + d.y * t;
+        float yExit = o.y + d.y * tExit;
+
+        if (std::min(yEnter, yExit) <= cellMax && std::max(yEnter, yExit) >= cellMin) {
+            glm::vec3 tri[2][3];
+            getCellTriangles(c, r, tri);
+
+            float best = ray.maxDistance;
+            int bestHalf = -1;
+            for (int half = 0; half < 2; ++half) {
+                float tHit;
+                if (geometry::rayTriangle(o, d, tri[half][0], tri[half][1], tri[half][2], best, tHit)) {
+                    best = tHit;
+                    bestHalf = half;
+                }
+            }
+
+            // Cells are visited front to back, so the first hit is the closest
+            if (bestHalf >= 0) {
+                const glm::vec3* v = tri[bestHalf];
+                glm::vec3 normal = glm::normalize(glm::cross(v[1] - v[0], v[2] - v[0]));
+                if (glm::dot(normal, d) > 0.0f) {
+                    normal = -normal;
+                }
+
+                hit.hit = true;
+                hit.distance = best;
+                hit.point = ray.getPoint(best);
+                hit.normal = transform.rotation * normal;
+                return true;
+            }
+        }
+
+        if (tMaxX < tMaxZ) {
+            column += stepX;
+            t = tMaxX;
+            tMaxX += tDeltaX;
+        } else {
+            row += stepZ;
+            t = tMaxZ;
+            tMaxZ += tDeltaZ;
+        }
+
+        if (column < 0 || row < 0 || column > static_cast<int>(columns) - 2 || row > static_cast<int>(rows) - 2) {
+            break;
+        }
+    }
+
+    return false;
+}
+
+glm::vec3 HeightfieldShape::support(const glm::vec3& direction, const Transform& transform) const {
+    // Conservative: support of the local bounds, scanning every sample is not worth it
+    glm::vec3 localDir = glm::inverse(transform.rotation) * direction;
+    BoundingBox bounds = getLocalBounds();
+    glm::vec3 corner(localDir.x >= 0.0f ? bounds.max.x : bounds.min.x,
+                     localDir.y >= 0.0f ? bounds.max.y : bounds.min.y,
+                     localDir.z >= 0.0f ? bounds.max.z : bounds.min.z);
+    return transform.position + transform.rotation * corner;
+}
+
+size_t HeightfieldShape::collideSphere(const glm::vec3& center, float radius, const Transform& transform,
+                                       MeshContact* contacts, size_t maxContacts) const {
+    Transform inverse = inverseRigid(transform);
+    glm::vec3 localCenter = toLocal(inverse, center);
+    BoundingBox query(localCenter - glm::vec3(radius), localCenter + glm::vec3(radius));
+
+    size_t count = 0;
+    forEachCell(query, [&](uint32_t column, uint32_t row) {
+        glm::vec3 tri[2][3];
+        getCellTriangles(column, row, tri);
+        for (int half = 0; half < 2; ++half) {
+            MeshContact local[geometry::MaxSphereTriangleContacts];
+            size_t n = geometry::collideSphereTriangle(localCenter, radius, tri[half][0], tri[half][1], tri[half][2], local);
+            geometry::appendMeshContacts(local, n, getTriangleId(column, row, half), transform,
+                                         contacts, count, maxContacts);
+        }
+    });
+
+    return count;
+}
+
+size_t HeightfieldShape::collideCapsule(const glm::vec3& pointA, const glm::vec3& pointB, float radius,
+                                        const Transform& transform, MeshContact* contacts,
+                                        size_t maxContacts) const {
+    Transform inverse = inverseRigid(transform);
+    glm::vec3 p = toLocal(inverse, pointA);
+    glm::vec3 q = toLocal(inverse, pointB);
+    BoundingBox query(glm::min(p, q) - glm::vec3(radius), glm::max(p, q) + glm::vec3(radius));
+
+    size_t count = 0;
+    forEachCell(query, [&](uint32_t column, uint32_t row) {
+        glm::vec3 tri[2][3];
+        getCellTriangles(column, row, tri);
+        for (int half = 0; half < 2; ++half) {
+            MeshContact local[geometry::MaxCapsuleTriangleContacts];
+            size_t n = geometry::collideCapsuleTriangle(p, q, radius, tri[half][0], tri[half][1], tri[half][2], local);
+            geometry::appendMeshContacts(local, n, getTriangleId(column, row, half), transform,
+                                         contacts, count, maxContacts);
+        }
+    });
+
+    return count;
+}
+
+size_t HeightfieldShape::collideBox(const glm::vec3& halfExtents, const Transform& boxTransform,
+                                    const Transform& transform, MeshContact* contacts,
+                                    size_t maxContacts) const {
+    Transform inverse = inverseRigid(transform);
+    glm::vec3 center = toLocal(inverse, boxTransform.position);
+    glm::mat3 boxRotation = glm::mat3_cast(inverse.rotation * boxTransform.rotation);
+    const glm::vec3 axes[3] = { boxRotation[0], boxRotation[1], boxRotation[2] };
+
+    glm::vec3 localExtent(0.0f);
+    for (int i = 0; i < 3; ++i) {
+        localExtent += glm::abs(axes[i]) * halfExtents[i];
+    }
+    BoundingBox query(center - localExtent, center + localExtent);
+
+    size_t count = 0;
+    forEachCell(query, [&](uint32_t column, uint32_t row) {
+        glm::vec3 tri[2][3];
+        getCellTriangles(column, row, tri);
+        for (int half = 0; half < 2; ++half) {
+            MeshContact local[geometry::MaxBoxTriangleContacts];
+            size_t n = geometry::collideBoxTriangle(center, axes, halfExtents, tri[half][0], tri[half][1], tri[half][2], local);
+            geometry::appendMeshContacts(local, n, getTriangleId(column, row, half), transform,
+                                         contacts, count, maxContacts);
+        }
+    });
+
+    return count;
+}
+
+size_t HeightfieldShape::collideHull(const ConvexHullShape& hull, const Transform& hullTransform,
+                                    const Transform& transform, uint32_t supportHints[2], MeshContact* contacts,
+                                    size_t maxContacts) const {
+    Transform inverse = inverseRigid(transform);
+    Transform localTransform;
+    localTransform.rotation = inverse.rotation * hullTransform.rotation;
+    localTransform.position = toLocal(inverse, hullTransform.position);
+    BoundingBox query = hull.getAABB(localTransform);
+
+    size_t count = 0;
+    forEachCell(query, [&](uint32_t column, uint32_t row) {
+        glm::vec3 tri[2][3];
+        getCellTriangles(column, row, tri);
+        for (int half = 0; half < 2; ++half) {
+            MeshContact local[geometry::MaxHullTriangleContacts];
+            size_t n = geometry::collideHullTriangle(hull, localTransform.rotation, localTransform.position,
+                                                     tri[half][0], tri[half][1], tri[half][2], supportHints, local);
+            geometry::appendMeshContacts(local, n, getTriangleId(column, row, half), transform,
+                                         contacts, count, maxContacts);
+        }
+    });
+
+    return count;
+}
+
+} // namespace engine::physics
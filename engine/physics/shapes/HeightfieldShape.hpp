@@ -0,0 +1,90 @@
+#pragma once
+#include "../CollisionShape.hpp"
+#include "../collision/TriangleCollision.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+class ConvexHullShape;
+
+/**
+ * @brief Static terrain collision shape over a regular grid of heights
+ * Heights are quantized to 16 bits between the sample minimum and maximum,
+ * then stored in 16x16 tiles as offsets from the tile minimum of at most 8
+ * bits. A tile whose range needs more is stored at a coarser step, so its
+ * precision is its own height range / 255; flatter tiles pack at 0, 1, 2 or
+ * 4 bits and stay exact. A 4k x 4k field costs at most about 17MB.
+ * The grid is centered on the body in X/Z; each cell is split into two
+ * triangles along its diagonal, generated on demand for the cells under a
+ * query so no triangle data is ever stored.
+ */
+class HeightfieldShape : public CollisionShape {
+public:
+    // Samples are row-major: heights[row * columns + column], rows along Z
+    HeightfieldShape(uint32_t columns, uint32_t rows, const std::vector<float>& heights, float cellSize);
+
+    // CollisionShape interface
+    ShapeType getType() const override { return ShapeType::Heightfield; }
+    BoundingBox getAABB(const Transform& transform) const override;
+    bool raycast(const Ray& ray, const Transform& transform, RaycastHit& hit) const override;
+    glm::vec3 support(const glm::vec3& direction, const Transform& transform) const override;
+    float calculateVolume() const override { return 0.0f; }
+    glm::mat3 calculateInertiaTensor(float /*mass*/) const override { return glm::mat3(0.0f); }
+
+    // Contact generation (world space in, world space out); returns contacts written
+    size_t collideSphere(const glm::vec3& center, float radius, const Transform& transform,
+                         MeshContact* contacts, size_t maxContacts) const;
+    size_t collideCapsule(const glm::vec3& pointA, const glm::vec3& pointB, float radius,
+                          const Transform& transform, MeshContact* contacts, size_t maxContacts) const;
+    size_t collideBox(const glm::vec3& halfExtents, const Transform& boxTransform,
+                      const Transform& transform, MeshContact* contacts, size_t maxContacts) const;
+    // supportHints: start vertices for the hull's support searches, updated
+    size_t collideHull(const ConvexHullShape& hull, const Transform& hullTransform, const Transform& transform,
+                       uint32_t supportHints[2], MeshContact* contacts, size_t maxContacts) const;
+
+    // Terrain queries (local space)
+    float getHeight(uint32_t column, uint32_t row) const;
+    float getHeightAt(float x, float z) const;
+
+    // Properties
+    uint32_t getColumns() const { return columns; }
+    uint32_t getRows() const { return rows; }
+    float getCellSize() const { return cellSize; }
+    float getMinHeight() const { return minHeight; }
+    float getMaxHeight() const { return maxHeight; }
+    size_t getMemoryUsage() const { return tiles.capacity() * sizeof(Tile) + words.capacity() * sizeof(uint32_t); }
+
+private:
+    uint32_t columns;
+    uint32_t rows;
+    float cellSize;
+    float invCellSize;
+    glm::vec2 origin;            // Local X/Z of sample (0, 0)
+
+    float minHeight = 0.0f;
+    float maxHeight = 0.0f;
+    float heightStep = 0.0f;     // World units per quantized step
+
+    struct Tile {
+        uint32_t offset;         // First word of the packed offsets
+        float base;              // Lowest height in the tile
+        float step;              // World units per packed offset step
+        uint8_t bits;            // Bits per sample: 0, 1, 2, 4 or 8
+    };
+    uint32_t tileColumns = 0;
+    std::vector<Tile> tiles;
+    std::vector<uint32_t> words;
+
+
+    BoundingBox getLocalBounds() const;
+    glm::vec3 getVertex(uint32_t column, uint32_t row) const;
+    void getCellTriangles(uint32_t column, uint32_t row, glm::vec3 tri[2][3]) const;
+    uint32_t getTriangleId(uint32_t column, uint32_t row, int half) const;
+
+    // Calls callback(column, row) for every cell under a local-space box
+    template <typename Callback>
+    void forEachCell(const BoundingBox& localBox, Callback&& callback) const;
+};
+
+} // namespace engine::physics
@@ -0,0 +1,350 @@
+#include "TriangleMeshShape.hpp"
+#include "../collision/GeometryUtils.hpp"
+#include "ConvexHullShape.hpp"
+#include "../../core/Logger.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace engine::physics {
+
+namespace {
+
+// On-disk layout: header followed by 16-byte aligned vertex, index and node arrays
+struct TriangleMeshFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+    uint32_t nodeCount;
+    uint32_t reserved;
+    float boundsMin[3];
+    float boundsMax[3];
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    uint64_t nodeOffset;
+};
+
+constexpr char MeshFileMagic[4] = {'L', 'T', 'M', 'H'};
+constexpr uint32_t MeshFileVersion = 1;
+
+uint64_t alignTo16(uint64_t offset) {
+    return (offset + 15) & ~uint64_t(15);
+}
+
+Transform inverseRigid(const Transform& transform) {
+    Transform inverse;
+    inverse.rotation = glm::inverse(transform.rotation);
+    inverse.position = inverse.rotation * -transform.position;
+    return inverse;
+}
+
+glm::vec3 toLocal(const Transform& inverse, const glm::vec3& point) {
+    return inverse.position + inverse.rotation * point;
+}
+
+glm::vec3 toWorld(const Transform& transform, const glm::vec3& point) {
+    return transform.position + transform.rotation * point;
+}
+
+// Every index a query will follow, checked once so a corrupt or truncated
+// file fails to load instead of reading out of bounds; null when valid
+const char* findBadIndex(const uint32_t* indices, uint32_t vertexCount, uint32_t triangleCount,
+                         const QuantizedBvhNode* nodes, uint32_t nodeCount) {
+    for (uint64_t i = 0; i < uint64_t(triangleCount) * 3; ++i) {
+        if (indices[i] >= vertexCount) return "vertex index out of range";
+    }
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        const QuantizedBvhNode& node = nodes[i];
+        if (node.isLeaf()) {
+            if (node.getTriangleIndex() >= triangleCount) return "BVH leaf triangle out of range";
+        } else if (node.escapeIndexOrTriangleIndex == INT32_MIN ||
+                   uint64_t(i) + node.getEscapeIndex() > nodeCount) {
+            // Escape of at least 1 (any negative value) keeps traversal moving forward
+            return "BVH subtree size out of range";
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TriangleMeshShape::TriangleMeshShape(std::vector<glm::vec3> meshVertices, std::vector<uint32_t> meshIndices)
+    : ownedVertices(std::move(meshVertices)), ownedIndices(std::move(meshIndices)) {
+    ownedIndices.resize(ownedIndices.size() - ownedIndices.size() % 3);
+
+    vertices = ownedVertices.data();
+    indices = ownedIndices.data();
+    vertexCount = ownedVertices.size();
+    triangleCount = ownedIndices.size() / 3;
+
+    bvh.build(vertices, indices, triangleCount);
+}
+
+bool TriangleMeshShape::saveToFile(const std::string& path) const {
+    TriangleMeshFileHeader header{};
+    std::memcpy(header.magic, MeshFileMagic, sizeof(header.magic));
+    header.version = MeshFileVersion;
+    header.vertexCount = static_cast<uint32_t>(vertexCount);
+    header.triangleCount = static_cast<uint32_t>(triangleCount);
+    header.nodeCount = static_cast<uint32_t>(bvh.getNodeCount());
+    for (int i = 0; i < 3; ++i) {
+        header.boundsMin[i] = bvh.getBoundsMin()[i];
+        header.boundsMax[i] = bvh.getBoundsMax()[i];
+    }
+    header.vertexOffset = alignTo16(sizeof(TriangleMeshFileHeader));
+    header.indexOffset = alignTo16(header.vertexOffset + vertexCount * sizeof(glm::vec3));
+    header.nodeOffset = alignTo16(header.indexOffset + triangleCount * 3 * sizeof(uint32_t));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        engine::core::log::Logger::log("Failed to write triangle mesh: " + path,
+                                      engine::core::log::LogLevel::Error);
+        return false;
+    }
+
+    auto writeAt = [&file](uint64_t offset, const void* data, size_t bytes) {
+        static const char padding[16] = {};
+        uint64_t position = static_cast<uint64_t>(file.tellp());
+        file.write(padding, static_cast<std::streamsize>(offset - position));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeAt(header.vertexOffset, vertices, vertexCount * sizeof(glm::vec3));
+    writeAt(header.indexOffset, indices, triangleCount * 3 * sizeof(uint32_t));
+    writeAt(header.nodeOffset, bvh.getNodes(), bvh.getNodeCount() * sizeof(QuantizedBvhNode));
+
+    return static_cast<bool>(file);
+}
+
+std::shared_ptr<TriangleMeshShape> TriangleMeshShape::loadFromFile(const std::string& path) {
+    auto file = std::make_unique<engine::core::io::MappedFile>();
+    if (!file->open(path)) {
+        return nullptr;
+    }
+
+    if (file->size() < sizeof(TriangleMeshFileHeader)) {
+        engine::core::log::Logger::log("Triangle mesh file too small: " + path,
+                                      engine::core::log::LogLevel::Error);
+        return nullptr;
+    }
+
+    TriangleMeshFileHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+
+    bool valid = std::memcmp(header.magic, MeshFileMagic, sizeof(header.magic)) == 0 &&
+                 header.version == MeshFileVersion &&
+                 header.vertexOffset % 16 == 0 && header.indexOffset % 16 == 0 && header.nodeOffset % 16 == 0 &&
+                 header.vertexOffset + uint64_t(header.vertexCount) * sizeof(glm::vec3) <= file->size() &&
+                 header.indexOffset + uint64_t(header.triangleCount) * 3 * sizeof(uint32_t) <= file->size() &&
+                 header.nodeOffset + uint64_t(header.nodeCount) * sizeof(QuantizedBvhNode) <= file->size();
+    if (!valid) {
+        engine::core::log::Logger::log("Invalid or incompatible triangle mesh file: " + path,
+                                      engine::core::log::LogLevel::Error);
+        return nullptr;
+    }
+
+    const uint8_t* base = file->data();
+    if (const char* problem = findBadIndex(reinterpret_cast<const uint32_t*>(base + header.indexOffset),
+                                           header.vertexCount, header.triangleCount,
+                                           reinterpret_cast<const QuantizedBvhNode*>(base + header.nodeOffset),
+                                           header.nodeCount)) {
+        engine::core::log::Logger::log("Corrupt triangle mesh file " + path + ": " + problem,
+                                      engine::core::log::LogLevel::Error);
+        return nullptr;
+    }
+
+    std::shared_ptr<TriangleMeshShape> shape(new TriangleMeshShape());
+    shape->vertices = reinterpret_cast<const glm::vec3*>(base + header.vertexOffset);
+    shape->indices = reinterpret_cast<const uint32_t*>(base + header.indexOffset);
+    shape->vertexCount = header.vertexCount;
+    shape->triangleCount = header.triangleCount;
+    shape->bvh.attach(reinterpret_cast<const QuantizedBvhNode*>(base + header.nodeOffset), header.nodeCount,
+                      glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]),
+                      glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]));
+    shape->mappedFile = std::move(file);
+    return shape;
+}
+
+BoundingBox TriangleMeshShape::getAABB(const Transform& transform) const {
+    BoundingBox local = bvh.getBounds();
+    glm::vec3 center = local.getCenter();
+    glm::vec3 extent = local.getSize() * 0.5f;
+
+    // Rotated box extent: |R| * e
+    glm::mat3 rotation = glm::mat3_cast(transform.rotation);
+    glm::vec3 worldExtent(0.0f);
+    for (int i = 0; i < 3; ++i) {
+        worldExtent += glm::abs(rotation[i]) * extent[i];
+    }
+    glm::vec3 worldCenter = toWorld(transform, center);
+    glm::vec3 marginVec(margin);
+
+    return BoundingBox(worldCenter - worldExtent - marginVec, worldCenter + worldExtent + marginVec);
+}
+
+bool TriangleMeshShape::raycast(const Ray& ray, const Transform& transform, RaycastHit& hit) const {
+    Transform inverse = inverseRigid(transform);
+    glm::vec3 origin = toLocal(inverse, ray.origin);
+    glm::vec3 direction = inverse.rotation * ray.direction;
+
+    float closest = ray.maxDistance;
+    int64_t hitTriangle = -1;
+
+    bvh.queryRay(origin, direction, closest, [&](uint32_t triangle, float maxT) {
+        glm::vec3 a, b, c;
+        getTriangle(triangle, a, b, c);
+        float t;
+        if (geometry::rayTriangle(origin, direction, a, b, c, maxT, t)) {
+            closest = t;
+            hitTriangle = triangle;
+            return t;
+        }
+        return maxT;
+    });
+
+    if (hitTriangle < 0) {
+        return false;
+    }
+
+    glm::vec3 a, b, c;
+    getTriangle(static_cast<uint32_t>(hitTriangle), a, b, c);
+    glm::vec3 normal = glm::normalize(glm::cross(b - a, c - a));
+    if (glm::dot(normal, direction) > 0.0f) {
+        normal = -normal;  // Report the face the ray hit
+    }
+
+    hit.hit = true;
+    hit.distance = closest;
+    hit.point = ray.getPoint(closest);
+    hit.normal = transform.rotation * normal;
+    return true;
+}
+
+glm::vec3 TriangleMeshShape::support(const glm::vec3& direction, const Transform& transform) const {
+    glm::vec3 localDir = glm::inverse(transform.rotation) * direction;
+    float best = -FLT_MAX;
+    glm::vec3 bestVertex(0.0f);
+
+    for (size_t i = 0; i < vertexCount; ++i) {
+        float d = glm::dot(vertices[i], localDir);
+        if (d > best) {
+            best = d;
+            bestVertex = vertices[i];
+        }
+    }
+
+    return toWorld(transform, bestVertex);
+}
+
+void TriangleMeshShape::queryOverlap(const BoundingBox& worldBox, const Transform& transform,
+                                     std::vector<uint32_t>& triangles) const {
+    // Conservative local box from the world box corners
+    Transform inverse = inverseRigid(transform);
+    BoundingBox localBox;
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 corner((i & 1) ? worldBox.max.x : worldBox.min.x,
+                         (i & 2) ? worldBox.max.y : worldBox.min.y,
+                         (i & 4) ? worldBox.max.z : worldBox.min.z);
+        localBox.expand(toLocal(inverse, corner));
+    }
+
+    bvh.queryAabb(localBox, [&triangles](uint32_t triangle) { triangles.push_back(triangle); });
+}
+
+void TriangleMeshShape::getTriangle(uint32_t index, glm::vec3& a, glm::vec3& b, glm::vec3& c) const {
+    const uint32_t* tri = indices + static_cast<size_t>(index) * 3;
+    a = vertices[tri[0]];
+    b = vertices[tri[1]];
+    c = vertices[tri[2]];
+}
+
+size_t TriangleMeshShape::collideSphere(const glm::vec3& center, float radius, const Transform& transform,
+                                        MeshContact* contacts, size_t maxContacts) const {
+    Transform inverse = inverseRigid(transform);
+    glm::vec3 localCenter = toLocal(inverse, center);
+    BoundingBox query(localCenter - glm::vec3(radius), localCenter + glm::vec3(radius));
+
+    size_t count = 0;
+    bvh.queryAabb(query, [&](uint32_t triangle) {
+        glm::vec3 a, b, c;
+        getTriangle(triangle, a, b, c);
+        MeshContact local[geometry::MaxSphereTriangleContacts];
+        size_t n = geometry::collideSphereTriangle(localCenter, radius, a, b, c, local);
+        geometry::appendMeshContacts(local, n, triangle, transform, contacts, count, maxContacts);
+    });
+
+    return count;
+}
+
+size_t TriangleMeshShape::collideCapsule(const glm::vec3& pointA, const glm::vec3& pointB, float radius,
+                                         const Transform& transform, MeshContact* contacts,
+                                         size_t maxContacts) const {
+    Transform inverse = inverseRigid(transform);
+    glm::vec3 p = toLocal(inverse, pointA);
+    glm::vec3 q = toLocal(inverse, pointB);
+    BoundingBox query(glm::min(p, q) - glm::vec3(radius), glm::max(p, q) + glm::vec3(radius));
+
+    size_t count = 0;
+    bvh.queryAabb(query, [&](uint32_t triangle) {
+        glm::vec3 a, b, c;
+        getTriangle(triangle, a, b, c);
+        MeshContact local[geometry::MaxCapsuleTriangleContacts];
+        size_t n = geometry::collideCapsuleTriangle(p, q, radius, a, b, c, local);
+        geometry::appendMeshContacts(local, n, triangle, transform, contacts, count, maxContacts);
+    });
+
+    return count;
+}
+
+size_t TriangleMeshShape::collideBox(const glm::vec3& halfExtents, const Transform& boxTransform,
+                                     const Transform& transform, MeshContact* contacts,
+                                     size_t maxContacts) const {
+    Transform inverse = inverseRigid(transform);
+    glm::vec3 center = toLocal(inverse, boxTransform.position);
+    glm::mat3 boxRotation = glm::mat3_cast(inverse.rotation * boxTransform.rotation);
+    const glm::vec3 axes[3] = { boxRotation[0], boxRotation[1], boxRotation[2] };
+
+    glm::vec3 localExtent(0.0f);
+    for (int i = 0; i < 3; ++i) {
+        localExtent += glm::abs(axes[i]) * halfExtents[i];
+    }
+    BoundingBox query(center - localExtent, center + localExtent);
+
+    size_t count = 0;
+    bvh.queryAabb(query, [&](uint32_t triangle) {
+        glm::vec3 a, b, c;
+        getTriangle(triangle, a, b, c);
+        MeshContact local[geometry::MaxBoxTriangleContacts];
+        size_t n = geometry::collideBoxTriangle(center, axes, halfExtents, a, b, c, local);
+        geometry::appendMeshContacts(local, n, triangle, transform, contacts, count, maxContacts);
+    });
+
+    return count;
+}
+
+size_t TriangleMeshShape::collideHull(const ConvexHullShape& hull, const Transform& hullTransform,
+                                     const Transform& transform, uint32_t supportHints[2], MeshContact* contacts,
+                                     size_t maxContacts) const {
+    Transform inverse = inverseRigid(transform);
+    Transform localTransform;
+    localTransform.rotation = inverse.rotation * hullTransform.rotation;
+    localTransform.position = toLocal(inverse, hullTransform.position);
+    BoundingBox query = hull.getAABB(localTransform);
+
+    size_t count = 0;
+    bvh.queryAabb(query, [&](uint32_t triangle) {
+        glm::vec3 a, b, c;
+        getTriangle(triangle, a, b, c);
+        MeshContact local[geometry::MaxHullTriangleContacts];
+        size_t n = geometry::collideHullTriangle(hull, localTransform.rotation, localTransform.position,
+                                                 a, b, c, supportHints, local);
+        geometry::appendMeshContacts(local, n, triangle, transform, contacts, count, maxContacts);
+    });
+
+    return count;
+}
+
+} // namespace engine::physics
@@ -0,0 +1,77 @@
+#pragma once
+#include "../CollisionShape.hpp"
+#include "../collision/QuantizedBvh.hpp"
+#include "../collision/TriangleCollision.hpp"
+#include "../../core/MappedFile.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace engine::physics {
+
+class ConvexHullShape;
+
+/**
+ * @brief Static triangle mesh collision shape for level geometry
+ * Triangles are culled through a quantized BVH so a single broad phase
+ * proxy can stand in for an entire level section. Meshes can be built at
+ * runtime or saved once and memory-mapped back in without any parsing.
+ * Intended for static bodies; mass properties are zero.
+ */
+class TriangleMeshShape : public CollisionShape {
+public:
+    TriangleMeshShape(std::vector<glm::vec3> vertices, std::vector<uint32_t> indices);
+    TriangleMeshShape(const TriangleMeshShape&) = delete;
+    TriangleMeshShape& operator=(const TriangleMeshShape&) = delete;
+
+    // Binary cache: build offline with saveToFile, load with loadFromFile (memory-mapped)
+    bool saveToFile(const std::string& path) const;
+    static std::shared_ptr<TriangleMeshShape> loadFromFile(const std::string& path);
+
+    // CollisionShape interface
+    ShapeType getType() const override { return ShapeType::ConcaveMesh; }
+    BoundingBox getAABB(const Transform& transform) const override;
+    bool raycast(const Ray& ray, const Transform& transform, RaycastHit& hit) const override;
+    glm::vec3 support(const glm::vec3& direction, const Transform& transform) const override;
+    float calculateVolume() const override { return 0.0f; }
+    glm::mat3 calculateInertiaTensor(float /*mass*/) const override { return glm::mat3(0.0f); }
+
+    // Mid-phase queries; boxes are in world space
+    void queryOverlap(const BoundingBox& worldBox, const Transform& transform,
+                      std::vector<uint32_t>& triangles) const;
+
+    // Contact generation (world space in, world space out); returns contacts written
+    size_t collideSphere(const glm::vec3& center, float radius, const Transform& transform,
+                         MeshContact* contacts, size_t maxContacts) const;
+    size_t collideCapsule(const glm::vec3& pointA, const glm::vec3& pointB, float radius,
+                          const Transform& transform, MeshContact* contacts, size_t maxContacts) const;
+    size_t collideBox(const glm::vec3& halfExtents, const Transform& boxTransform,
+                      const Transform& transform, MeshContact* contacts, size_t maxContacts) const;
+    // supportHints: start vertices for the hull's support searches, updated
+    size_t collideHull(const ConvexHullShape& hull, const Transform& hullTransform, const Transform& transform,
+                       uint32_t supportHints[2], MeshContact* contacts, size_t maxContacts) const;
+
+    // Mesh data
+    size_t getTriangleCount() const { return triangleCount; }
+    size_t getVertexCount() const { return vertexCount; }
+    void getTriangle(uint32_t index, glm::vec3& a, glm::vec3& b, glm::vec3& c) const;
+    const QuantizedBvh& getBvh() const { return bvh; }
+    bool isMemoryMapped() const { return mappedFile != nullptr; }
+
+private:
+    TriangleMeshShape() = default;
+
+    // Views into either the owned vectors or the mapped file
+    const glm::vec3* vertices = nullptr;
+    const uint32_t* indices = nullptr;
+    size_t vertexCount = 0;
+    size_t triangleCount = 0;
+
+    std::vector<glm::vec3> ownedVertices;
+    std::vector<uint32_t> ownedIndices;
+    std::unique_ptr<engine::core::io::MappedFile> mappedFile;
+
+    QuantizedBvh bvh;
+};
+
+} // namespace engine::physics
@@ -77,9 +77,44 @@ Scene3D::Scene3D(float aspectRatio)
     clothMesh->uploadData(vertices, indices);
 }
 
+void Scene3D::setAsyncPhysics(bool enabled) {
+    if (enabled && !physicsThread) {
+        physicsThread = std::make_unique<engine::physics::PhysicsThread<engine::physics::PhysicsWorld3D>>(
+            *physicsWorld, 1.0f / 60.0f);
+        // Wind is a force on every physics step, whatever the frame rate
+        physicsThread->setStepHook([this](engine::physics::PhysicsWorld3D&) { applyWind(); });
+        physicsThread->start();
+    } else if (!enabled && physicsThread) {
+        physicsThread.reset();
+    }
+}
+
 void Scene3D::update(float dt) {
+    if (physicsThread) {
+        // The scene's cloth is registered first, so its particles lead the snapshot
+        const auto& snapshot = physicsThread->acquireSnapshot();
+        const size_t clothParticles = static_cast<size_t>((clothWidth + 1) * (clothHeight + 1));
+        if (snapshot.particlePositions.size() >= clothParticles) {
+            updateClothMesh(snapshot.particlePositions.data(), clothParticles);
+        }
+        return;
+    }
+
     physicsWorld->update(dt);
 
+    if (!physicsWorld->getCloths().empty()) {
+        applyWind();
+
+        const auto& particles = physicsWorld->getCloths()[0]->getParticles();
+        clothPositions.resize(particles.size());
+        for (size_t i = 0; i < particles.size(); ++i) {
+            clothPositions[i] = particles[i]->getPosition();
+        }
+        updateClothMesh(clothPositions.data(), clothPositions.size());
+    }
+}
+
+void Scene3D::applyWind() const {
     if (!physicsWorld->getCloths().empty()) {
         auto cloth = physicsWorld->getCloths()[0];
         const auto& particles = cloth->getParticles();
@@ -107,57 +142,60 @@ void Scene3D::update(float dt) {
                 particle->applyForce(randomFlutter * flutterStrength);
             }
         }
+    }
+}
 
-        // Update vertices
-        std::vector<engine::graphics::Vertex3D> updatedVertices(particles.size());
-
-        for (size_t i = 0; i < particles.size(); ++i) {
-            updatedVertices[i].position = particles[i]->getPosition();
-            updatedVertices[i].normal = glm::vec3(0.0f);
-            updatedVertices[i].texCoord = glm::vec2(
-                (i % (clothWidth + 1)) / float(clothWidth),
-                (i / (clothWidth + 1)) / float(clothHeight)
-            );
-        }
-
-        int w = clothWidth + 1;
-        int h = clothHeight + 1;
-
-        for (int y = 0; y < h - 1; ++y) {
-            for (int x = 0; x < w - 1; ++x) {
-                int i0 = y * w + x;
-                int i1 = i0 + 1;
-                int i2 = i0 + w;
-                int i3 = i2 + 1;
-
-                glm::vec3 normal1 = glm::normalize(glm::cross(
-                    updatedVertices[i2].position - updatedVertices[i0].position,
-                    updatedVertices[i1].position - updatedVertices[i0].position
-                ));
-                glm::vec3 normal2 = glm::normalize(glm::cross(
-                    updatedVertices[i3].position - updatedVertices[i1].position,
-                    updatedVertices[i2].position - updatedVertices[i1].position
-                ));
-
-                updatedVertices[i0].normal += normal1;
-                updatedVertices[i2].normal += normal1;
-                updatedVertices[i1].normal += normal1;
-
-                updatedVertices[i1].normal += normal2;
-                updatedVertices[i2].normal += normal2;
-                updatedVertices[i3].normal += normal2;
-            }
-        }
+void Scene3D::updateClothMesh(const glm::vec3* positions, size_t count) {
+    // Update vertices; the buffer is kept between frames
+    std::vector<engine::graphics::Vertex3D>& updatedVertices = clothVertices;
+    updatedVertices.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        updatedVertices[i].position = positions[i];
+        updatedVertices[i].normal = glm::vec3(0.0f);
+        updatedVertices[i].texCoord = glm::vec2(
+            (i % (clothWidth + 1)) / float(clothWidth),
+            (i / (clothWidth + 1)) / float(clothHeight)
+        );
+    }
 
-        for (auto& v : updatedVertices) {
-            if (glm::length(v.normal) > 1e-6f)
-                v.normal = glm::normalize(v.normal);
-            else
-                v.normal = glm::vec3(0.0f, 1.0f, 0.0f); // fallback
+    int w = clothWidth + 1;
+    int h = clothHeight + 1;
+
+    for (int y = 0; y < h - 1; ++y) {
+        for (int x = 0; x < w - 1; ++x) {
+            int i0 = y * w + x;
+            int i1 = i0 + 1;
+            int i2 = i0 + w;
+            int i3 = i2 + 1;
+
+            glm::vec3 normal1 = glm::normalize(glm::cross(
+                updatedVertices[i2].position - updatedVertices[i0].position,
+                updatedVertices[i1].position - updatedVertices[i0].position
+            ));
+            glm::vec3 normal2 = glm::normalize(glm::cross(
+                updatedVertices[i3].position - updatedVertices[i1].position,
+                updatedVertices[i2].position - updatedVertices[i1].position
+            ));
+
+            updatedVertices[i0].normal += normal1;
+            updatedVertices[i2].normal += normal1;
+            updatedVertices[i1].normal += normal1;
+
+            updatedVertices[i1].normal += normal2;
+            updatedVertices[i2].normal += normal2;
+            updatedVertices[i3].normal += normal2;
         }
+    }
 
-        clothMesh->updateVertices(updatedVertices);
+    for (auto& v : updatedVertices) {
+        if (glm::length(v.normal) > 1e-6f)
+            v.normal = glm::normalize(v.normal);
+        else
+            v.normal = glm::vec3(0.0f, 1.0f, 0.0f); // fallback
     }
+
+    clothMesh->updateVertices(updatedVertices);
 }
 
 void Scene3D::render() const {
@@ -9,6 +9,7 @@
 #include "../graphics/Shader.hpp"
 #include "../graphics/Mesh3D.hpp"
 #include "../physics/PhysicsWorld3D.hpp"
+#include "../physics/PhysicsThread.hpp"
 #include "../physics/ClothSolver3D.hpp"
 #include "../objects/Ball3D.hpp"
 
@@ -21,6 +22,13 @@ public:
     void update(float dt);
     void render() const;
 
+    // Steps physics on its own thread. Enable once the world is populated;
+    // afterwards the scene renders from published snapshots and changes to
+    // the world must go through the physics thread's command queue.
+    void setAsyncPhysics(bool enabled);
+    bool isAsyncPhysics() const { return physicsThread != nullptr; }
+    engine::physics::PhysicsThread<engine::physics::PhysicsWorld3D>* getPhysicsThread() { return physicsThread.get(); }
+
     std::shared_ptr<engine::physics::PhysicsWorld3D> getPhysicsWorld();
     std::shared_ptr<engine::graphics::Camera> getCamera();
 
@@ -52,7 +60,14 @@ public:
     
     Material clothMaterial;
     Light sceneLight;
-    
+
+private:
+    std::unique_ptr<engine::physics::PhysicsThread<engine::physics::PhysicsWorld3D>> physicsThread;
+    std::vector<glm::vec3> clothPositions;
+    std::vector<engine::graphics::Vertex3D> clothVertices;
+
+    void applyWind() const;
+    void updateClothMesh(const glm::vec3* positions, size_t count);
 };
 
 } // namespace engine::scene
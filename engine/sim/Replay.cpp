@@ -0,0 +1,647 @@
+#include "Replay.hpp"
+#include "../core/Hash.hpp"
+#include "../core/Logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace engine::sim {
+
+using engine::core::log::Logger;
+using engine::core::log::LogLevel;
+using physics::BodyHandle;
+using physics::RigidBody;
+using physics::SceneFile;
+using Command = ReplayFormat::Command;
+
+namespace {
+    constexpr char ReplayMagic[4] = {'L', 'R', 'P', 'L'};
+
+    uint64_t alignTo16(uint64_t offset) {
+        return (offset + 15) & ~uint64_t(15);
+    }
+
+    uint32_t floatBits(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // Appends one command; fields must be written in the order the reader
+    // reads them
+    class StreamWriter {
+    public:
+        StreamWriter(std::vector<uint8_t>& out, ReplayFormat::DeltaState& delta, Command command)
+            : out(out), delta(delta), index(static_cast<uint32_t>(command)) {
+            out.push_back(static_cast<uint8_t>(command));
+        }
+
+        void varint(uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        void id(uint32_t value) {
+            const int64_t diff = int64_t(value) - (int64_t(delta.lastId[index]) + 1);
+            varint((static_cast<uint64_t>(diff) << 1) ^ static_cast<uint64_t>(diff >> 63));
+            delta.lastId[index] = value;
+        }
+
+        void value(float value) {
+            const uint32_t bits = floatBits(value);
+            varint(bits ^ delta.floatBits[index][field]);
+            delta.floatBits[index][field++] = bits;
+        }
+
+        void vec3(const glm::vec3& v) {
+            value(v.x);
+            value(v.y);
+            value(v.z);
+        }
+
+        void raw64(uint64_t value) {
+            for (int i = 0; i < 8; ++i) {
+                out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+            }
+        }
+
+    private:
+        std::vector<uint8_t>& out;
+        ReplayFormat::DeltaState& delta;
+        uint32_t index;
+        uint32_t field = 0;
+    };
+
+    // Mirror of StreamWriter; reads past the end set ok() to false and
+    // return zeros
+    class StreamReader {
+    public:
+        StreamReader(const uint8_t* data, size_t size, size_t& cursor, ReplayFormat::DeltaState& delta,
+                     Command command)
+            : data(data), size(size), cursor(cursor), delta(delta), index(static_cast<uint32_t>(command)) {}
+
+        bool ok() const { return valid; }
+
+        uint64_t varint() {
+            uint64_t result = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (cursor >= size) break;
+                const uint8_t byte = data[cursor++];
+                result |= uint64_t(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return result;
+            }
+            valid = false;
+            return 0;
+        }
+
+        uint32_t id() {
+            const uint64_t encoded = varint();
+            const int64_t diff = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+            const uint32_t value = static_cast<uint32_t>(int64_t(delta.lastId[index]) + 1 + diff);
+            delta.lastId[index] = value;
+            return value;
+        }
+
+        float value() {
+            const uint32_t bits = static_cast<uint32_t>(varint()) ^ delta.floatBits[index][field];
+            delta.floatBits[index][field++] = bits;
+            float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        glm::vec3 vec3() {
+            const float x = value();
+            const float y = value();
+            const float z = value();
+            return glm::vec3(x, y, z);
+        }
+
+        uint64_t raw64() {
+            if (size - cursor < 8) {
+                valid = false;
+                return 0;
+            }
+            uint64_t result = 0;
+            for (int i = 0; i < 8; ++i) {
+                result |= uint64_t(data[cursor++]) << (i * 8);
+            }
+            return result;
+        }
+
+    private:
+        const uint8_t* data;
+        size_t size;
+        size_t& cursor;
+        ReplayFormat::DeltaState& delta;
+        uint32_t index;
+        uint32_t field = 0;
+        bool valid = true;
+    };
+
+    // Recorder and player must advance a frame the same way
+    void advance(physics::PhysicsWorld& world, physics::VertletSystem3D* clothSystem, float dt,
+                 int clothIterations) {
+        world.update(dt);
+        if (clothSystem && !clothSystem->getParticles().empty()) {
+            clothSystem->update(dt, world.getGravity(), clothIterations);
+        }
+    }
+
+    uint64_t frameHash(const physics::PhysicsWorld& world, const physics::VertletSystem3D* clothSystem) {
+        core::StateHasher hasher(world.computeStateHash());
+        if (clothSystem) {
+            for (const auto& particle : clothSystem->getParticles()) {
+                const glm::vec3& position = particle->getPosition();
+                hasher.add(position.x);
+                hasher.add(position.y);
+                hasher.add(position.z);
+            }
+        }
+        return hasher.get();
+    }
+
+    BodyHandle spawn(physics::PhysicsWorld& world, const std::shared_ptr<physics::CollisionShape>& shape,
+                     RigidBody::BodyType type, float mass, const glm::vec3& position,
+                     const glm::quat& orientation, const glm::vec3& linearVelocity) {
+        return world.createRigidBodies(1, [&](RigidBody& body, size_t) {
+            if (shape) {
+                body.setCollisionShape(shape);
+            }
+            body.setPosition(position);
+            body.setOrientation(orientation);
+            body.setLinearVelocity(linearVelocity);
+        }, type, mass).front();
+    }
+
+    void writeBlock(std::ofstream& out, const void* data, uint64_t offset, uint64_t size) {
+        static const char padding[16] = {};
+        const uint64_t position = static_cast<uint64_t>(out.tellp());
+        out.write(padding, static_cast<std::streamsize>(offset - position));
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+}
+
+// ============================================================================
+// ReplayRecorder
+// ============================================================================
+
+ReplayRecorder::ReplayRecorder(physics::PhysicsWorld& world, physics::VertletSystem3D* clothSystem,
+                               std::vector<const physics::ClothSolver3D*> cloths, int clothIterations)
+    : world(world), clothSystem(clothSystem), cloths(std::move(cloths)), clothIterations(clothIterations) {}
+
+ReplayRecorder::~ReplayRecorder() = default;
+
+bool ReplayRecorder::begin() {
+    recording = false;
+    if (!characters.empty()) {
+        Logger::log("Replay recording must begin before characters are created", LogLevel::Error);
+        return false;
+    }
+
+    // Bodies removed since the last step are still listed; take them out so
+    // the scene, snapshot and slot order agree
+    world.flushRemovals();
+    world.setDeterministic(true);
+    if (!SceneFile::write(scene, world, cloths)) {
+        return false;
+    }
+    world.saveSnapshot(snapshot);
+    world.getSlotOrder(slotOrder);
+
+    clothState.clear();
+    for (const physics::ClothSolver3D* cloth : cloths) {
+        for (const auto& particle : cloth->getParticles()) {
+            const glm::vec3& previous = particle->getPreviousPosition();
+            clothState.insert(clothState.end(), {previous.x, previous.y, previous.z});
+        }
+    }
+
+    // The player creates the scene's bodies in dense order, so that order
+    // numbers them
+    bodyIds.clear();
+    const auto& dense = world.getRigidBodies();
+    for (size_t i = 0; i < dense.size(); ++i) {
+        bodyIds.emplace(dense[i]->getHandle(), static_cast<uint32_t>(i));
+    }
+    nextBodyId = static_cast<uint32_t>(dense.size());
+
+    stream.clear();
+    delta = ReplayFormat::DeltaState{};
+    frameCount = 0;
+    flags = recordHashes ? ReplayFormat::FlagStateHashes : 0u;
+    warnedUntracked = false;
+    recording = true;
+    return true;
+}
+
+bool ReplayRecorder::lookupBody(BodyHandle handle, uint32_t& id) {
+    auto found = bodyIds.find(handle);
+    if (found != bodyIds.end()) {
+        id = found->second;
+        return true;
+    }
+    if (recording && !warnedUntracked) {
+        Logger::log("Replay recorder: input on a body it did not see created; the replay will diverge",
+                    LogLevel::Warning);
+        warnedUntracked = true;
+    }
+    return false;
+}
+
+BodyHandle ReplayRecorder::spawnBody(const std::shared_ptr<physics::CollisionShape>& shape,
+                                     RigidBody::BodyType type, float mass, const glm::vec3& position,
+                                     const glm::quat& orientation, const glm::vec3& linearVelocity) {
+    const BodyHandle handle = spawn(world, shape, type, mass, position, orientation, linearVelocity);
+    if (!recording) return handle;
+
+    SceneFile::ShapeRecord shapeRecord{};
+    shapeRecord.type = SceneFile::NoShape;
+    if (shape && !SceneFile::describeShape(*shape, shapeRecord)) {
+        Logger::log("Replay recorder: spawned shape type is not supported and is recorded as none",
+                    LogLevel::Warning);
+        shapeRecord = SceneFile::ShapeRecord{};
+        shapeRecord.type = SceneFile::NoShape;
+    }
+
+    StreamWriter out(stream, delta, Command::SpawnBody);
+    out.varint(shapeRecord.type);
+    out.varint(static_cast<uint32_t>(type));
+    for (float param : shapeRecord.params) {
+        out.value(param);
+    }
+    out.value(mass);
+    out.vec3(position);
+    out.value(orientation.w);
+    out.value(orientation.x);
+    out.value(orientation.y);
+    out.value(orientation.z);
+    out.vec3(linearVelocity);
+
+    bodyIds.emplace(handle, nextBodyId++);
+    return handle;
+}
+
+void ReplayRecorder::removeBody(BodyHandle handle) {
+    uint32_t id;
+    if (lookupBody(handle, id)) {
+        StreamWriter out(stream, delta, Command::RemoveBody);
+        out.id(id);
+        bodyIds.erase(handle);
+    }
+    world.removeRigidBody(handle);
+}
+
+void ReplayRecorder::applyForce(BodyHandle handle, const glm::vec3& force) {
+    RigidBody* body = world.getRigidBody(handle);
+    if (!body) return;
+    uint32_t id;
+    if (lookupBody(handle, id)) {
+        StreamWriter out(stream, delta, Command::ApplyForce);
+        out.id(id);
+        out.vec3(force);
+    }
+    body->applyForce(force);
+}
+
+void ReplayRecorder::applyImpulse(BodyHandle handle, const glm::vec3& impulse) {
+    RigidBody* body = world.getRigidBody(handle);
+    if (!body) return;
+    uint32_t id;
+    if (lookupBody(handle, id)) {
+        StreamWriter out(stream, delta, Command::ApplyImpulse);
+        out.id(id);
+        out.vec3(impulse);
+    }
+    body->applyImpulse(impulse);
+}
+
+uint32_t ReplayRecorder::createCharacter(float radius, float height, float mass, const glm::vec3& position) {
+    auto character = std::make_unique<physics::CharacterController>(&world, radius, height, mass);
+    character->setPosition(position);
+    if (recording) {
+        StreamWriter out(stream, delta, Command::CreateCharacter);
+        out.value(radius);
+        out.value(height);
+        out.value(mass);
+        out.vec3(position);
+        bodyIds.emplace(character->getRigidBody()->getHandle(), nextBodyId++);
+    }
+    characters.push_back(std::move(character));
+    return static_cast<uint32_t>(characters.size() - 1);
+}
+
+void ReplayRecorder::moveCharacter(uint32_t id, const glm::vec3& displacement, float dt) {
+    if (recording) {
+        StreamWriter out(stream, delta, Command::MoveCharacter);
+        out.id(id);
+        out.vec3(displacement);
+        out.value(dt);
+    }
+    characters[id]->move(displacement, dt);
+}
+
+void ReplayRecorder::jumpCharacter(uint32_t id, float force) {
+    if (recording) {
+        StreamWriter out(stream, delta, Command::JumpCharacter);
+        out.id(id);
+        out.value(force);
+    }
+    characters[id]->jump(force);
+}
+
+void ReplayRecorder::applyClothForce(uint32_t particleIndex, const glm::vec3& force) {
+    if (!clothSystem || particleIndex >= clothSystem->getParticles().size()) return;
+    if (recording) {
+        StreamWriter out(stream, delta, Command::ClothForce);
+        out.id(particleIndex);
+        out.vec3(force);
+    }
+    clothSystem->getParticles()[particleIndex]->applyForce(force);
+}
+
+void ReplayRecorder::step(float dt) {
+    advance(world, clothSystem, dt, clothIterations);
+    if (!recording) return;
+
+    StreamWriter out(stream, delta, Command::Frame);
+    out.value(dt);
+    if (flags & ReplayFormat::FlagStateHashes) {
+        out.raw64(frameHash(world, clothSystem));
+    }
+    ++frameCount;
+}
+
+bool ReplayRecorder::save(const std::string& path) const {
+    if (!recording) {
+        Logger::log("Replay recorder: nothing recorded to save", LogLevel::Error);
+        return false;
+    }
+
+    ReplayFormat::FileHeader header{};
+    std::memcpy(header.magic, ReplayMagic, sizeof(header.magic));
+    header.version = ReplayFormat::Version;
+    header.flags = flags;
+    header.frameCount = frameCount;
+    header.clothIterations = clothIterations;
+    header.sceneSize = scene.size();
+    header.snapshotSize = snapshot.size();
+    header.clothStateSize = clothState.size() * sizeof(float);
+    header.slotOrderSize = slotOrder.size() * sizeof(BodyHandle);
+    header.streamSize = stream.size();
+    header.sceneOffset = alignTo16(sizeof(header));
+    header.snapshotOffset = alignTo16(header.sceneOffset + header.sceneSize);
+    header.clothStateOffset = alignTo16(header.snapshotOffset + header.snapshotSize);
+    header.slotOrderOffset = alignTo16(header.clothStateOffset + header.clothStateSize);
+    header.streamOffset = alignTo16(header.slotOrderOffset + header.slotOrderSize);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        Logger::log("Failed to write replay file: " + path, LogLevel::Error);
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeBlock(out, scene.data(), header.sceneOffset, header.sceneSize);
+    writeBlock(out, snapshot.data(), header.snapshotOffset, header.snapshotSize);
+    writeBlock(out, clothState.data(), header.clothStateOffset, header.clothStateSize);
+    writeBlock(out, slotOrder.data(), header.slotOrderOffset, header.slotOrderSize);
+    writeBlock(out, stream.data(), header.streamOffset, header.streamSize);
+    return static_cast<bool>(out);
+}
+
+// ============================================================================
+// ReplayPlayer
+// ============================================================================
+
+ReplayPlayer::ReplayPlayer() = default;
+
+ReplayPlayer::~ReplayPlayer() {
+    // Characters remove their bodies from the world, so they go first
+    characters.clear();
+}
+
+bool ReplayPlayer::open(const std::string& path) {
+    characters.clear();
+    world.reset();
+    sourcePath = path;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    auto fail = [&](const std::string& reason) {
+        Logger::log("Invalid replay file " + path + ": " + reason, LogLevel::Error);
+        file.close();
+        return false;
+    };
+
+    if (file.size() < sizeof(header)) return fail("too small");
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, ReplayMagic, sizeof(header.magic)) != 0) return fail("bad magic");
+    if (header.version != ReplayFormat::Version) {
+        return fail("unsupported version " + std::to_string(header.version));
+    }
+
+    const std::pair<uint64_t, uint64_t> blocks[] = {
+        {header.sceneOffset, header.sceneSize},
+        {header.snapshotOffset, header.snapshotSize},
+        {header.clothStateOffset, header.clothStateSize},
+        {header.slotOrderOffset, header.slotOrderSize},
+        {header.streamOffset, header.streamSize},
+    };
+    for (const auto& block : blocks) {
+        if (block.first % 16 != 0 || block.first > file.size() || block.second > file.size() - block.first) {
+            return fail("block out of bounds");
+        }
+    }
+    if (header.clothStateSize % (3 * sizeof(float)) != 0) return fail("bad cloth state size");
+    if (header.slotOrderSize % sizeof(BodyHandle) != 0) return fail("bad slot order size");
+
+    return restart();
+}
+
+bool ReplayPlayer::restart() {
+    characters.clear();
+    cloths.clear();
+    clothSystem.reset();
+    world.reset();
+    bodies.clear();
+    lastShape.reset();
+    delta = ReplayFormat::DeltaState{};
+    cursor = 0;
+    frame = 0;
+    firstDivergentFrame = UINT32_MAX;
+    exactStart = false;
+
+    if (!file.isOpen() ||
+        !scene.openBuffer(file.data() + header.sceneOffset, static_cast<size_t>(header.sceneSize), sourcePath)) {
+        return false;
+    }
+
+    physics::PhysicsWorld::Settings settings;
+    settings.expectedBodies = std::max<size_t>(scene.getBodyCount(), 1);
+    world = std::make_unique<physics::PhysicsWorld>(settings);
+    scene.applyWorldSettings(*world);
+    world->setDeterministic(true);
+
+    // Put the slot table back first so the scene's bodies land in the slots
+    // they had when recording began
+    const auto* order = reinterpret_cast<const BodyHandle*>(file.data() + header.slotOrderOffset);
+    const std::vector<BodyHandle> slotOrder(order, order + header.slotOrderSize / sizeof(BodyHandle));
+    world->restoreSlotOrder(slotOrder);
+    bodies = scene.createBodies(*world);
+
+    clothSystem = std::make_unique<physics::VertletSystem3D>();
+    cloths = scene.createCloths(*clothSystem);
+    scene.close();
+
+    const uint8_t* snapshotData = file.data() + header.snapshotOffset;
+    const std::vector<uint8_t> snapshot(snapshotData, snapshotData + header.snapshotSize);
+    exactStart = world->restoreSnapshot(snapshot);
+    if (!exactStart) {
+        Logger::log("Replay " + sourcePath + ": body handles differ from the recording; starting from the "
+                    "scene state without state hash checks", LogLevel::Warning);
+    }
+
+    const float* previous = reinterpret_cast<const float*>(file.data() + header.clothStateOffset);
+    const size_t previousCount = static_cast<size_t>(header.clothStateSize / (3 * sizeof(float)));
+    size_t particleIndex = 0;
+    for (const auto& cloth : cloths) {
+        for (const auto& particle : cloth->getParticles()) {
+            if (particleIndex >= previousCount) break;
+            const float* p = previous + particleIndex * 3;
+            particle->setPreviousPosition(glm::vec3(p[0], p[1], p[2]));
+            ++particleIndex;
+        }
+    }
+    return true;
+}
+
+bool ReplayPlayer::stepFrame() {
+    if (!world || frame >= header.frameCount) {
+        return false;
+    }
+
+    const uint8_t* data = file.data() + header.streamOffset;
+    const size_t size = static_cast<size_t>(header.streamSize);
+
+    auto malformed = [&](const char* reason) {
+        Logger::log("Replay " + sourcePath + " frame " + std::to_string(frame) + ": " + reason,
+                    LogLevel::Error);
+        frame = header.frameCount;
+        return false;
+    };
+
+    auto bodyAt = [&](uint32_t id) -> RigidBody* {
+        return id < bodies.size() ? world->getRigidBody(bodies[id]) : nullptr;
+    };
+
+    while (cursor < size) {
+        const uint8_t tag = data[cursor++];
+        if (tag >= ReplayFormat::CommandCount) return malformed("unknown command");
+        const Command command = static_cast<Command>(tag);
+        StreamReader in(data, size, cursor, delta, command);
+
+        switch (command) {
+            case Command::Frame: {
+                const float dt = in.value();
+                const bool hashed = (header.flags & ReplayFormat::FlagStateHashes) != 0;
+                const uint64_t expected = hashed ? in.raw64() : 0;
+                if (!in.ok()) return malformed("truncated frame");
+
+                advance(*world, clothSystem.get(), dt, header.clothIterations);
+                if (hashed && exactStart && firstDivergentFrame == UINT32_MAX &&
+                    frameHash(*world, clothSystem.get()) != expected) {
+                    firstDivergentFrame = frame;
+                }
+                ++frame;
+                return true;
+            }
+            case Command::SpawnBody: {
+                SceneFile::ShapeRecord shapeRecord{};
+                shapeRecord.type = static_cast<uint32_t>(in.varint());
+                const auto type = static_cast<RigidBody::BodyType>(in.varint());
+                for (float& param : shapeRecord.params) {
+                    param = in.value();
+                }
+                const float mass = in.value();
+                const glm::vec3 position = in.vec3();
+                const float w = in.value();
+                const float x = in.value();
+                const float y = in.value();
+                const float z = in.value();
+                const glm::vec3 linearVelocity = in.vec3();
+                if (!in.ok()) break;
+
+                std::shared_ptr<physics::CollisionShape> shape;
+                if (shapeRecord.type != SceneFile::NoShape) {
+                    if (!lastShape || std::memcmp(&shapeRecord, &lastShapeRecord, sizeof(shapeRecord)) != 0) {
+                        lastShape = SceneFile::createShape(shapeRecord);
+                        lastShapeRecord = shapeRecord;
+                    }
+                    shape = lastShape;
+                }
+                bodies.push_back(spawn(*world, shape, type, mass, position, glm::quat(w, x, y, z), linearVelocity));
+                break;
+            }
+            case Command::RemoveBody: {
+                const uint32_t id = in.id();
+                if (!in.ok() || !bodyAt(id)) return malformed("bad body id");
+                world->removeRigidBody(bodies[id]);
+                bodies[id] = BodyHandle{};
+                break;
+            }
+            case Command::ApplyForce:
+            case Command::ApplyImpulse: {
+                const uint32_t id = in.id();
+                const glm::vec3 value = in.vec3();
+                RigidBody* body = bodyAt(id);
+                if (!in.ok() || !body) return malformed("bad body id");
+                if (command == Command::ApplyForce) body->applyForce(value);
+                else body->applyImpulse(value);
+                break;
+            }
+            case Command::CreateCharacter: {
+                const float radius = in.value();
+                const float height = in.value();
+                const float mass = in.value();
+                const glm::vec3 position = in.vec3();
+                if (!in.ok()) break;
+                auto character = std::make_unique<physics::CharacterController>(world.get(), radius, height, mass);
+                character->setPosition(position);
+                bodies.push_back(character->getRigidBody()->getHandle());
+                characters.push_back(std::move(character));
+                break;
+            }
+            case Command::MoveCharacter: {
+                const uint32_t id = in.id();
+                const glm::vec3 displacement = in.vec3();
+                const float dt = in.value();
+                if (!in.ok() || id >= characters.size()) return malformed("bad character id");
+                characters[id]->move(displacement, dt);
+                break;
+            }
+            case Command::JumpCharacter: {
+                const uint32_t id = in.id();
+                const float force = in.value();
+                if (!in.ok() || id >= characters.size()) return malformed("bad character id");
+                characters[id]->jump(force);
+                break;
+            }
+            case Command::ClothForce: {
+                const uint32_t index = in.id();
+                const glm::vec3 force = in.vec3();
+                if (!in.ok() || index >= clothSystem->getParticles().size()) return malformed("bad particle index");
+                clothSystem->getParticles()[index]->applyForce(force);
+                break;
+            }
+        }
+        if (!in.ok()) return malformed("truncated command");
+    }
+    return malformed("stream ended before the last frame");
+}
+
+} // namespace engine::sim
@@ -0,0 +1,224 @@
+#pragma once
+#include "../physics/PhysicsWorld.hpp"
+#include "../physics/VertletSystem3D.hpp"
+#include "../physics/ClothSolver3D.hpp"
+#include "../physics/SceneFile.hpp"
+#include "../physics/character/CharacterController.hpp"
+#include "../core/MappedFile.hpp"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::sim {
+
+/**
+ * @brief Replay file layout shared by ReplayRecorder and ReplayPlayer
+ *
+ * A fixed header, then four 16-byte aligned blobs holding the initial state
+ * and one command stream:
+ *   - an embedded physics::SceneFile (bodies, shapes, cloths, world settings)
+ *   - PhysicsWorld::saveSnapshot bytes (sleep state, accumulator, pairs)
+ *   - cloth previous positions, three floats per particle in scene order
+ *   - PhysicsWorld::getSlotOrder handles, so bodies come back in the slots
+ *     they had; handle order decides pair order in deterministic mode
+ *
+ * The stream is a sequence of commands, each a tag byte followed by fields.
+ * Integers are LEB128 varints; body, character and particle ids are stored
+ * as the zigzag difference from one past the previous id of the same
+ * command, so loops over consecutive ids cost one byte each. Floats are
+ * stored as a varint of their bits XORed with the same field of the
+ * previous command of that type, so repeated values take one byte and
+ * small changes two or three. A Frame command closes each recorded frame.
+ */
+struct ReplayFormat {
+    enum class Command : uint8_t {
+        Frame = 0,              // dt [, state hash]
+        SpawnBody = 1,          // shape, body type, mass, pose, velocity
+        RemoveBody = 2,         // body id
+        ApplyForce = 3,         // body id, force
+        ApplyImpulse = 4,       // body id, impulse
+        CreateCharacter = 5,    // radius, height, mass, position
+        MoveCharacter = 6,      // character id, displacement, dt
+        JumpCharacter = 7,      // character id, force
+        ClothForce = 8,         // particle index, force
+    };
+    static constexpr uint32_t CommandCount = 9;
+    static constexpr uint32_t MaxFloatFields = 16;
+
+    struct FileHeader {
+        char magic[4];                 // "LRPL"
+        uint32_t version;
+        uint32_t flags;
+        uint32_t frameCount;
+        int32_t clothIterations;
+        uint32_t reserved[3];
+        uint64_t sceneOffset;
+        uint64_t sceneSize;
+        uint64_t snapshotOffset;
+        uint64_t snapshotSize;
+        uint64_t clothStateOffset;
+        uint64_t clothStateSize;
+        uint64_t slotOrderOffset;
+        uint64_t slotOrderSize;
+        uint64_t streamOffset;
+        uint64_t streamSize;
+    };
+
+    static constexpr uint32_t Version = 2;
+    static constexpr uint32_t FlagStateHashes = 1u << 0;   // Frames carry a state hash
+
+    // Previous values the delta coding works against; the writer and reader
+    // update theirs identically
+    struct DeltaState {
+        uint32_t floatBits[CommandCount][MaxFloatFields] = {};
+        uint32_t lastId[CommandCount] = {};
+    };
+};
+
+/**
+ * @brief Records everything fed into a simulation so it can be re-run offline
+ *
+ * begin() captures the world, its cloths and their exact state. After that,
+ * external inputs go through the recorder instead of straight to the world:
+ * each call is applied immediately and appended to the command stream, and
+ * step() advances the world and cloth system and closes the frame. Both
+ * sides run in deterministic mode, and with state hashes on (the default)
+ * each frame stores a hash of bodies and cloth so the player can report the
+ * first frame that diverges.
+ *
+ * Inputs applied to the world directly, bypassing the recorder, are not
+ * captured and will make the replay diverge. Cloths must be every cloth in
+ * the cloth system, in creation order, and cannot be added mid-recording.
+ * Character controllers have internal state the scene format does not hold,
+ * so create them through the recorder after begin().
+ */
+class ReplayRecorder {
+public:
+    ReplayRecorder(physics::PhysicsWorld& world, physics::VertletSystem3D* clothSystem = nullptr,
+                   std::vector<const physics::ClothSolver3D*> cloths = {}, int clothIterations = 5);
+    ~ReplayRecorder();
+
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+    // Captures the initial state and clears any earlier recording
+    bool begin();
+    // Takes effect at the next begin()
+    void setRecordStateHashes(bool enabled) { recordHashes = enabled; }
+
+    // Recorded inputs
+    physics::BodyHandle spawnBody(const std::shared_ptr<physics::CollisionShape>& shape,
+                                  physics::RigidBody::BodyType type, float mass, const glm::vec3& position,
+                                  const glm::quat& orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+                                  const glm::vec3& linearVelocity = glm::vec3(0.0f));
+    void removeBody(physics::BodyHandle handle);
+    void applyForce(physics::BodyHandle handle, const glm::vec3& force);
+    void applyImpulse(physics::BodyHandle handle, const glm::vec3& impulse);
+
+    uint32_t createCharacter(float radius, float height, float mass, const glm::vec3& position);
+    physics::CharacterController& getCharacter(uint32_t id) { return *characters[id]; }
+    void moveCharacter(uint32_t id, const glm::vec3& displacement, float dt);
+    void jumpCharacter(uint32_t id, float force);
+
+    // Force on one particle of the cloth system for the next cloth step
+    void applyClothForce(uint32_t particleIndex, const glm::vec3& force);
+
+    // Advances the world and cloth system by dt and ends the frame
+    void step(float dt);
+
+    bool save(const std::string& path) const;
+
+    uint32_t getFrameCount() const { return frameCount; }
+    size_t getStreamBytes() const { return stream.size(); }
+    bool isRecording() const { return recording; }
+
+private:
+    physics::PhysicsWorld& world;
+    physics::VertletSystem3D* clothSystem;
+    std::vector<const physics::ClothSolver3D*> cloths;
+    int clothIterations;
+    bool recordHashes = true;
+    bool recording = false;
+    bool warnedUntracked = false;
+
+    std::vector<uint8_t> scene;
+    std::vector<uint8_t> snapshot;
+    std::vector<float> clothState;
+    std::vector<physics::BodyHandle> slotOrder;
+    std::vector<uint8_t> stream;
+    ReplayFormat::DeltaState delta;
+    uint32_t flags = 0;
+    uint32_t frameCount = 0;
+
+    // Bodies are named in the stream by the order the replay creates them
+    std::unordered_map<physics::BodyHandle, uint32_t> bodyIds;
+    uint32_t nextBodyId = 0;
+    std::vector<std::unique_ptr<physics::CharacterController>> characters;
+
+    bool lookupBody(physics::BodyHandle handle, uint32_t& id);
+};
+
+/**
+ * @brief Re-runs a recorded capture headless
+ * Rebuilds the world from the capture's initial state and feeds the command
+ * stream back frame by frame. Nothing else runs, so stepping a player under
+ * a profiler isolates the simulation cost of exactly the recorded session.
+ */
+class ReplayPlayer {
+public:
+    ReplayPlayer();
+    ~ReplayPlayer();
+
+    ReplayPlayer(const ReplayPlayer&) = delete;
+    ReplayPlayer& operator=(const ReplayPlayer&) = delete;
+
+    // Maps and validates the capture, then builds its initial state
+    bool open(const std::string& path);
+
+    // Rebuilds the initial state, so a capture can be run repeatedly
+    bool restart();
+
+    // Applies one frame's commands and steps; false at the end of the stream
+    // or on a malformed one
+    bool stepFrame();
+
+    uint32_t getFrame() const { return frame; }
+    uint32_t getFrameCount() const { return header.frameCount; }
+    bool hasStateHashes() const { return (header.flags & ReplayFormat::FlagStateHashes) != 0 && exactStart; }
+
+    // UINT32_MAX while every checked frame has matched the recording
+    uint32_t getFirstDivergentFrame() const { return firstDivergentFrame; }
+    bool hasDiverged() const { return firstDivergentFrame != UINT32_MAX; }
+
+    physics::PhysicsWorld& getWorld() { return *world; }
+    const physics::VertletSystem3D& getClothSystem() const { return *clothSystem; }
+
+private:
+    core::io::MappedFile file;
+    std::string sourcePath;
+    ReplayFormat::FileHeader header{};
+    physics::SceneFile scene;
+
+    // Declared before the characters, which remove their bodies on destruction
+    std::unique_ptr<physics::PhysicsWorld> world;
+    std::unique_ptr<physics::VertletSystem3D> clothSystem;
+    std::vector<std::unique_ptr<physics::ClothSolver3D>> cloths;
+    std::vector<std::unique_ptr<physics::CharacterController>> characters;
+    std::vector<physics::BodyHandle> bodies;       // By replay body id
+
+    ReplayFormat::DeltaState delta;
+    size_t cursor = 0;
+    uint32_t frame = 0;
+    uint32_t firstDivergentFrame = UINT32_MAX;
+    bool exactStart = false;
+
+    // Last spawned shape, reused while spawns repeat it
+    physics::SceneFile::ShapeRecord lastShapeRecord{};
+    std::shared_ptr<physics::CollisionShape> lastShape;
+};
+
+} // namespace engine::sim
@@ -0,0 +1,256 @@
+#include "Scenario.hpp"
+#include "../physics/SphereShape.hpp"
+#include "../physics/BoxShape.hpp"
+#include "../physics/shapes/CapsuleShape.hpp"
+#include "../physics/SceneFile.hpp"
+#include "../core/Logger.hpp"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+namespace engine::sim {
+
+using engine::core::log::Logger;
+using engine::core::log::LogLevel;
+using physics::RigidBody;
+
+namespace {
+    bool readVec3(std::istringstream& in, glm::vec3& value) {
+        return static_cast<bool>(in >> value.x >> value.y >> value.z);
+    }
+
+    bool expectWord(std::istringstream& in, const char* word) {
+        std::string token;
+        return (in >> token) && token == word;
+    }
+
+    // Optional trailing "grid ... spacing ..." and "jitter ..." clauses
+    bool readSpawnOptions(std::istringstream& in, Scenario::BodySpawn& spawn) {
+        std::string option;
+        while (in >> option) {
+            if (option == "grid") {
+                if (!(in >> spawn.grid.x >> spawn.grid.y >> spawn.grid.z)) return false;
+                if (!expectWord(in, "spacing") || !readVec3(in, spawn.spacing)) return false;
+            } else if (option == "jitter") {
+                if (!(in >> spawn.jitter)) return false;
+            } else {
+                return false;
+            }
+        }
+        return glm::all(glm::greaterThan(spawn.grid, glm::ivec3(0)));
+    }
+}
+
+bool Scenario::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        Logger::log("Cannot open scenario: " + path, LogLevel::Error);
+        return false;
+    }
+    return parse(file, path);
+}
+
+bool Scenario::parse(std::istream& input, const std::string& sourceName) {
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream in(line);
+        std::string keyword;
+        if (!(in >> keyword)) continue;
+
+        bool ok = false;
+        if (keyword == "timestep") {
+            ok = static_cast<bool>(in >> timeStep) && timeStep > 0.0f;
+        } else if (keyword == "steps") {
+            ok = static_cast<bool>(in >> steps);
+        } else if (keyword == "gravity") {
+            ok = readVec3(in, gravity);
+        } else if (keyword == "cloth_iterations") {
+            ok = static_cast<bool>(in >> clothIterations);
+        } else if (keyword == "body" || keyword == "static") {
+            BodySpawn spawn;
+            if (keyword == "static") {
+                spawn.type = RigidBody::BodyType::Static;
+                spawn.mass = 0.0f;
+            }
+
+            std::string shapeName;
+            in >> shapeName;
+            if (shapeName == "sphere") {
+                float radius = 0.0f;
+                ok = static_cast<bool>(in >> radius);
+                spawn.shape = std::make_shared<physics::SphereShape>(radius);
+            } else if (shapeName == "box") {
+                glm::vec3 halfExtents(0.0f);
+                ok = readVec3(in, halfExtents);
+                spawn.shape = std::make_shared<physics::BoxShape>(halfExtents);
+            } else if (shapeName == "capsule") {
+                float radius = 0.0f, height = 0.0f;
+                ok = static_cast<bool>(in >> radius >> height);
+                spawn.shape = std::make_shared<physics::CapsuleShape>(radius, height);
+            }
+
+            if (ok && spawn.type != RigidBody::BodyType::Static) {
+                ok = expectWord(in, "mass") && static_cast<bool>(in >> spawn.mass);
+            }
+            ok = ok && expectWord(in, "at") && readVec3(in, spawn.origin) && readSpawnOptions(in, spawn);
+            if (ok) {
+                bodies.push_back(spawn);
+            }
+        } else if (keyword == "cloth") {
+            ClothSpawn cloth;
+            ok = static_cast<bool>(in >> cloth.width >> cloth.height) &&
+                 expectWord(in, "spacing") && static_cast<bool>(in >> cloth.spacing) &&
+                 expectWord(in, "at") && readVec3(in, cloth.origin);
+            if (ok) {
+                cloths.push_back(cloth);
+            }
+        } else if (keyword == "scene") {
+            std::string path;
+            ok = static_cast<bool>(in >> path);
+            if (ok) {
+                sceneFiles.push_back(path);
+            }
+        } else if (keyword == "force") {
+            Force force;
+            std::string target;
+            in >> target;
+            ok = (target == "bodies" || target == "cloth") && readVec3(in, force.force);
+            force.target = target == "cloth" ? Force::Target::Cloth : Force::Target::Bodies;
+
+            std::string option;
+            if (ok && (in >> option)) {
+                ok = option == "steps" && static_cast<bool>(in >> force.firstStep >> force.lastStep);
+            }
+            if (ok) {
+                forces.push_back(force);
+            }
+        }
+
+        if (!ok) {
+            Logger::log(sourceName + ":" + std::to_string(lineNumber) + ": cannot parse '" + line + "'",
+                        LogLevel::Error);
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t Scenario::getBodyCount() const {
+    size_t count = 0;
+    for (const BodySpawn& spawn : bodies) {
+        count += static_cast<size_t>(spawn.grid.x) * spawn.grid.y * spawn.grid.z;
+    }
+    return count;
+}
+
+ScenarioInstance::ScenarioInstance(const Scenario& scenario, uint32_t seed)
+    : scenario(scenario), seed(seed), world([&] {
+          physics::PhysicsWorld::Settings settings;
+          settings.expectedBodies = scenario.getBodyCount();
+          return settings;
+      }()) {
+    world.setTimeStep(scenario.timeStep);
+    world.setGravity(scenario.gravity);
+
+    for (const std::string& path : scenario.sceneFiles) {
+        physics::SceneFile sceneFile;
+        if (!sceneFile.open(path)) {
+            Logger::log("Cannot load scene file " + path + " (seed " + std::to_string(seed) + ")", LogLevel::Error);
+            valid = false;
+            continue;
+        }
+        sceneFile.createBodies(world);
+        for (auto& cloth : sceneFile.createCloths(clothSystem)) {
+            cloths.push_back(std::move(cloth));
+        }
+    }
+
+    // Jitter comes from the seed only, so a seed always reproduces its run
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    for (const Scenario::BodySpawn& spawn : scenario.bodies) {
+        const size_t perLayer = static_cast<size_t>(spawn.grid.x) * spawn.grid.z;
+        const size_t count = perLayer * spawn.grid.y;
+
+        world.createRigidBodies(count, [&](RigidBody& body, size_t index) {
+            const glm::vec3 cell(float(index % spawn.grid.x), float(index / perLayer),
+                                 float((index / spawn.grid.x) % spawn.grid.z));
+            const glm::vec3 jitter = spawn.jitter * glm::vec3(unit(random), unit(random), unit(random));
+            body.setCollisionShape(spawn.shape);
+            body.setPosition(spawn.origin + cell * spawn.spacing + jitter);
+        }, spawn.type, spawn.mass);
+    }
+
+    for (const Scenario::ClothSpawn& spawn : scenario.cloths) {
+        auto cloth = std::make_unique<physics::ClothSolver3D>(clothSystem, spawn.width, spawn.height, spawn.spacing);
+        cloth->createCloth(spawn.origin, glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        cloths.push_back(std::move(cloth));
+    }
+}
+
+void ScenarioInstance::step() {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const Scenario::Force& force : scenario.forces) {
+        if (!force.activeAt(currentStep)) continue;
+
+        if (force.target == Scenario::Force::Target::Bodies) {
+            for (RigidBody* body : world.getRigidBodies()) {
+                if (body->getBodyType() == RigidBody::BodyType::Dynamic) {
+                    body->applyForce(force.force);
+                }
+            }
+        } else {
+            for (const auto& particle : clothSystem.getParticles()) {
+                if (!particle->isPinned()) {
+                    particle->applyForce(force.force);
+                }
+            }
+        }
+    }
+
+    world.update(scenario.timeStep);
+    if (!clothSystem.getParticles().empty()) {
+        clothSystem.update(scenario.timeStep, scenario.gravity, scenario.clothIterations);
+    }
+    ++currentStep;
+
+    lastStepMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+StepMetrics ScenarioInstance::measure() const {
+    StepMetrics metrics;
+    metrics.seed = seed;
+    metrics.step = currentStep;
+    metrics.bodies = static_cast<uint32_t>(world.getRigidBodies().size());
+    metrics.awakeBodies = static_cast<uint32_t>(world.getPerformanceStats().bodiesActive);
+    metrics.contacts = static_cast<uint32_t>(world.getPerformanceStats().contactsGenerated);
+    metrics.stepMs = lastStepMs;
+
+    for (const RigidBody* body : world.getRigidBodies()) {
+        if (body->getBodyType() != RigidBody::BodyType::Dynamic) continue;
+        const float speedSq = glm::dot(body->getLinearVelocity(), body->getLinearVelocity());
+        metrics.kineticEnergy += 0.5f * body->getMass() * speedSq;
+        metrics.maxSpeed = std::max(metrics.maxSpeed, std::sqrt(speedSq));
+    }
+
+    const auto& particles = clothSystem.getParticles();
+    if (!particles.empty()) {
+        metrics.clothLowestY = particles.front()->getPosition().y;
+        for (const auto& particle : particles) {
+            metrics.clothLowestY = std::min(metrics.clothLowestY, particle->getPosition().y);
+        }
+    }
+    return metrics;
+}
+
+} // namespace engine::sim
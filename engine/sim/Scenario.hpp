@@ -0,0 +1,136 @@
+#pragma once
+#include "../physics/PhysicsWorld.hpp"
+#include "../physics/VertletSystem3D.hpp"
+#include "../physics/ClothSolver3D.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace engine::sim {
+
+/**
+ * @brief Headless simulation setup: rigid body spawns, cloth grids and forces
+ *
+ * Loaded from a line-based text file; '#' starts a comment.
+ *
+ *   timestep 0.0166667
+ *   steps 600
+ *   gravity 0 -9.81 0
+ *   cloth_iterations 5
+ *   static box <hx hy hz> at <x y z>
+ *   body sphere <r> mass <m> at <x y z> [grid <nx ny nz> spacing <sx sy sz>] [jitter <j>]
+ *   body box <hx hy hz> mass <m> at <x y z> [grid ...] [jitter <j>]
+ *   body capsule <r> <height> mass <m> at <x y z> [grid ...] [jitter <j>]
+ *   cloth <width> <height> spacing <d> at <x y z>
+ *   scene <file.lscn>
+ *   force bodies|cloth <fx fy fz> [steps <first> <last>]
+ *
+ * Jitter offsets each spawned body by up to +-j per axis, drawn from the
+ * instance seed, so seeds give different but reproducible runs. Scene files
+ * (see physics::SceneFile) add their bodies and cloths unjittered, before
+ * the spawns; their world settings are ignored in favour of the scenario's.
+ */
+struct Scenario {
+    struct BodySpawn {
+        std::shared_ptr<physics::CollisionShape> shape;   // Shared by every instance
+        physics::RigidBody::BodyType type = physics::RigidBody::BodyType::Dynamic;
+        float mass = 1.0f;
+        glm::vec3 origin{0.0f};
+        glm::ivec3 grid{1};
+        glm::vec3 spacing{0.0f};
+        float jitter = 0.0f;
+    };
+
+    struct ClothSpawn {
+        int width = 10;
+        int height = 10;
+        float spacing = 0.1f;
+        glm::vec3 origin{0.0f};
+    };
+
+    struct Force {
+        enum class Target { Bodies, Cloth };
+        Target target = Target::Bodies;
+        glm::vec3 force{0.0f};
+        uint32_t firstStep = 0;
+        uint32_t lastStep = UINT32_MAX;
+
+        bool activeAt(uint32_t step) const { return step >= firstStep && step <= lastStep; }
+    };
+
+    float timeStep = 1.0f / 60.0f;
+    uint32_t steps = 600;
+    glm::vec3 gravity{0.0f, -9.81f, 0.0f};
+    int clothIterations = 5;
+
+    std::vector<BodySpawn> bodies;
+    std::vector<ClothSpawn> cloths;
+    std::vector<Force> forces;
+    std::vector<std::string> sceneFiles;
+
+    // Returns false and logs the offending line on a parse error
+    bool load(const std::string& path);
+    bool parse(std::istream& input, const std::string& sourceName);
+
+    size_t getBodyCount() const;
+};
+
+/**
+ * @brief Aggregate state after one step, written by the runner as a record
+ */
+struct StepMetrics {
+    uint32_t seed = 0;
+    uint32_t step = 0;
+    uint32_t bodies = 0;
+    uint32_t awakeBodies = 0;
+    uint32_t contacts = 0;
+    float kineticEnergy = 0.0f;
+    float maxSpeed = 0.0f;
+    float clothLowestY = 0.0f;
+    float stepMs = 0.0f;
+};
+
+/**
+ * @brief One independent run of a scenario
+ * Owns its rigid body world and cloth system; instances share nothing
+ * mutable, so any number can be stepped on different threads.
+ */
+class ScenarioInstance {
+public:
+    ScenarioInstance(const Scenario& scenario, uint32_t seed);
+
+    ScenarioInstance(const ScenarioInstance&) = delete;
+    ScenarioInstance& operator=(const ScenarioInstance&) = delete;
+
+    // Applies this step's forces and advances both systems by one fixed step
+    void step();
+    bool isFinished() const { return currentStep >= scenario.steps; }
+    
+    // False when a scene file failed to load; the world then lacks its bodies
+    bool isValid() const { return valid; }
+
+    StepMetrics measure() const;
+
+    uint32_t getSeed() const { return seed; }
+    uint32_t getCurrentStep() const { return currentStep; }
+    physics::PhysicsWorld& getWorld() { return world; }
+    const physics::PhysicsWorld& getWorld() const { return world; }
+    const physics::VertletSystem3D& getClothSystem() const { return clothSystem; }
+
+private:
+    const Scenario& scenario;
+    uint32_t seed;
+    uint32_t currentStep = 0;
+    float lastStepMs = 0.0f;
+    bool valid = true;
+
+    physics::PhysicsWorld world;
+    physics::VertletSystem3D clothSystem;
+    std::vector<std::unique_ptr<physics::ClothSolver3D>> cloths;
+};
+
+} // namespace engine::sim
@@ -0,0 +1,296 @@
+// lagSim.cpp - headless scenario runner (lag_sim)
+#include "engine/sim/Scenario.hpp"
+#include "engine/sim/Replay.hpp"
+#include "engine/core/ThreadPool.hpp"
+#include "engine/core/Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace engine;
+using namespace engine::core::log;
+
+namespace {
+
+struct Options {
+    std::string scenarioPath;
+    uint32_t seeds = 1;
+    uint32_t firstSeed = 0;
+    size_t threads = 0;
+    uint32_t steps = 0;            // 0 keeps the scenario's own count
+    uint32_t metricsEvery = 1;
+    std::string metricsPath;
+    std::string finalPath;
+    std::string replayPath;
+    uint32_t repeat = 1;
+};
+
+// Final body state record for binary output
+struct BodyRecord {
+    uint32_t seed;
+    uint32_t body;
+    float position[3];
+    float orientation[4];          // w, x, y, z
+    float velocity[3];
+};
+
+// Binary files start with this header, followed by raw records
+struct FileHeader {
+    char magic[4];                 // "LAGM" metrics, "LAGB" bodies
+    uint32_t version;
+    uint32_t recordSize;
+};
+
+void printUsage() {
+    std::printf(
+        "usage: lag_sim <scenario> [options]\n"
+        "       lag_sim --replay <capture.lrpl> [--repeat N]\n"
+        "  --seeds N        run N seeds in parallel (default 1)\n"
+        "  --first-seed S   first seed value (default 0)\n"
+        "  --threads T      worker threads, 0 = all cores (default 0)\n"
+        "  --steps S        override the scenario step count\n"
+        "  --metrics FILE   per-step metrics; .bin for binary, otherwise CSV\n"
+        "  --every K        record metrics every K steps (default 1)\n"
+        "  --final FILE     final body states; .bin for binary, otherwise CSV\n"
+        "  --replay FILE    re-run a recorded capture instead of a scenario\n"
+        "  --repeat N       replay the capture N times (default 1)\n");
+}
+
+// Whole non-negative decimal that fits in 32 bits; throws std::logic_error otherwise
+uint32_t parseCount(const std::string& text) {
+    size_t used = 0;
+    if (text.empty() || text[0] == '-') throw std::invalid_argument(text);
+    const unsigned long value = std::stoul(text, &used);
+    if (used != text.size()) throw std::invalid_argument(text);
+    if (value > UINT32_MAX) throw std::out_of_range(text);
+    return static_cast<uint32_t>(value);
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--seeds" && hasValue) options.seeds = parseCount(argv[++i]);
+            else if (arg == "--first-seed" && hasValue) options.firstSeed = parseCount(argv[++i]);
+            else if (arg == "--threads" && hasValue) options.threads = parseCount(argv[++i]);
+            else if (arg == "--steps" && hasValue) options.steps = parseCount(argv[++i]);
+            else if (arg == "--every" && hasValue) options.metricsEvery = std::max<uint32_t>(1, parseCount(argv[++i]));
+            else if (arg == "--metrics" && hasValue) options.metricsPath = argv[++i];
+            else if (arg == "--final" && hasValue) options.finalPath = argv[++i];
+            else if (arg == "--replay" && hasValue) options.replayPath = argv[++i];
+            else if (arg == "--repeat" && hasValue) options.repeat = std::max<uint32_t>(1, parseCount(argv[++i]));
+            else if (arg[0] != '-' && options.scenarioPath.empty()) options.scenarioPath = arg;
+            else return false;
+        }
+    } catch (const std::logic_error&) {
+        std::fprintf(stderr, "lag_sim: bad number in arguments\n");
+        return false;
+    }
+    if (!options.replayPath.empty()) return options.scenarioPath.empty();
+    return !options.scenarioPath.empty() && options.seeds > 0;
+}
+
+bool isBinaryPath(const std::string& path) {
+    return path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+}
+
+/**
+ * @brief Output file in CSV or raw binary records
+ */
+class RecordWriter {
+public:
+    bool open(const std::string& path, const char magic[4], uint32_t recordSize, const char* csvHeader) {
+        binary = isBinaryPath(path);
+        file = std::fopen(path.c_str(), binary ? "wb" : "w");
+        if (!file) {
+            Logger::log("Cannot write " + path, LogLevel::Error);
+            return false;
+        }
+        if (binary) {
+            FileHeader header{};
+            std::memcpy(header.magic, magic, 4);
+            header.version = 1;
+            header.recordSize = recordSize;
+            std::fwrite(&header, sizeof(header), 1, file);
+        } else {
+            std::fputs(csvHeader, file);
+        }
+        return true;
+    }
+
+    ~RecordWriter() {
+        if (file) std::fclose(file);
+    }
+
+    bool isOpen() const { return file != nullptr; }
+    bool isBinary() const { return binary; }
+    FILE* get() const { return file; }
+
+private:
+    FILE* file = nullptr;
+    bool binary = false;
+};
+
+void writeMetrics(RecordWriter& out, const std::vector<sim::StepMetrics>& rows) {
+    if (out.isBinary()) {
+        std::fwrite(rows.data(), sizeof(sim::StepMetrics), rows.size(), out.get());
+        return;
+    }
+    for (const sim::StepMetrics& m : rows) {
+        std::fprintf(out.get(), "%u,%u,%u,%u,%u,%.6g,%.6g,%.6g,%.4f\n", m.seed, m.step, m.bodies,
+                     m.awakeBodies, m.contacts, m.kineticEnergy, m.maxSpeed, m.clothLowestY, m.stepMs);
+    }
+}
+
+void writeFinalStates(RecordWriter& out, const sim::ScenarioInstance& instance) {
+    const auto& bodies = instance.getWorld().getRigidBodies();
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        const glm::vec3& p = bodies[i]->getPosition();
+        const glm::quat& q = bodies[i]->getOrientation();
+        const glm::vec3& v = bodies[i]->getLinearVelocity();
+
+        if (out.isBinary()) {
+            const BodyRecord record{instance.getSeed(), static_cast<uint32_t>(i),
+                                    {p.x, p.y, p.z}, {q.w, q.x, q.y, q.z}, {v.x, v.y, v.z}};
+            std::fwrite(&record, sizeof(record), 1, out.get());
+        } else {
+            std::fprintf(out.get(), "%u,%zu,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g\n",
+                         instance.getSeed(), i, p.x, p.y, p.z, q.w, q.x, q.y, q.z, v.x, v.y, v.z);
+        }
+    }
+}
+
+// Single-threaded on purpose: a replay is a fixed workload to profile
+int runReplay(const Options& options) {
+    sim::ReplayPlayer player;
+    if (!player.open(options.replayPath)) {
+        return 1;
+    }
+
+    double totalMs = 0.0;
+    double worstMs = 0.0;
+    uint32_t worstFrame = 0;
+    for (uint32_t run = 0; run < options.repeat; ++run) {
+        if (run > 0 && !player.restart()) {
+            return 1;
+        }
+        for (;;) {
+            const auto start = std::chrono::steady_clock::now();
+            if (!player.stepFrame()) break;
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            totalMs += ms;
+            if (ms > worstMs) {
+                worstMs = ms;
+                worstFrame = player.getFrame() - 1;
+            }
+        }
+    }
+
+    const double frames = double(player.getFrameCount()) * options.repeat;
+    std::printf("%u frames x %u runs, %zu bodies at end: %.3f s, %.3f ms/frame avg, worst %.3f ms (frame %u)\n",
+                player.getFrameCount(), options.repeat, player.getWorld().getRigidBodies().size(),
+                totalMs / 1000.0, frames > 0 ? totalMs / frames : 0.0, worstMs, worstFrame);
+
+    if (!player.hasStateHashes()) {
+        std::printf("state hashes: not checked\n");
+    } else if (player.hasDiverged()) {
+        std::printf("state hashes: DIVERGED at frame %u\n", player.getFirstDivergentFrame());
+        return 2;
+    } else {
+        std::printf("state hashes: match\n");
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    if (!options.replayPath.empty()) {
+        return runReplay(options);
+    }
+
+    sim::Scenario scenario;
+    if (!scenario.load(options.scenarioPath)) {
+        return 1;
+    }
+    if (options.steps > 0) {
+        scenario.steps = options.steps;
+    }
+
+    RecordWriter metricsOut, finalOut;
+    if (!options.metricsPath.empty() &&
+        !metricsOut.open(options.metricsPath, "LAGM", sizeof(sim::StepMetrics),
+                         "seed,step,bodies,awake,contacts,kinetic_energy,max_speed,cloth_lowest_y,step_ms\n")) {
+        return 1;
+    }
+    if (!options.finalPath.empty() &&
+        !finalOut.open(options.finalPath, "LAGB", sizeof(BodyRecord),
+                       "seed,body,px,py,pz,qw,qx,qy,qz,vx,vy,vz\n")) {
+        return 1;
+    }
+
+    core::threading::ThreadPool pool(options.threads);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::unique_ptr<sim::ScenarioInstance>> instances(options.seeds);
+    pool.parallelFor(options.seeds, [&](size_t i) {
+        instances[i] = std::make_unique<sim::ScenarioInstance>(scenario, options.firstSeed + static_cast<uint32_t>(i));
+    });
+    for (const auto& instance : instances) {
+        if (!instance->isValid()) {
+            return 1;
+        }
+    }
+
+    // Seeds advance in chunks of steps; rows are flushed after each chunk
+    // (grouped by seed within it) so output streams in bounded memory
+    constexpr uint32_t ChunkSteps = 64;
+    std::vector<std::vector<sim::StepMetrics>> rows(options.seeds);
+
+    for (uint32_t chunkStart = 0; chunkStart < scenario.steps; chunkStart += ChunkSteps) {
+        const uint32_t chunkEnd = std::min(scenario.steps, chunkStart + ChunkSteps);
+
+        pool.parallelFor(options.seeds, [&](size_t i) {
+            sim::ScenarioInstance& instance = *instances[i];
+            rows[i].clear();
+            while (instance.getCurrentStep() < chunkEnd) {
+                instance.step();
+                if (metricsOut.isOpen() && instance.getCurrentStep() % options.metricsEvery == 0) {
+                    rows[i].push_back(instance.measure());
+                }
+            }
+        });
+
+        if (metricsOut.isOpen()) {
+            for (const auto& seedRows : rows) {
+                writeMetrics(metricsOut, seedRows);
+            }
+        }
+    }
+
+    if (finalOut.isOpen()) {
+        for (const auto& instance : instances) {
+            writeFinalStates(finalOut, *instance);
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double totalSteps = double(scenario.steps) * options.seeds;
+    std::printf("%u seeds x %u steps, %zu bodies each, %zu threads: %.3f s (%.0f steps/s)\n",
+                options.seeds, scenario.steps, scenario.getBodyCount(), pool.getThreadCount(), seconds,
+                totalSteps / seconds);
+    return 0;
+}
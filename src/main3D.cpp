@@ -110,6 +110,9 @@ int main() {
         phys->addBall(b2);
     }
 
+    // ——— Physics runs on its own thread from here on; the world is fully populated ————
+    sceneManager->getCurrentScene()->setAsyncPhysics(true);
+
     // ——— Main loop ——————————————————————————————————————————————————————————————
     while (!glfwWindowShouldClose(window)) {
         // timing
@@ -0,0 +1,109 @@
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "engine/physics/BatchIntegrator.hpp"
+#include "engine/physics/RigidBody.hpp"
+#include "engine/physics/BoxShape.hpp"
+#include "engine/core/Logger.hpp"
+
+using namespace engine::physics;
+using namespace engine::core::log;
+
+namespace {
+
+// Same body state, byte for byte
+bool sameBits(const RigidBody& a, const RigidBody& b) {
+    return std::memcmp(&a.getPosition(), &b.getPosition(), sizeof(glm::vec3)) == 0 &&
+           std::memcmp(&a.getLinearVelocity(), &b.getLinearVelocity(), sizeof(glm::vec3)) == 0 &&
+           std::memcmp(&a.getAngularVelocity(), &b.getAngularVelocity(), sizeof(glm::vec3)) == 0 &&
+           std::memcmp(&a.getOrientation(), &b.getOrientation(), sizeof(glm::quat)) == 0 &&
+           std::memcmp(&a.getWorldInverseInertiaTensor(), &b.getWorldInverseInertiaTensor(), sizeof(glm::mat3)) == 0;
+}
+
+} // namespace
+
+int main() {
+    Logger::log("Starting batch integrator test", LogLevel::Info);
+
+    // Two identical sets of bodies: one stepped four at a time through the
+    // batch integrator, the other one by one through RigidBody::integrate
+    const size_t bodyCount = 256;
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+    std::vector<std::unique_ptr<RigidBody>> batched, scalar;
+    for (size_t i = 0; i < bodyCount; ++i) {
+        auto shape = std::make_shared<BoxShape>(glm::vec3(size(random), size(random), size(random)));
+        const float mass = size(random) * 5.0f;
+        const glm::vec3 position(unit(random) * 10.0f, unit(random) * 10.0f, unit(random) * 10.0f);
+        const glm::quat orientation = glm::normalize(glm::quat(unit(random), unit(random), unit(random), unit(random)));
+        const glm::vec3 velocity(unit(random) * 5.0f, unit(random) * 5.0f, unit(random) * 5.0f);
+
+        // Spins from zero up, across the |w| > 0.0001 threshold
+        glm::vec3 spin(unit(random), unit(random), unit(random));
+        switch (i % 4) {
+            case 0: spin = glm::vec3(0.0f); break;
+            case 1: spin *= 0.0001f; break;
+            case 2: spin *= 0.001f; break;
+            default: spin *= 10.0f; break;
+        }
+
+        for (auto* set : {&batched, &scalar}) {
+            auto body = std::make_unique<RigidBody>(RigidBody::BodyType::Dynamic, mass);
+            body->setCollisionShape(shape);
+            body->setPosition(position);
+            body->setOrientation(orientation);
+            body->setLinearVelocity(velocity);
+            body->setAngularVelocity(spin);
+            body->setLinearDamping(0.05f);
+            body->setAngularDamping(0.1f);
+            set->push_back(std::move(body));
+        }
+    }
+
+    BatchIntegrator integrator;
+    std::vector<RigidBody*> batch;
+    for (const auto& body : batched) {
+        batch.push_back(body.get());
+    }
+
+    const float timeStep = 1.0f / 60.0f;
+    const int steps = 120;
+    for (int step = 0; step < steps; ++step) {
+        // Forces and torques off the contact-free path too
+        std::mt19937 forces(step);
+        for (size_t i = 0; i < bodyCount; ++i) {
+            const glm::vec3 force(unit(forces) * 20.0f, unit(forces) * 20.0f - 9.81f, unit(forces) * 20.0f);
+            const glm::vec3 torque(unit(forces), unit(forces), unit(forces));
+            for (RigidBody* body : {batched[i].get(), scalar[i].get()}) {
+                body->applyForce(force);
+                body->applyTorque(torque * (i % 3 == 0 ? 0.0f : 1.0f));
+            }
+        }
+
+        integrator.integrate(batch, timeStep);
+        for (const auto& body : scalar) {
+            body->integrate(timeStep);
+        }
+
+        for (size_t i = 0; i < bodyCount; ++i) {
+            if (!sameBits(*batched[i], *scalar[i])) {
+                Logger::log("FAILED: body " + std::to_string(i) + " differs between the batch and scalar paths after step " +
+                            std::to_string(step), LogLevel::Error);
+                return 1;
+            }
+        }
+    }
+
+    if (integrator.getLastBatchCount() == 0) {
+        Logger::log("SKIPPED: no SIMD lanes on this build, only the scalar path ran", LogLevel::Warning);
+        return 0;
+    }
+
+    Logger::log("PASSED: batch and scalar integration agree bit for bit over " + std::to_string(steps) + " steps",
+                LogLevel::Info);
+    return 0;
+}
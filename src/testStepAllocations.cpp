@@ -0,0 +1,134 @@
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "engine/physics/PhysicsWorld.hpp"
+#include "engine/physics/RigidBody.hpp"
+#include "engine/physics/SphereShape.hpp"
+#include "engine/physics/BoxShape.hpp"
+#include "engine/physics/shapes/HeightfieldShape.hpp"
+#include "engine/core/Logger.hpp"
+
+using namespace engine::physics;
+using namespace engine::core::log;
+
+// Every heap allocation in the program goes through here; only those made
+// while counting is set are counted
+namespace {
+std::atomic<bool> counting{false};
+std::atomic<size_t> allocationCount{0};
+}
+
+void* operator new(size_t size) {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+int main() {
+    Logger::log("Starting step allocation test", LogLevel::Info);
+
+    PhysicsWorld world;
+    world.setGravity(glm::vec3(0.0f, -9.81f, 0.0f));
+
+    // Ground (static box)
+    BodyHandle ground = world.createRigidBody(RigidBody::BodyType::Static, 0.0f);
+    world.getRigidBody(ground)->setPosition(glm::vec3(0.0f, -0.5f, 0.0f));
+    world.getRigidBody(ground)->setCollisionShape(std::make_shared<BoxShape>(glm::vec3(50.0f, 0.5f, 50.0f)));
+
+    // A 10x10 layer of touching spheres, laid across broad phase cell
+    // boundaries so resting bodies keep crossing them
+    auto sphereShape = std::make_shared<SphereShape>(0.5f);
+    for (int i = 0; i < 100; ++i) {
+        BodyHandle handle = world.createRigidBody(RigidBody::BodyType::Dynamic, 1.0f);
+        RigidBody* sphere = world.getRigidBody(handle);
+        sphere->setCollisionShape(sphereShape);
+        sphere->setPosition(glm::vec3((i % 10) - 5.0f, 0.5f, (i / 10) - 5.0f));
+    }
+
+    // Dynamic boxes resting on a terrain pad just above the ground (box vs box
+    // ground contact is not supported)
+    BodyHandle pad = world.createRigidBody(RigidBody::BodyType::Static, 0.0f);
+    world.getRigidBody(pad)->setPosition(glm::vec3(25.0f, 0.01f, -5.0f));
+    world.getRigidBody(pad)->setCollisionShape(
+        std::make_shared<HeightfieldShape>(6, 6, std::vector<float>(36, 0.0f), 2.0f));
+    auto boxShape = std::make_shared<BoxShape>(glm::vec3(0.6f, 0.6f, 0.6f));
+    for (int i = 0; i < 4; ++i) {
+        BodyHandle handle = world.createRigidBody(RigidBody::BodyType::Dynamic, 1.0f);
+        RigidBody* box = world.getRigidBody(handle);
+        box->setCollisionShape(boxShape);
+        box->setPosition(glm::vec3(23.0f + (i % 2) * 4.0f, 0.7f, -7.0f + (i / 2) * 4.0f));
+    }
+
+    // Kinematic boxes circling above the layer, in cells nothing else uses,
+    // turning as they go so their AABBs come from a rotated box. They keep
+    // entering cells they left long enough ago for cleanup to recycle them.
+    const int orbiterCount = 4;
+    const float orbitSpeed = 1.5f;        // Radians per second
+    std::vector<BodyHandle> orbiters;
+    for (int i = 0; i < orbiterCount; ++i) {
+        orbiters.push_back(world.createRigidBody(RigidBody::BodyType::Kinematic, 0.0f));
+        world.getRigidBody(orbiters.back())->setCollisionShape(boxShape);
+    }
+
+    const float timeStep = 1.0f / 60.0f;
+    const int settleSteps = 300;
+    const int measuredSteps = 600;       // Spans several broad phase cleanups
+    int step = 0;
+
+    auto advance = [&]() {
+        for (int i = 0; i < orbiterCount; ++i) {
+            float angle = orbitSpeed * timeStep * static_cast<float>(step) + 6.2831853f * i / orbiterCount;
+            float radius = 8.0f + 2.0f * i;
+            RigidBody* orbiter = world.getRigidBody(orbiters[i]);
+            orbiter->setPosition(glm::vec3(radius * std::cos(angle), 7.5f, radius * std::sin(angle)));
+            orbiter->setOrientation(glm::angleAxis(-angle, glm::vec3(0.0f, 1.0f, 0.0f)));
+        }
+        world.update(timeStep);
+        ++step;
+    };
+
+    // Let the scene reach its working set; every buffer reaches its working
+    // size here, and the orbits run long enough for cells to be recycled
+    for (int i = 0; i < settleSteps; ++i) {
+        advance();
+    }
+
+    // Cleanup hands cells back in batches, so keep some spare for the orbits
+    // to draw on in between
+    if (auto* grid = dynamic_cast<SpatialHashBroadPhase*>(world.getBroadPhase())) {
+        grid->reserveCells(64);
+    }
+
+    counting = true;
+    for (int i = 0; i < measuredSteps; ++i) {
+        advance();
+    }
+    counting = false;
+
+    const size_t allocations = allocationCount.load();
+    if (allocations != 0) {
+        Logger::log("FAILED: " + std::to_string(allocations) + " heap allocations in " +
+                    std::to_string(measuredSteps) + " steps of a moving scene", LogLevel::Error);
+        return 1;
+    }
+
+    Logger::log("PASSED: no heap allocations in " + std::to_string(measuredSteps) + " steps", LogLevel::Info);
+    return 0;
+}